@@ -0,0 +1,399 @@
+#include <amber.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ */
+struct BenchOptions
+{
+	const char *filter = nullptr;
+	uint32_t joint_count = 0;
+	uint32_t warmup = 5;
+	uint32_t repetitions = 50;
+	double target_repetition_ns = 2000000.0;
+};
+
+struct BenchSequenceDesc
+{
+	const char *name;
+	float duration;
+	float rate;
+};
+
+// Note: 'rate' of zero means sparse curves with a handful of keys over the whole clip
+static const BenchSequenceDesc sequence_descs[] =
+{
+	{"sparse", 2.0f, 0.0f},
+	{"30hz", 2.0f, 30.0f},
+	{"60hz", 2.0f, 60.0f},
+	{"120hz", 2.0f, 120.0f},
+	{"long", 20.0f, 30.0f},
+};
+
+static const uint32_t joint_counts[] = {23, 100, 500, 2000};
+
+static const uint32_t sparse_key_count = 4;
+static const uint32_t blend_pose_count = 4;
+static const uint32_t additive_pose_count = 2;
+static const uint32_t batch_pose_count = 64;
+
+/*
+ */
+static uint64_t getNanoseconds()
+{
+	using namespace std::chrono;
+	return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static double getPercentile(const std::vector<double> &sorted, double percentile)
+{
+	assert(!sorted.empty());
+
+	size_t index = (size_t)(percentile * (double)(sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// Note: every repetition runs the case enough times to last roughly 'target_repetition_ns',
+//       percentiles are taken over per-repetition averages
+static void runCase(const BenchOptions &options, const std::string &name, uint32_t joint_count, const std::function<void()> &function)
+{
+	if (options.filter && name.find(options.filter) == std::string::npos)
+		return;
+
+	for (uint32_t i = 0; i < options.warmup; ++i)
+		function();
+
+	uint64_t calibration_start = getNanoseconds();
+	function();
+	uint64_t calibration_ns = std::max<uint64_t>(getNanoseconds() - calibration_start, 1);
+
+	uint32_t iterations = (uint32_t)std::max(1.0, options.target_repetition_ns / (double)calibration_ns);
+
+	std::vector<double> samples;
+	samples.reserve(options.repetitions);
+
+	for (uint32_t i = 0; i < options.repetitions; ++i)
+	{
+		uint64_t start = getNanoseconds();
+
+		for (uint32_t j = 0; j < iterations; ++j)
+			function();
+
+		uint64_t elapsed = getNanoseconds() - start;
+		samples.push_back((double)elapsed / (double)iterations);
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	double p50 = getPercentile(samples, 0.5);
+	double joints = (double)joint_count;
+
+	printf("%-32s %6u %8u %12.1f %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+		name.c_str(), joint_count, iterations, p50,
+		samples.front() / joints, p50 / joints, getPercentile(samples, 0.9) / joints, getPercentile(samples, 0.99) / joints, samples.back() / joints
+	);
+}
+
+/*
+ */
+static Amber_Armature createArmature(Amber_Instance instance, uint32_t joint_count)
+{
+	// Note: every joint hangs off one of the few previous joints, which gives
+	//       a bushy hierarchy with short chains similar to real skeletons
+	std::vector<int32_t> parents(joint_count);
+	uint32_t seed = 0x12345678u;
+
+	parents[0] = -1;
+	for (uint32_t i = 1; i < joint_count; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		uint32_t back = 1 + (seed >> 16) % std::min<uint32_t>(i, 4);
+		parents[i] = (int32_t)(i - back);
+	}
+
+	Amber_ArmatureDesc desc = {joint_count, parents.data(), NULL, 0};
+	Amber_Armature armature = AMBER_NULL_HANDLE;
+
+	Amber_Result result = amberCreateArmature(instance, &desc, &armature);
+	assert(result == AMBER_SUCCESS);
+
+	return armature;
+}
+
+static void fillRestPose(Amber_Instance instance, Amber_Pose pose, uint32_t joint_count, float offset)
+{
+	Amber_Transform *transforms = NULL;
+
+	Amber_Result result = amberMapPose(instance, pose, &transforms);
+	assert(result == AMBER_SUCCESS);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		float angle = 0.1f * (float)(i % 7) + offset;
+
+		transforms[i].position = {0.0f, 0.1f, 0.01f * (float)(i % 3)};
+		transforms[i].rotation = {sinf(angle * 0.5f), 0.0f, 0.0f, cosf(angle * 0.5f)};
+		transforms[i].scale = {1.0f, 1.0f, 1.0f};
+	}
+
+	result = amberUnmapPose(instance, pose);
+	assert(result == AMBER_SUCCESS);
+}
+
+// Note: rotations are animated on every joint, positions only on the root and scales are constant,
+//       which matches typical exported clips. Joints share key arrays, the instance copies them anyway.
+static Amber_Sequence createSequence(Amber_Instance instance, Amber_Armature armature, uint32_t joint_count, const BenchSequenceDesc &desc)
+{
+	uint32_t key_count = (desc.rate > 0.0f) ? (uint32_t)(desc.duration * desc.rate) + 1 : sparse_key_count;
+
+	std::vector<Amber_SequenceKey> animated_keys[4];
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		animated_keys[c].resize(key_count);
+
+		for (uint32_t k = 0; k < key_count; ++k)
+		{
+			float time = desc.duration * (float)k / (float)(key_count - 1);
+			float value = (c == 3) ? 1.0f : 0.25f * sinf(time * (float)(c + 1));
+
+			animated_keys[c][k] = {time, value, {0.0f, 0.0f}, {0.0f, 0.0f}};
+		}
+	}
+
+	static const Amber_SequenceKey zero_key = {0.0f, 0.0f, {0.0f, 0.0f}, {0.0f, 0.0f}};
+	static const Amber_SequenceKey one_key = {0.0f, 1.0f, {0.0f, 0.0f}, {0.0f, 0.0f}};
+
+	std::vector<Amber_SequenceJointCurve> curves(joint_count);
+	std::vector<uint32_t> indices(joint_count);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		Amber_SequenceJointCurve &curve = curves[i];
+		indices[i] = i;
+
+		for (uint32_t c = 0; c < 3; ++c)
+		{
+			curve.position_curves[c] = (i == 0) ? Amber_SequenceCurve{key_count, animated_keys[c].data()} : Amber_SequenceCurve{1, &zero_key};
+			curve.scale_curves[c] = {1, &one_key};
+		}
+
+		for (uint32_t c = 0; c < 4; ++c)
+			curve.rotation_curves[c] = {key_count, animated_keys[c].data()};
+	}
+
+	Amber_SequenceDesc sequence_desc = {armature, joint_count, indices.data(), curves.data(), NULL};
+	Amber_Sequence sequence = AMBER_NULL_HANDLE;
+
+	Amber_Result result = amberCreateSequence(instance, &sequence_desc, &sequence);
+	assert(result == AMBER_SUCCESS);
+
+	return sequence;
+}
+
+/*
+ */
+static void benchArmature(Amber_Instance instance, const BenchOptions &options, uint32_t joint_count)
+{
+	Amber_Armature armature = createArmature(instance, joint_count);
+	Amber_PoseDesc pose_desc = {armature, 0, NULL};
+
+	std::vector<Amber_Pose> poses(blend_pose_count);
+	std::vector<float> weights(blend_pose_count, 1.0f / (float)blend_pose_count);
+
+	for (uint32_t i = 0; i < blend_pose_count; ++i)
+	{
+		Amber_Result result = amberCreatePose(instance, &pose_desc, &poses[i]);
+		assert(result == AMBER_SUCCESS);
+
+		fillRestPose(instance, poses[i], joint_count, 0.1f * (float)i);
+	}
+
+	Amber_Pose dst_pose = AMBER_NULL_HANDLE;
+	Amber_Result result = amberCreatePose(instance, &pose_desc, &dst_pose);
+	assert(result == AMBER_SUCCESS);
+
+	fillRestPose(instance, dst_pose, joint_count, 0.0f);
+
+	std::string suffix = "/" + std::to_string(joint_count);
+
+	// sampling
+	for (const BenchSequenceDesc &desc : sequence_descs)
+	{
+		std::string name = std::string("sample/") + desc.name + suffix;
+
+		if (options.filter && name.find(options.filter) == std::string::npos)
+			continue;
+
+		Amber_Sequence sequence = createSequence(instance, armature, joint_count, desc);
+
+		// Note: the sample time walks through the clip so every key segment gets hit
+		float time = 0.0f;
+		float step = desc.duration * 0.0137f;
+
+		runCase(options, name, joint_count, [&]()
+		{
+			amberSamplePose(instance, sequence, time, dst_pose);
+
+			time += step;
+			if (time > desc.duration)
+				time -= desc.duration;
+		});
+
+		result = amberDestroySequence(instance, sequence);
+		assert(result == AMBER_SUCCESS);
+	}
+
+	// loading
+	std::string load_name = "load/memory" + suffix;
+
+	if (!options.filter || load_name.find(options.filter) != std::string::npos)
+	{
+		Amber_Sequence sequence = createSequence(instance, armature, joint_count, sequence_descs[1]);
+
+		uint64_t blob_size = 0;
+		result = amberSerializeSequence(instance, sequence, &blob_size, NULL);
+		assert(result == AMBER_SUCCESS);
+
+		// Note: std::vector storage is at least 16 byte aligned, which is what blobs require
+		std::vector<uint8_t> blob(blob_size);
+		result = amberSerializeSequence(instance, sequence, &blob_size, blob.data());
+		assert(result == AMBER_SUCCESS);
+
+		Amber_SequenceMemoryDesc memory_desc = {armature, blob_size, blob.data()};
+
+		runCase(options, load_name, joint_count, [&]()
+		{
+			Amber_Sequence loaded_sequence = AMBER_NULL_HANDLE;
+			amberCreateSequenceFromMemory(instance, &memory_desc, &loaded_sequence);
+			amberDestroySequence(instance, loaded_sequence);
+		});
+
+		result = amberDestroySequence(instance, sequence);
+		assert(result == AMBER_SUCCESS);
+	}
+
+	// blending
+	runCase(options, "blend/" + std::to_string(blend_pose_count) + suffix, joint_count, [&]()
+	{
+		amberBlendPoses(instance, blend_pose_count, poses.data(), weights.data(), dst_pose);
+	});
+
+	runCase(options, "apply_additive/" + std::to_string(additive_pose_count) + suffix, joint_count, [&]()
+	{
+		amberApplyAdditivePoses(instance, poses[0], additive_pose_count, poses.data() + 1, weights.data(), dst_pose);
+	});
+
+	// hierarchy
+	runCase(options, "convert_to_world" + suffix, joint_count, [&]()
+	{
+		amberConvertToWorldPose(instance, poses[0], dst_pose);
+	});
+
+	runCase(options, "convert_to_local" + suffix, joint_count, [&]()
+	{
+		amberConvertToLocalPose(instance, poses[0], dst_pose);
+	});
+
+	// pools
+	runCase(options, "pool/pose" + suffix, joint_count, [&]()
+	{
+		Amber_Pose pose = AMBER_NULL_HANDLE;
+		amberCreatePose(instance, &pose_desc, &pose);
+		amberDestroyPose(instance, pose);
+	});
+
+	std::vector<Amber_PoseDesc> batch_descs(batch_pose_count, pose_desc);
+	std::vector<Amber_Pose> batch_poses(batch_pose_count);
+
+	runCase(options, "pool/poses_" + std::to_string(batch_pose_count) + suffix, joint_count * batch_pose_count, [&]()
+	{
+		amberCreatePoses(instance, batch_pose_count, batch_descs.data(), batch_poses.data());
+		amberDestroyPoses(instance, batch_pose_count, batch_poses.data());
+	});
+
+	amberDestroyPose(instance, dst_pose);
+	amberDestroyPoses(instance, blend_pose_count, poses.data());
+	amberDestroyArmature(instance, armature);
+}
+
+/*
+ */
+static void printUsage()
+{
+	printf("usage: amber_bench [--filter <substring>] [--joints <count>] [--warmup <count>] [--repetitions <count>]\n");
+}
+
+static bool parseOptions(int argc, char **argv, BenchOptions &options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const char *arg = argv[i];
+		const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+		if (strcmp(arg, "--help") == 0 || value == NULL)
+			return false;
+
+		if (strcmp(arg, "--filter") == 0)
+			options.filter = value;
+		else if (strcmp(arg, "--joints") == 0)
+			options.joint_count = (uint32_t)strtoul(value, NULL, 10);
+		else if (strcmp(arg, "--warmup") == 0)
+			options.warmup = (uint32_t)strtoul(value, NULL, 10);
+		else if (strcmp(arg, "--repetitions") == 0)
+			options.repetitions = std::max<uint32_t>((uint32_t)strtoul(value, NULL, 10), 1);
+		else
+			return false;
+
+		++i;
+	}
+
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	BenchOptions options;
+
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage();
+		return 1;
+	}
+
+#if !defined(NDEBUG)
+	printf("warning: assertions are enabled, build with CMAKE_BUILD_TYPE=Release for meaningful numbers\n\n");
+#endif
+
+	// Note: single threaded on purpose, batch calls are not measured here
+	Amber_InstanceDesc instance_desc = {};
+	instance_desc.thread_count = 1;
+
+	Amber_Instance instance = AMBER_NULL_HANDLE;
+
+	Amber_Result result = amberCreateInstance(&instance_desc, &instance);
+	assert(result == AMBER_SUCCESS);
+
+	printf("%-32s %6s %8s %12s %9s %9s %9s %9s %9s\n", "case", "joints", "iters", "p50 ns/op", "min", "p50", "p90", "p99", "max");
+	printf("%-32s %6s %8s %12s %9s %9s %9s %9s %9s\n", "", "", "", "", "ns/joint", "ns/joint", "ns/joint", "ns/joint", "ns/joint");
+
+	for (uint32_t joint_count : joint_counts)
+	{
+		if (options.joint_count != 0 && options.joint_count != joint_count)
+			continue;
+
+		benchArmature(instance, options, joint_count);
+	}
+
+	result = amberDestroyInstance(instance);
+	assert(result == AMBER_SUCCESS);
+
+	return 0;
+}
@@ -38,12 +38,17 @@ extern "C" {
 #endif
 
 // Constants
+#define AMBER_GRAPH_PARAMETER_NONE 0xFFFFFFFF
 
 // Opaque handles
 AMBER_DEFINE_HANDLE(Amber_Instance);
 AMBER_DEFINE_HANDLE(Amber_Armature);
 AMBER_DEFINE_HANDLE(Amber_Sequence);
 AMBER_DEFINE_HANDLE(Amber_Pose);
+AMBER_DEFINE_HANDLE(Amber_Graph);
+AMBER_DEFINE_HANDLE(Amber_ResolvedPose);
+AMBER_DEFINE_HANDLE(Amber_ResolvedSequence);
+AMBER_DEFINE_HANDLE(Amber_Library);
 
 // Enums
 typedef enum Amber_Result_t
@@ -52,14 +57,104 @@ typedef enum Amber_Result_t
 	AMBER_NOT_IMPLEMENTED,
 	AMBER_INVALID_INSTANCE,
 	AMBER_INVALID_OUTPUT_ARGUMENT,
+	AMBER_INVALID_DATA,
 
 	// FIXME: add more error codes for internal errors
 	AMBER_INTERNAL_ERROR,
+	AMBER_INVALID_HANDLE,
 
 	AMBER_RESULT_ENUM_MAX,
 	AMBER_RESULT_ENUM_FORCE32 = 0x7FFFFFFF,
 } Amber_Result;
 
+typedef enum Amber_GraphNodeType_t
+{
+	AMBER_GRAPH_NODE_TYPE_CLIP = 0,
+	AMBER_GRAPH_NODE_TYPE_BLEND,
+	AMBER_GRAPH_NODE_TYPE_ADDITIVE,
+	AMBER_GRAPH_NODE_TYPE_MASK,
+
+	AMBER_GRAPH_NODE_TYPE_ENUM_MAX,
+	AMBER_GRAPH_NODE_TYPE_ENUM_FORCE32 = 0x7FFFFFFF,
+} Amber_GraphNodeType;
+
+typedef enum Amber_MemoryCategory_t
+{
+	AMBER_MEMORY_CATEGORY_INSTANCE = 0,
+	AMBER_MEMORY_CATEGORY_ARMATURE,
+	AMBER_MEMORY_CATEGORY_POSE,
+	AMBER_MEMORY_CATEGORY_SEQUENCE,
+	AMBER_MEMORY_CATEGORY_GRAPH,
+	AMBER_MEMORY_CATEGORY_POOL,
+	AMBER_MEMORY_CATEGORY_TRANSIENT,
+
+	AMBER_MEMORY_CATEGORY_ENUM_MAX,
+	AMBER_MEMORY_CATEGORY_ENUM_FORCE32 = 0x7FFFFFFF,
+} Amber_MemoryCategory;
+
+// Note: one value per Amber_InstanceTable entry, in table order
+typedef enum Amber_Function_t
+{
+	AMBER_FUNCTION_RESERVE_CAPACITY = 0,
+	AMBER_FUNCTION_CREATE_ARMATURE,
+	AMBER_FUNCTION_CREATE_POSE,
+	AMBER_FUNCTION_CREATE_POSES,
+	AMBER_FUNCTION_CREATE_TRANSIENT_POSE,
+	AMBER_FUNCTION_CREATE_SEQUENCE,
+	AMBER_FUNCTION_CREATE_SEQUENCES,
+	AMBER_FUNCTION_CREATE_SEQUENCE_FROM_MEMORY,
+	AMBER_FUNCTION_CREATE_SEQUENCES_ASYNC,
+	AMBER_FUNCTION_CREATE_STREAMING_SEQUENCE,
+	AMBER_FUNCTION_CREATE_CACHED_SEQUENCE,
+	AMBER_FUNCTION_LOAD_SNAPSHOT,
+	AMBER_FUNCTION_ATTACH_LIBRARY,
+	AMBER_FUNCTION_CREATE_GRAPH,
+	AMBER_FUNCTION_DESTROY_ARMATURE,
+	AMBER_FUNCTION_DESTROY_POSE,
+	AMBER_FUNCTION_DESTROY_POSES,
+	AMBER_FUNCTION_RESET_TRANSIENT_POSES,
+	AMBER_FUNCTION_DESTROY_SEQUENCE,
+	AMBER_FUNCTION_DESTROY_SEQUENCES,
+	AMBER_FUNCTION_DESTROY_GRAPH,
+	AMBER_FUNCTION_DESTROY_INSTANCE,
+	AMBER_FUNCTION_COPY_POSE,
+	AMBER_FUNCTION_MULTIPLY_POSE,
+	AMBER_FUNCTION_INVERT_POSE,
+	AMBER_FUNCTION_MAP_POSE,
+	AMBER_FUNCTION_UNMAP_POSE,
+	AMBER_FUNCTION_ENUMERATE_POSES,
+	AMBER_FUNCTION_GET_POSE_JOINT_COUNT,
+	AMBER_FUNCTION_GET_INSTANCE_STATS,
+	AMBER_FUNCTION_GET_SEQUENCE_STATS,
+	AMBER_FUNCTION_SERIALIZE_SEQUENCE,
+	AMBER_FUNCTION_SERIALIZE_STREAMING_SEQUENCE,
+	AMBER_FUNCTION_SERIALIZE_SNAPSHOT,
+	AMBER_FUNCTION_SAMPLE_ROOT_MOTION,
+	AMBER_FUNCTION_SAMPLE_POSE,
+	AMBER_FUNCTION_SAMPLE_POSE_BATCH,
+	AMBER_FUNCTION_BLEND_POSES,
+	AMBER_FUNCTION_BLEND_POSE_BATCH,
+	AMBER_FUNCTION_COMPUTE_ADDITIVE_POSE,
+	AMBER_FUNCTION_APPLY_ADDITIVE_POSES,
+	AMBER_FUNCTION_CONVERT_TO_WORLD_POSE,
+	AMBER_FUNCTION_CONVERT_TO_WORLD_POSE_BATCH,
+	AMBER_FUNCTION_CONVERT_TO_LOCAL_POSE,
+	AMBER_FUNCTION_CONVERT_TO_LOCAL_POSE_BATCH,
+	AMBER_FUNCTION_EVALUATE_GRAPH,
+	AMBER_FUNCTION_RESOLVE_POSE,
+	AMBER_FUNCTION_RESOLVE_SEQUENCE,
+	AMBER_FUNCTION_GET_UNCHECKED_TABLE,
+	AMBER_FUNCTION_BEGIN_CAPTURE,
+	AMBER_FUNCTION_END_CAPTURE,
+	AMBER_FUNCTION_GET_FENCE_STATUS,
+	AMBER_FUNCTION_WAIT_FENCE,
+	AMBER_FUNCTION_PREFETCH_STREAMING_SEQUENCE,
+	AMBER_FUNCTION_SET_SEQUENCE_CACHE_BUDGET,
+
+	AMBER_FUNCTION_ENUM_MAX,
+	AMBER_FUNCTION_ENUM_FORCE32 = 0x7FFFFFFF,
+} Amber_Function;
+
 // Structs
 typedef struct Amber_Vec2_t
 {
@@ -83,18 +178,120 @@ typedef struct Amber_Transform_t
 	Amber_Vec3 scale;
 } Amber_Transform;
 
+// Note: size and alignment are always provided, alignment is a power of two.
+//       'reallocate' is optional, if it's NULL the library falls back to allocate + copy + free.
+typedef void *(*PFN_amberAllocate)(void *user_data, uint64_t size, uint32_t alignment, Amber_MemoryCategory category);
+typedef void *(*PFN_amberReallocate)(void *user_data, void *memory, uint64_t old_size, uint64_t new_size, uint32_t alignment, Amber_MemoryCategory category);
+typedef void (*PFN_amberFree)(void *user_data, void *memory, uint64_t size, Amber_MemoryCategory category);
+
+typedef struct Amber_AllocationCallbacks_t
+{
+	void *user_data;
+	PFN_amberAllocate allocate;
+	PFN_amberReallocate reallocate;
+	PFN_amberFree free;
+} Amber_AllocationCallbacks;
+
+// Note: 'parallel_for' splits [0, count) into ranges of at least 'granularity' items and calls 'function'
+//       once per range, from any thread. It may return before all ranges are processed, 'wait' must block
+//       until every range of the returned job has been processed. The job handle is opaque to the library.
+typedef void (*PFN_amberJobFunction)(void *job_data, uint32_t begin, uint32_t end);
+typedef uint64_t (*PFN_amberParallelFor)(void *user_data, uint32_t count, uint32_t granularity, PFN_amberJobFunction function, void *job_data);
+typedef void (*PFN_amberWait)(void *user_data, uint64_t job);
+
+typedef struct Amber_JobCallbacks_t
+{
+	void *user_data;
+	PFN_amberParallelFor parallel_for;
+	PFN_amberWait wait;
+} Amber_JobCallbacks;
+
+// Note: zones are emitted around expensive calls (sequence creation, sampling, blending, conversion,
+//       pool growth) and always nest on the calling thread, 'name' is a string literal valid for the
+//       whole lifetime of the process. Batch calls and async loads emit zones from worker threads, so callbacks
+//       must be thread-safe. Zones are compiled out if the library is built without AMBER_PROFILE_ZONES.
+typedef void (*PFN_amberBeginZone)(void *user_data, const char *name);
+typedef void (*PFN_amberEndZone)(void *user_data, const char *name);
+
+typedef struct Amber_ProfilerCallbacks_t
+{
+	void *user_data;
+	PFN_amberBeginZone begin_zone;
+	PFN_amberEndZone end_zone;
+} Amber_ProfilerCallbacks;
+
+// Note: a capture records begin / end events of all profiler zones into a ring buffer of 'event_capacity'
+//       events (rounded up to a power of two, zero selects a default), the oldest events are overwritten
+//       once the buffer is full.
+typedef struct Amber_CaptureDesc_t
+{
+	uint32_t event_capacity;
+} Amber_CaptureDesc;
+
+struct Amber_InstanceTable_t;
+
+// Note: layers are chained at instance creation, the first entry of 'layers' is the outermost layer.
+//       'create' receives the next instance in the chain together with its table and returns a new instance
+//       object whose first member is a pointer to the layer's Amber_InstanceTable. Every table entry receives
+//       the layer object as its instance, so the layer must fill all entries and forward calls it does not
+//       intercept to 'next_instance' through 'next_table'. Its destroyInstance forwards and then releases the layer.
+//       Calls made by the library internally and unchecked functions never go through layers.
+typedef Amber_Result (*PFN_amberCreateLayer)(void *user_data, const Amber_AllocationCallbacks *allocation_callbacks, Amber_Instance next_instance, const struct Amber_InstanceTable_t *next_table, Amber_Instance *instance);
+
+typedef struct Amber_LayerDesc_t
+{
+	void *user_data;
+	PFN_amberCreateLayer create;
+} Amber_LayerDesc;
+
+typedef struct Amber_ProfilingCounter_t
+{
+	uint64_t call_count;
+	uint64_t joint_count;
+	uint64_t nanoseconds;
+} Amber_ProfilingCounter;
+
+// Note: filled by the profiling layer, counters are updated atomically and are never reset by the library.
+//       'joint_count' sums joints of all destination poses written by the call.
+typedef struct Amber_ProfilingCounters_t
+{
+	Amber_ProfilingCounter functions[AMBER_FUNCTION_ENUM_MAX];
+} Amber_ProfilingCounters;
+
+// Note: armatures and sequences are immutable once created and may be read from any number of threads.
+//       Creating and destroying objects may run concurrently with sampling and blending, as long as
+//       every pose is written by one thread at a time and objects in use are not destroyed.
+//       Graphs are immutable too and may be evaluated from any number of threads, amberResetTransientPoses
+//       and amberDestroyInstance require exclusive access. Allocation callbacks must be thread-safe.
+//       If 'job_callbacks' is NULL, batch functions run on a built-in work-stealing thread pool which is
+//       started on first use. 'thread_count' is the total number of threads working on a batch, including
+//       the calling thread, 0 picks the hardware thread count and 1 runs batches on the calling thread only.
+//       Cached sequences not sampled recently are evicted first once their total resident size would exceed
+//       'sequence_cache_budget' bytes, zero means no limit.
 typedef struct Amber_InstanceDesc_t
 {
-	uint32_t reserved;
-	// TODO: allocator context
+	const Amber_AllocationCallbacks *allocation_callbacks;
+	const Amber_JobCallbacks *job_callbacks;
+	const Amber_ProfilerCallbacks *profiler_callbacks;
+	uint32_t thread_count;
+	uint32_t layer_count;
+	const Amber_LayerDesc *layers;
+	uint64_t sequence_cache_budget;
 	// TOOD: flags?
 } Amber_InstanceDesc;
 
+// Note: if 'pose_slab_capacity' is not zero, transforms of all poses created with this armature are
+//       allocated from shared slabs of 'pose_slab_capacity' poses each with a fixed stride,
+//       otherwise every pose allocates its own transforms.
+//       Armatures are reference counted by their poses, destroying an armature with live poses
+//       only releases the handle, the armature itself is destroyed together with its last pose.
+//       Transient poses don't hold a reference, an armature must outlive the transient poses created from it.
 typedef struct Amber_ArmatureDesc_t
 {
 	uint32_t joint_count;
 	const int32_t *joint_parents;
 	const char **joint_names;
+	uint32_t pose_slab_capacity;
 } Amber_ArmatureDesc;
 
 typedef struct Amber_PoseDesc_t
@@ -134,14 +331,222 @@ typedef struct Amber_SequenceDesc_t
 	const Amber_SequenceJointCurve *root_motion_curve;
 } Amber_SequenceDesc;
 
+// Note: 'data' is a blob written by amberSerializeSequence, it must be 16 byte aligned and stay valid
+//       and unmodified until the sequence is destroyed. The blob is referenced in place, not copied.
+typedef struct Amber_SequenceMemoryDesc_t
+{
+	Amber_Armature armature;
+	uint64_t size;
+	const void *data;
+} Amber_SequenceMemoryDesc;
+
+// Note: 'read' fills 'size' bytes at 'offset' of the stream, it is called on the loader thread one call at a time
+//       once the sequence is created. 'close' is optional and called when the sequence is destroyed or fails to be created.
+typedef Amber_Result (*PFN_amberReadStream)(void *user_data, uint64_t offset, uint64_t size, void *data);
+typedef void (*PFN_amberCloseStream)(void *user_data);
+
+typedef struct Amber_StreamCallbacks_t
+{
+	void *user_data;
+	PFN_amberReadStream read;
+	PFN_amberCloseStream close;
+} Amber_StreamCallbacks;
+
+// Note: a stream written by amberSerializeStreamingSequence is read through 'callbacks', or from the file at 'path'
+//       if 'callbacks.read' is NULL. At most 'resident_chunk_count' chunks are kept in memory (zero selects a default),
+//       'prefetch_chunk_count' chunks past the one being sampled are requested ahead of time.
+typedef struct Amber_StreamingSequenceDesc_t
+{
+	Amber_Armature armature;
+	Amber_StreamCallbacks callbacks;
+	const char *path;
+	uint32_t resident_chunk_count;
+	uint32_t prefetch_chunk_count;
+} Amber_StreamingSequenceDesc;
+
+// Note: the source is a blob written by amberSerializeSequence, read at 'offset' through 'callbacks' or from the
+//       file at 'path' if 'callbacks.read' is NULL. The file is opened for every load, so no handle is kept open.
+//       The transforms of 'fallback_pose' are copied at creation, it may be AMBER_NULL_HANDLE.
+typedef struct Amber_CachedSequenceDesc_t
+{
+	Amber_Armature armature;
+	Amber_StreamCallbacks callbacks;
+	const char *path;
+	uint64_t offset;
+	Amber_Pose fallback_pose;
+} Amber_CachedSequenceDesc;
+
+typedef struct Amber_SnapshotDesc_t
+{
+	uint64_t size;
+	const void *data;
+} Amber_SnapshotDesc;
+
+// Note: 'data' is a snapshot written by amberSerializeSnapshot, it is copied into memory allocated through
+//       'allocation_callbacks', which must remain usable until the library memory is freed.
+typedef struct Amber_LibraryDesc_t
+{
+	const Amber_AllocationCallbacks *allocation_callbacks;
+	uint64_t size;
+	const void *data;
+} Amber_LibraryDesc;
+
+// Note: nodes may only reference inputs with lower indices, the last node is the graph output.
+//       clip:     samples 'sequence' at parameters[time_parameter], no inputs
+//       blend:    weighted sum of all inputs, weights are taken from parameters[weight_parameters[i]]
+//       additive: inputs[0] is the base pose, inputs[1..n] are additive poses applied with their weights
+//       mask:     lerps from inputs[0] to inputs[1] using joint_weights scaled by the weight of inputs[1]
+//       A weight parameter equal to AMBER_GRAPH_PARAMETER_NONE means constant weight of 1.0f.
+typedef struct Amber_GraphNodeDesc_t
+{
+	Amber_GraphNodeType type;
+	uint32_t input_count;
+	const uint32_t *inputs;
+	const uint32_t *weight_parameters;
+	Amber_Sequence sequence;
+	uint32_t time_parameter;
+	const float *joint_weights;
+} Amber_GraphNodeDesc;
+
+typedef struct Amber_GraphDesc_t
+{
+	Amber_Armature armature;
+	Amber_Pose reference_pose;
+	uint32_t parameter_count;
+	uint32_t node_count;
+	const Amber_GraphNodeDesc *nodes;
+} Amber_GraphDesc;
+
+typedef struct Amber_BlendDesc_t
+{
+	uint32_t src_pose_count;
+	const Amber_Pose *src_poses;
+	const float *src_weights;
+	Amber_Pose dst_pose;
+} Amber_BlendDesc;
+
+typedef struct Amber_PoolStats_t
+{
+	uint32_t size;
+	uint32_t capacity;
+} Amber_PoolStats;
+
+// Note: a hit is a sample of a cached sequence that was resident, a miss had to wait for it to be loaded.
+//       Resident bytes and counts include sequences that are still loading.
+typedef struct Amber_SequenceCacheStats_t
+{
+	uint64_t budget_bytes;
+	uint64_t resident_bytes;
+	uint32_t sequence_count;
+	uint32_t resident_count;
+	uint64_t hit_count;
+	uint64_t miss_count;
+	uint64_t eviction_count;
+} Amber_SequenceCacheStats;
+
+// Note: 'allocated_bytes' and allocation counts cover every allocation made through the instance allocator,
+//       including the instance itself and pool pages. The remaining fields are gathered from live objects.
+//       Counters are read without stopping other threads, so they are a snapshot that may be slightly stale.
+typedef struct Amber_InstanceStats_t
+{
+	uint64_t allocated_bytes[AMBER_MEMORY_CATEGORY_ENUM_MAX];
+	uint64_t allocation_count;
+	uint64_t total_allocation_count;
+
+	Amber_PoolStats armatures;
+	Amber_PoolStats poses;
+	Amber_PoolStats sequences;
+	Amber_PoolStats graphs;
+	Amber_PoolStats transient_poses;
+
+	uint64_t joint_name_bytes;
+	uint64_t pose_transform_bytes;
+	uint64_t sequence_track_count;
+	uint64_t sequence_key_count;
+	uint64_t sequence_key_bytes;
+
+	Amber_SequenceCacheStats sequence_cache;
+} Amber_InstanceStats;
+
+// Note: a track is a single animated channel (e.g. rotation.x of a joint), constant tracks hold exactly one key.
+//       'memory_bytes' is the size of the sequence blob, the root motion curve included. Streaming sequences only
+//       report their resident memory and cached sequences the size of their blob, tracks and keys are not counted.
+typedef struct Amber_SequenceStats_t
+{
+	uint32_t joint_count;
+	uint32_t track_count;
+	uint32_t constant_track_count;
+	uint64_t key_count;
+	uint64_t key_bytes;
+	uint64_t memory_bytes;
+	float min_time;
+	float max_time;
+} Amber_SequenceStats;
+
+// Note: counts are totals, not increments, pools never shrink below already reserved capacity.
+typedef struct Amber_CapacityDesc_t
+{
+	uint32_t armature_count;
+	uint32_t pose_count;
+	uint32_t sequence_count;
+	uint32_t graph_count;
+} Amber_CapacityDesc;
+
 // Function pointers
+typedef Amber_Result (*PFN_amberReserveCapacity)(Amber_Instance instance, const Amber_CapacityDesc *desc);
+
 typedef Amber_Result (*PFN_amberCreateArmature)(Amber_Instance instance, const Amber_ArmatureDesc *desc, Amber_Armature* armature);
+// Note: returns AMBER_INVALID_HANDLE if the armature was destroyed
 typedef Amber_Result (*PFN_amberCreatePose)(Amber_Instance instance, const Amber_PoseDesc *desc, Amber_Pose *pose);
+// Note: bulk variants reserve pool capacity once and place the storage of all objects in one allocation,
+//       which is released when the last object created from it is destroyed. Poses are only created
+//       if all their armatures are alive, otherwise AMBER_INVALID_HANDLE is returned.
+typedef Amber_Result (*PFN_amberCreatePoses)(Amber_Instance instance, uint32_t pose_count, const Amber_PoseDesc *descs, Amber_Pose *poses);
+// Note: transient poses stay valid until the next amberResetTransientPoses call, destroying them is a no-op.
+//       Their armature must not be destroyed before that reset. Returns AMBER_INTERNAL_ERROR once the
+//       transient pose capacity (262144 poses) is used up until the next reset.
+typedef Amber_Result (*PFN_amberCreateTransientPose)(Amber_Instance instance, const Amber_PoseDesc *desc, Amber_Pose *pose);
 typedef Amber_Result (*PFN_amberCreateSequence)(Amber_Instance instance, const Amber_SequenceDesc *desc, Amber_Sequence *sequence);
-
+typedef Amber_Result (*PFN_amberCreateSequences)(Amber_Instance instance, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Sequence *sequences);
+// Note: the blob is validated but not copied, returns AMBER_INVALID_DATA if the header, joint indices or curve
+//       key ranges are malformed or it was written by an incompatible library version
+typedef Amber_Result (*PFN_amberCreateSequenceFromMemory)(Amber_Instance instance, const Amber_SequenceMemoryDesc *desc, Amber_Sequence *sequence);
+// Note: handles are returned right away, keys are copied on a background thread and the sequences are ready
+//       once 'fence' completes. 'descs' and everything they reference must stay valid until then.
+//       Sampling a sequence that is not ready yet writes the transforms of 'fallback_pose' (copied at this call,
+//       e.g. the bind pose), or leaves the destination untouched if it is AMBER_NULL_HANDLE, root motion is identity.
+//       Destroying a sequence, querying its stats or serializing it waits for its load to finish.
+typedef Amber_Result (*PFN_amberCreateSequencesAsync)(Amber_Instance instance, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Pose fallback_pose, Amber_Sequence *sequences, uint64_t *fence);
+// Note: only the stream header and chunk table are read here, returns AMBER_INVALID_DATA if the stream can't be
+//       read or is malformed. Chunks are loaded on the loader thread as sampling moves through the sequence,
+//       sampling a chunk that is not resident yet samples the closest resident chunk instead (or leaves the
+//       destination untouched if there is none) and root motion is identity. Serializing it returns AMBER_NOT_IMPLEMENTED.
+typedef Amber_Result (*PFN_amberCreateStreamingSequence)(Amber_Instance instance, const Amber_StreamingSequenceDesc *desc, Amber_Sequence *sequence);
+// Note: only the blob header is read here, returns AMBER_INVALID_DATA if it can't be read or is malformed.
+//       The blob is loaded when the sequence is sampled and the sample waits for it, so 'read' may expand data
+//       the application keeps compressed. Resident cached sequences share the instance sequence cache budget.
+//       Sampling a sequence that fails to load writes the transforms of 'fallback_pose' like sequences created
+//       by amberCreateSequencesAsync, or leaves the destination untouched if there is none, root motion is identity.
+typedef Amber_Result (*PFN_amberCreateCachedSequence)(Amber_Instance instance, const Amber_CachedSequenceDesc *desc, Amber_Sequence *sequence);
+// Note: recreates every armature and sequence of a snapshot under the handle it had when the snapshot was taken,
+//       their data is copied into a single allocation which is released once all of them are destroyed.
+//       Returns AMBER_INVALID_DATA if the snapshot is malformed or one of its handles is in use, nothing is created then.
+typedef Amber_Result (*PFN_amberLoadSnapshot)(Amber_Instance instance, const Amber_SnapshotDesc *desc);
+// Note: same as amberLoadSnapshot, except that nothing is copied: armatures and sequences reference the library
+//       memory in place and keep the library alive until they are destroyed, so any number of instances may share
+//       one library without duplicating it. Library memory is not included in the instance memory stats.
+//       The library must not be destroyed while it is being attached.
+typedef Amber_Result (*PFN_amberAttachLibrary)(Amber_Instance instance, Amber_Library library);
+typedef Amber_Result (*PFN_amberCreateGraph)(Amber_Instance instance, const Amber_GraphDesc *desc, Amber_Graph *graph);
+
+// Note: returns AMBER_INVALID_HANDLE if the armature was already destroyed
 typedef Amber_Result (*PFN_amberDestroyArmature)(Amber_Instance instance, Amber_Armature armature);
 typedef Amber_Result (*PFN_amberDestroyPose)(Amber_Instance instance, Amber_Pose pose);
+typedef Amber_Result (*PFN_amberDestroyPoses)(Amber_Instance instance, uint32_t pose_count, const Amber_Pose *poses);
+typedef Amber_Result (*PFN_amberResetTransientPoses)(Amber_Instance instance);
 typedef Amber_Result (*PFN_amberDestroySequence)(Amber_Instance instance, Amber_Sequence sequence);
+typedef Amber_Result (*PFN_amberDestroySequences)(Amber_Instance instance, uint32_t sequence_count, const Amber_Sequence *sequences);
+typedef Amber_Result (*PFN_amberDestroyGraph)(Amber_Instance instance, Amber_Graph graph);
 typedef Amber_Result (*PFN_amberDestroyInstance)(Amber_Instance instance);
 
 typedef Amber_Result (*PFN_amberCopyPose)(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose dst_pose);
@@ -150,16 +555,102 @@ typedef Amber_Result (*PFN_amberInvertPose)(Amber_Instance instance, Amber_Pose
 typedef Amber_Result (*PFN_amberMapPose)(Amber_Instance instance, Amber_Pose pose, Amber_Transform **transforms);
 typedef Amber_Result (*PFN_amberUnmapPose)(Amber_Instance instance, Amber_Pose pose);
 
+// Note: if 'poses' is NULL, 'pose_count' receives the number of poses created with 'armature',
+//       otherwise up to 'pose_count' handles are written and 'pose_count' receives the written count.
+//       If 'poses' is too small, it is filled, 'pose_count' receives the required count and
+//       AMBER_INVALID_OUTPUT_ARGUMENT is returned.
+//       Transient poses are never enumerated. Order is unspecified and changes when poses are destroyed.
+typedef Amber_Result (*PFN_amberEnumeratePoses)(Amber_Instance instance, Amber_Armature armature, uint32_t *pose_count, Amber_Pose *poses);
+typedef Amber_Result (*PFN_amberGetPoseJointCount)(Amber_Instance instance, Amber_Pose pose, uint32_t *joint_count);
+typedef Amber_Result (*PFN_amberGetInstanceStats)(Amber_Instance instance, Amber_InstanceStats *stats);
+typedef Amber_Result (*PFN_amberGetSequenceStats)(Amber_Instance instance, Amber_Sequence sequence, Amber_SequenceStats *stats);
+// Note: if 'data' is NULL, 'size' receives the blob size in bytes, otherwise the blob is written to 'data',
+//       which must be at least 'size' bytes. Blobs are relocatable and can be stored to disk as-is.
+typedef Amber_Result (*PFN_amberSerializeSequence)(Amber_Instance instance, Amber_Sequence sequence, uint64_t *size, void *data);
+// Note: same size query as amberSerializeSequence, writes a stream of 'chunk_duration' second chunks for amberCreateStreamingSequence
+typedef Amber_Result (*PFN_amberSerializeStreamingSequence)(Amber_Instance instance, Amber_Sequence sequence, float chunk_duration, uint64_t *size, void *data);
+// Note: same size query as amberSerializeSequence, writes all armatures and sequences for amberLoadSnapshot.
+//       Poses, graphs, streaming and cached sequences are not part of a snapshot, sequences that are still
+//       loading are waited for. Snapshots are meant to be loaded into an instance that has none of these handles.
+typedef Amber_Result (*PFN_amberSerializeSnapshot)(Amber_Instance instance, uint64_t *size, void *data);
+
 typedef Amber_Result (*PFN_amberSampleRootMotion)(Amber_Instance instance, Amber_Sequence sequence, float prev_time, float time, Amber_Transform *dst_transform);
 typedef Amber_Result (*PFN_amberSamplePose)(Amber_Instance instance, Amber_Sequence sequence, float time, Amber_Pose dst_pose);
+// Note: batch variants process items in parallel on the instance job system, destination poses must be distinct.
+typedef Amber_Result (*PFN_amberSamplePoseBatch)(Amber_Instance instance, uint32_t count, const Amber_Sequence *sequences, const float *times, const Amber_Pose *dst_poses);
 
 typedef Amber_Result (*PFN_amberBlendPoses)(Amber_Instance instance, uint32_t src_pose_count, const Amber_Pose *src_poses, const float *src_weights, Amber_Pose dst_pose);
+typedef Amber_Result (*PFN_amberBlendPoseBatch)(Amber_Instance instance, uint32_t count, const Amber_BlendDesc *descs);
 typedef Amber_Result (*PFN_amberComputeAdditivePose)(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose src_reference_pose, Amber_Pose dst_pose);
 typedef Amber_Result (*PFN_amberApplyAdditivePoses)(Amber_Instance instance, Amber_Pose src_pose, uint32_t src_additive_pose_count, const Amber_Pose *src_additive_poses, const float *src_weights, Amber_Pose dst_pose);
 
 typedef Amber_Result (*PFN_amberConvertToWorldPose)(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose dst_pose);
+typedef Amber_Result (*PFN_amberConvertToWorldPoseBatch)(Amber_Instance instance, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses);
 typedef Amber_Result (*PFN_amberConvertToLocalPose)(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose dst_pose);
+typedef Amber_Result (*PFN_amberConvertToLocalPoseBatch)(Amber_Instance instance, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses);
+
+// Note: evaluation scratch is allocated per call and freed before returning. Clip sequences are looked up
+//       on every evaluation, returns AMBER_INVALID_HANDLE if one of them was destroyed and AMBER_INVALID_DATA
+//       if fewer parameters than the graph was created with are passed.
+typedef Amber_Result (*PFN_amberEvaluateGraph)(Amber_Instance instance, Amber_Graph graph, uint32_t parameter_count, const float *parameters, Amber_Pose dst_pose);
 
+// Unchecked function pointers
+// Note: unchecked functions take resolved tokens and skip handle validation entirely, passing
+//       a token of a destroyed object is undefined behavior. Tokens stay valid for the lifetime
+//       of the object, tokens of transient poses stay valid until the next transient reset.
+typedef Amber_Result (*PFN_amberUncheckedCopyPose)(Amber_Instance instance, Amber_ResolvedPose src_pose, Amber_ResolvedPose dst_pose);
+typedef Amber_Result (*PFN_amberUncheckedMapPose)(Amber_Instance instance, Amber_ResolvedPose pose, Amber_Transform **transforms);
+
+typedef Amber_Result (*PFN_amberUncheckedSampleRootMotion)(Amber_Instance instance, Amber_ResolvedSequence sequence, float prev_time, float time, Amber_Transform *dst_transform);
+typedef Amber_Result (*PFN_amberUncheckedSamplePose)(Amber_Instance instance, Amber_ResolvedSequence sequence, float time, Amber_ResolvedPose dst_pose);
+
+typedef Amber_Result (*PFN_amberUncheckedBlendPoses)(Amber_Instance instance, uint32_t src_pose_count, const Amber_ResolvedPose *src_poses, const float *src_weights, Amber_ResolvedPose dst_pose);
+typedef Amber_Result (*PFN_amberUncheckedComputeAdditivePose)(Amber_Instance instance, Amber_ResolvedPose src_pose, Amber_ResolvedPose src_reference_pose, Amber_ResolvedPose dst_pose);
+typedef Amber_Result (*PFN_amberUncheckedApplyAdditivePoses)(Amber_Instance instance, Amber_ResolvedPose src_pose, uint32_t src_additive_pose_count, const Amber_ResolvedPose *src_additive_poses, const float *src_weights, Amber_ResolvedPose dst_pose);
+
+typedef Amber_Result (*PFN_amberUncheckedConvertToWorldPose)(Amber_Instance instance, Amber_ResolvedPose src_pose, Amber_ResolvedPose dst_pose);
+typedef Amber_Result (*PFN_amberUncheckedConvertToLocalPose)(Amber_Instance instance, Amber_ResolvedPose src_pose, Amber_ResolvedPose dst_pose);
+
+typedef struct Amber_UncheckedTable_t
+{
+	PFN_amberUncheckedCopyPose copyPose;
+	PFN_amberUncheckedMapPose mapPose;
+
+	PFN_amberUncheckedSampleRootMotion sampleRootMotion;
+	PFN_amberUncheckedSamplePose samplePose;
+
+	PFN_amberUncheckedBlendPoses blendPoses;
+	PFN_amberUncheckedComputeAdditivePose computeAdditivePose;
+	PFN_amberUncheckedApplyAdditivePoses applyAdditivePoses;
+
+	PFN_amberUncheckedConvertToWorldPose convertToWorldPose;
+	PFN_amberUncheckedConvertToLocalPose convertToLocalPose;
+} Amber_UncheckedTable;
+
+typedef Amber_Result (*PFN_amberResolvePose)(Amber_Instance instance, Amber_Pose pose, Amber_ResolvedPose *resolved_pose);
+typedef Amber_Result (*PFN_amberResolveSequence)(Amber_Instance instance, Amber_Sequence sequence, Amber_ResolvedSequence *resolved_sequence);
+typedef Amber_Result (*PFN_amberGetUncheckedTable)(Amber_Instance instance, Amber_UncheckedTable *unchecked_table);
+
+// Note: captures are fed by profiler zones and return AMBER_NOT_IMPLEMENTED if the library is built without
+//       AMBER_PROFILE_ZONES. Ending a capture waits for zones still recording on other threads, including the
+//       loader thread, then writes Chrome trace-event JSON to 'path' (NULL discards the events). Beginning and
+//       ending must not overlap each other. Beginning while a capture is active, ending while none is, or
+//       failing to allocate the capture returns AMBER_INTERNAL_ERROR.
+typedef Amber_Result (*PFN_amberBeginCapture)(Amber_Instance instance, const Amber_CaptureDesc *desc);
+typedef Amber_Result (*PFN_amberEndCapture)(Amber_Instance instance, const char *path);
+
+// Note: fences complete in submission order, a fence of zero is always complete
+typedef Amber_Result (*PFN_amberGetFenceStatus)(Amber_Instance instance, uint64_t fence, uint32_t *complete);
+typedef Amber_Result (*PFN_amberWaitFence)(Amber_Instance instance, uint64_t fence);
+// Note: requests the chunks around 'time' (e.g. before starting playback or after a seek), 'fence' completes once
+//       they are resident. Cached sequences are loaded as a whole and 'time' is ignored, other sequences are
+//       always resident and return a fence of zero.
+typedef Amber_Result (*PFN_amberPrefetchStreamingSequence)(Amber_Instance instance, Amber_Sequence sequence, float time, uint64_t *fence);
+
+// Note: evicts unpinned cached sequences right away if they exceed the new budget
+typedef Amber_Result (*PFN_amberSetSequenceCacheBudget)(Amber_Instance instance, uint64_t budget);
+
+// Note: new entries are only ever appended, so layers and tables built against an older layout stay valid
 typedef struct Amber_InstanceTable_t
 {
 	PFN_amberCreateArmature createArmature;
@@ -186,20 +677,95 @@ typedef struct Amber_InstanceTable_t
 
 	PFN_amberConvertToWorldPose convertToWorldPose;
 	PFN_amberConvertToLocalPose convertToLocalPose;
+
+	PFN_amberCreateGraph createGraph;
+	PFN_amberDestroyGraph destroyGraph;
+	PFN_amberEvaluateGraph evaluateGraph;
+
+	PFN_amberCreateTransientPose createTransientPose;
+	PFN_amberResetTransientPoses resetTransientPoses;
+
+	PFN_amberReserveCapacity reserveCapacity;
+
+	PFN_amberEnumeratePoses enumeratePoses;
+
+	PFN_amberCreatePoses createPoses;
+	PFN_amberCreateSequences createSequences;
+	PFN_amberDestroyPoses destroyPoses;
+	PFN_amberDestroySequences destroySequences;
+
+	PFN_amberResolvePose resolvePose;
+	PFN_amberResolveSequence resolveSequence;
+	PFN_amberGetUncheckedTable getUncheckedTable;
+
+	PFN_amberSamplePoseBatch samplePoseBatch;
+	PFN_amberBlendPoseBatch blendPoseBatch;
+	PFN_amberConvertToWorldPoseBatch convertToWorldPoseBatch;
+	PFN_amberConvertToLocalPoseBatch convertToLocalPoseBatch;
+
+	PFN_amberGetPoseJointCount getPoseJointCount;
+
+	PFN_amberBeginCapture beginCapture;
+	PFN_amberEndCapture endCapture;
+
+	PFN_amberGetInstanceStats getInstanceStats;
+	PFN_amberGetSequenceStats getSequenceStats;
+
+	PFN_amberCreateSequenceFromMemory createSequenceFromMemory;
+	PFN_amberSerializeSequence serializeSequence;
+
+	PFN_amberCreateSequencesAsync createSequencesAsync;
+	PFN_amberGetFenceStatus getFenceStatus;
+	PFN_amberWaitFence waitFence;
+
+	PFN_amberCreateStreamingSequence createStreamingSequence;
+	PFN_amberSerializeStreamingSequence serializeStreamingSequence;
+	PFN_amberPrefetchStreamingSequence prefetchStreamingSequence;
+
+	PFN_amberCreateCachedSequence createCachedSequence;
+	PFN_amberSetSequenceCacheBudget setSequenceCacheBudget;
+
+	PFN_amberLoadSnapshot loadSnapshot;
+	PFN_amberSerializeSnapshot serializeSnapshot;
+
+	PFN_amberAttachLibrary attachLibrary;
 } Amber_InstanceTable;
 
 // API
 #if !defined(AMBER_NO_PROTOTYPES)
 AMBER_APIENTRY Amber_Result amberCreateInstance(const Amber_InstanceDesc *desc, Amber_Instance* instance);
 AMBER_APIENTRY Amber_Result amberGetInstanceTable(Amber_Instance instance, Amber_InstanceTable *instance_table);
+AMBER_APIENTRY Amber_Result amberGetProfilingLayer(Amber_ProfilingCounters *counters, Amber_LayerDesc *layer);
+
+// Note: libraries are immutable and reference counted, amberDestroyLibrary releases the reference held by the
+//       creator and the memory is freed once no instance references the library anymore.
+//       Returns AMBER_INVALID_DATA if the snapshot is malformed.
+AMBER_APIENTRY Amber_Result amberCreateLibrary(const Amber_LibraryDesc *desc, Amber_Library *library);
+AMBER_APIENTRY Amber_Result amberDestroyLibrary(Amber_Library library);
+
+AMBER_APIENTRY Amber_Result amberReserveCapacity(Amber_Instance instance, const Amber_CapacityDesc *desc);
 
 AMBER_APIENTRY Amber_Result amberCreateArmature(Amber_Instance instance, const Amber_ArmatureDesc *desc, Amber_Armature* armature);
 AMBER_APIENTRY Amber_Result amberCreatePose(Amber_Instance instance, const Amber_PoseDesc *desc, Amber_Pose *pose);
+AMBER_APIENTRY Amber_Result amberCreatePoses(Amber_Instance instance, uint32_t pose_count, const Amber_PoseDesc *descs, Amber_Pose *poses);
+AMBER_APIENTRY Amber_Result amberCreateTransientPose(Amber_Instance instance, const Amber_PoseDesc *desc, Amber_Pose *pose);
 AMBER_APIENTRY Amber_Result amberCreateSequence(Amber_Instance instance, const Amber_SequenceDesc *desc, Amber_Sequence *sequence);
+AMBER_APIENTRY Amber_Result amberCreateSequences(Amber_Instance instance, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Sequence *sequences);
+AMBER_APIENTRY Amber_Result amberCreateSequenceFromMemory(Amber_Instance instance, const Amber_SequenceMemoryDesc *desc, Amber_Sequence *sequence);
+AMBER_APIENTRY Amber_Result amberCreateSequencesAsync(Amber_Instance instance, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Pose fallback_pose, Amber_Sequence *sequences, uint64_t *fence);
+AMBER_APIENTRY Amber_Result amberCreateStreamingSequence(Amber_Instance instance, const Amber_StreamingSequenceDesc *desc, Amber_Sequence *sequence);
+AMBER_APIENTRY Amber_Result amberCreateCachedSequence(Amber_Instance instance, const Amber_CachedSequenceDesc *desc, Amber_Sequence *sequence);
+AMBER_APIENTRY Amber_Result amberLoadSnapshot(Amber_Instance instance, const Amber_SnapshotDesc *desc);
+AMBER_APIENTRY Amber_Result amberAttachLibrary(Amber_Instance instance, Amber_Library library);
+AMBER_APIENTRY Amber_Result amberCreateGraph(Amber_Instance instance, const Amber_GraphDesc *desc, Amber_Graph *graph);
 
 AMBER_APIENTRY Amber_Result amberDestroyArmature(Amber_Instance instance, Amber_Armature armature);
 AMBER_APIENTRY Amber_Result amberDestroyPose(Amber_Instance instance, Amber_Pose pose);
+AMBER_APIENTRY Amber_Result amberDestroyPoses(Amber_Instance instance, uint32_t pose_count, const Amber_Pose *poses);
+AMBER_APIENTRY Amber_Result amberResetTransientPoses(Amber_Instance instance);
 AMBER_APIENTRY Amber_Result amberDestroySequence(Amber_Instance instance, Amber_Sequence sequence);
+AMBER_APIENTRY Amber_Result amberDestroySequences(Amber_Instance instance, uint32_t sequence_count, const Amber_Sequence *sequences);
+AMBER_APIENTRY Amber_Result amberDestroyGraph(Amber_Instance instance, Amber_Graph graph);
 AMBER_APIENTRY Amber_Result amberDestroyInstance(Amber_Instance instance);
 
 AMBER_APIENTRY Amber_Result amberCopyPose(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose dst_pose);
@@ -207,16 +773,42 @@ AMBER_APIENTRY Amber_Result amberMultiplyPose(Amber_Instance instance, Amber_Pos
 AMBER_APIENTRY Amber_Result amberInvertPose(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose dst_pose);
 AMBER_APIENTRY Amber_Result amberMapPose(Amber_Instance instance, Amber_Pose pose, Amber_Transform **transforms);
 AMBER_APIENTRY Amber_Result amberUnmapPose(Amber_Instance instance, Amber_Pose pose);
+AMBER_APIENTRY Amber_Result amberEnumeratePoses(Amber_Instance instance, Amber_Armature armature, uint32_t *pose_count, Amber_Pose *poses);
+AMBER_APIENTRY Amber_Result amberGetPoseJointCount(Amber_Instance instance, Amber_Pose pose, uint32_t *joint_count);
+AMBER_APIENTRY Amber_Result amberGetInstanceStats(Amber_Instance instance, Amber_InstanceStats *stats);
+AMBER_APIENTRY Amber_Result amberGetSequenceStats(Amber_Instance instance, Amber_Sequence sequence, Amber_SequenceStats *stats);
+AMBER_APIENTRY Amber_Result amberSerializeSequence(Amber_Instance instance, Amber_Sequence sequence, uint64_t *size, void *data);
+AMBER_APIENTRY Amber_Result amberSerializeStreamingSequence(Amber_Instance instance, Amber_Sequence sequence, float chunk_duration, uint64_t *size, void *data);
+AMBER_APIENTRY Amber_Result amberSerializeSnapshot(Amber_Instance instance, uint64_t *size, void *data);
 
 AMBER_APIENTRY Amber_Result amberSampleRootMotion(Amber_Instance instance, Amber_Sequence sequence, float prev_time, float time, Amber_Transform *dst_transform);
 AMBER_APIENTRY Amber_Result amberSamplePose(Amber_Instance instance, Amber_Sequence sequence, float time, Amber_Pose dst_pose);
+AMBER_APIENTRY Amber_Result amberSamplePoseBatch(Amber_Instance instance, uint32_t count, const Amber_Sequence *sequences, const float *times, const Amber_Pose *dst_poses);
 
 AMBER_APIENTRY Amber_Result amberBlendPoses(Amber_Instance instance, uint32_t src_pose_count, const Amber_Pose *src_poses, const float *src_weights, Amber_Pose dst_pose);
+AMBER_APIENTRY Amber_Result amberBlendPoseBatch(Amber_Instance instance, uint32_t count, const Amber_BlendDesc *descs);
 AMBER_APIENTRY Amber_Result amberComputeAdditivePose(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose src_reference_pose, Amber_Pose dst_pose);
 AMBER_APIENTRY Amber_Result amberApplyAdditivePoses(Amber_Instance instance, Amber_Pose src_pose, uint32_t src_additive_pose_count, const Amber_Pose *src_additive_poses, const float *src_weights, Amber_Pose dst_pose);
 
 AMBER_APIENTRY Amber_Result amberConvertToWorldPose(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose dst_pose);
+AMBER_APIENTRY Amber_Result amberConvertToWorldPoseBatch(Amber_Instance instance, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses);
 AMBER_APIENTRY Amber_Result amberConvertToLocalPose(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose dst_pose);
+AMBER_APIENTRY Amber_Result amberConvertToLocalPoseBatch(Amber_Instance instance, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses);
+
+AMBER_APIENTRY Amber_Result amberEvaluateGraph(Amber_Instance instance, Amber_Graph graph, uint32_t parameter_count, const float *parameters, Amber_Pose dst_pose);
+
+AMBER_APIENTRY Amber_Result amberResolvePose(Amber_Instance instance, Amber_Pose pose, Amber_ResolvedPose *resolved_pose);
+AMBER_APIENTRY Amber_Result amberResolveSequence(Amber_Instance instance, Amber_Sequence sequence, Amber_ResolvedSequence *resolved_sequence);
+AMBER_APIENTRY Amber_Result amberGetUncheckedTable(Amber_Instance instance, Amber_UncheckedTable *unchecked_table);
+
+AMBER_APIENTRY Amber_Result amberBeginCapture(Amber_Instance instance, const Amber_CaptureDesc *desc);
+AMBER_APIENTRY Amber_Result amberEndCapture(Amber_Instance instance, const char *path);
+
+AMBER_APIENTRY Amber_Result amberGetFenceStatus(Amber_Instance instance, uint64_t fence, uint32_t *complete);
+AMBER_APIENTRY Amber_Result amberWaitFence(Amber_Instance instance, uint64_t fence);
+AMBER_APIENTRY Amber_Result amberPrefetchStreamingSequence(Amber_Instance instance, Amber_Sequence sequence, float time, uint64_t *fence);
+
+AMBER_APIENTRY Amber_Result amberSetSequenceCacheBudget(Amber_Instance instance, uint64_t budget);
 #endif
 
 #ifdef __cplusplus
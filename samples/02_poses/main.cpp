@@ -1,5 +1,6 @@
 #include <amber.h>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 
 void testPoses(Amber_Instance instance)
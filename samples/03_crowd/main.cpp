@@ -0,0 +1,332 @@
+#include <amber.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+static const uint32_t joint_count = 23;
+static const uint32_t locomotion_sequence_count = 4;
+static const uint32_t max_layer_count = 4;
+static const uint32_t keys_per_second = 30;
+
+static const float sequence_duration = 1.0f;
+static const float frame_delta = 1.0f / 30.0f;
+
+static const int32_t joint_parents[joint_count] =
+{
+	-1,
+	0, 1, 2, 3, 4, 5,
+	3, 7, 8, 9,
+	3, 11, 12, 13,
+	0, 15, 16, 17,
+	0, 19, 20, 21,
+};
+
+// Note: the additive layer only touches the spine, e.g. breathing or leaning
+static const uint32_t additive_joints[] = {1, 2, 3, 4};
+
+struct Character
+{
+	uint32_t layer_count;
+	uint32_t sequence_indices[max_layer_count];
+	float weights[max_layer_count];
+	float time;
+
+	Amber_Pose layer_poses[max_layer_count];
+	Amber_Pose additive_pose;
+	Amber_Pose local_pose;
+	Amber_Pose world_pose;
+};
+
+struct Crowd
+{
+	Amber_Instance instance;
+	Amber_Armature armature;
+	Amber_Sequence sequences[locomotion_sequence_count];
+	Amber_Sequence additive_sequence;
+	std::vector<Character> characters;
+};
+
+/*
+ */
+static Amber_Sequence createSequence(Amber_Instance instance, Amber_Armature armature, uint32_t sequence_joint_count, const uint32_t *joint_indices, float amplitude, float frequency)
+{
+	const uint32_t key_count = (uint32_t)(sequence_duration * keys_per_second) + 1;
+
+	std::vector<Amber_SequenceKey> keys(sequence_joint_count * 4 * key_count);
+	std::vector<Amber_SequenceJointCurve> curves(sequence_joint_count);
+
+	static const Amber_SequenceKey zero_key = {0.0f, 0.0f, {0.0f, 0.0f}, {0.0f, 0.0f}};
+	static const Amber_SequenceKey one_key = {0.0f, 1.0f, {0.0f, 0.0f}, {0.0f, 0.0f}};
+
+	for (uint32_t i = 0; i < sequence_joint_count; ++i)
+	{
+		Amber_SequenceJointCurve &curve = curves[i];
+		Amber_SequenceKey *joint_keys = &keys[i * 4 * key_count];
+
+		// Note: a looping swing around the joint x axis, phase shifted along the hierarchy
+		for (uint32_t k = 0; k < key_count; ++k)
+		{
+			float time = sequence_duration * (float)k / (float)(key_count - 1);
+			float angle = amplitude * sinf(6.2831853f * frequency * time + 0.3f * (float)joint_indices[i]);
+
+			joint_keys[0 * key_count + k] = {time, sinf(angle * 0.5f), {0.0f, 0.0f}, {0.0f, 0.0f}};
+			joint_keys[1 * key_count + k] = {time, 0.0f, {0.0f, 0.0f}, {0.0f, 0.0f}};
+			joint_keys[2 * key_count + k] = {time, 0.0f, {0.0f, 0.0f}, {0.0f, 0.0f}};
+			joint_keys[3 * key_count + k] = {time, cosf(angle * 0.5f), {0.0f, 0.0f}, {0.0f, 0.0f}};
+		}
+
+		for (uint32_t c = 0; c < 3; ++c)
+		{
+			curve.position_curves[c] = {1, &zero_key};
+			curve.scale_curves[c] = {1, &one_key};
+		}
+
+		for (uint32_t c = 0; c < 4; ++c)
+			curve.rotation_curves[c] = {key_count, &joint_keys[c * key_count]};
+	}
+
+	Amber_SequenceDesc desc = {armature, sequence_joint_count, joint_indices, curves.data(), NULL};
+	Amber_Sequence sequence = AMBER_NULL_HANDLE;
+
+	Amber_Result result = amberCreateSequence(instance, &desc, &sequence);
+	assert(result == AMBER_SUCCESS);
+
+	return sequence;
+}
+
+static void createCrowd(Crowd &crowd, uint32_t character_count)
+{
+	Amber_Result result = AMBER_SUCCESS;
+
+	// Note: all character poses share slabs, which keeps transforms of the crowd dense in memory
+	Amber_ArmatureDesc armature_desc = {joint_count, joint_parents, NULL, 256};
+
+	result = amberCreateArmature(crowd.instance, &armature_desc, &crowd.armature);
+	assert(result == AMBER_SUCCESS);
+
+	uint32_t all_joints[joint_count];
+	for (uint32_t i = 0; i < joint_count; ++i)
+		all_joints[i] = i;
+
+	for (uint32_t i = 0; i < locomotion_sequence_count; ++i)
+		crowd.sequences[i] = createSequence(crowd.instance, crowd.armature, joint_count, all_joints, 0.2f + 0.1f * (float)i, 1.0f + (float)i);
+
+	uint32_t additive_joint_count = sizeof(additive_joints) / sizeof(additive_joints[0]);
+	crowd.additive_sequence = createSequence(crowd.instance, crowd.armature, additive_joint_count, additive_joints, 0.05f, 0.5f);
+
+	Amber_Transform identity[joint_count];
+	for (uint32_t i = 0; i < joint_count; ++i)
+		identity[i] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+
+	Amber_PoseDesc pose_desc = {crowd.armature, 0, NULL};
+	Amber_PoseDesc additive_pose_desc = {crowd.armature, joint_count, identity};
+
+	crowd.characters.resize(character_count);
+
+	for (uint32_t i = 0; i < character_count; ++i)
+	{
+		Character &character = crowd.characters[i];
+		character.layer_count = 2 + i % 3;
+		character.time = sequence_duration * (float)(i % 97) / 97.0f;
+
+		float total_weight = 0.0f;
+		for (uint32_t l = 0; l < character.layer_count; ++l)
+		{
+			character.sequence_indices[l] = (i + l) % locomotion_sequence_count;
+			character.weights[l] = 1.0f + (float)((i * 7 + l * 3) % 5);
+			total_weight += character.weights[l];
+		}
+
+		for (uint32_t l = 0; l < character.layer_count; ++l)
+			character.weights[l] /= total_weight;
+
+		for (uint32_t l = 0; l < character.layer_count; ++l)
+		{
+			result = amberCreatePose(crowd.instance, &pose_desc, &character.layer_poses[l]);
+			assert(result == AMBER_SUCCESS);
+		}
+
+		result = amberCreatePose(crowd.instance, &additive_pose_desc, &character.additive_pose);
+		assert(result == AMBER_SUCCESS);
+
+		result = amberCreatePose(crowd.instance, &pose_desc, &character.local_pose);
+		assert(result == AMBER_SUCCESS);
+
+		result = amberCreatePose(crowd.instance, &pose_desc, &character.world_pose);
+		assert(result == AMBER_SUCCESS);
+	}
+}
+
+static void destroyCrowd(Crowd &crowd)
+{
+	Amber_Result result = AMBER_SUCCESS;
+
+	for (Character &character : crowd.characters)
+	{
+		result = amberDestroyPoses(crowd.instance, character.layer_count, character.layer_poses);
+		assert(result == AMBER_SUCCESS);
+
+		Amber_Pose poses[] = {character.additive_pose, character.local_pose, character.world_pose};
+
+		result = amberDestroyPoses(crowd.instance, 3, poses);
+		assert(result == AMBER_SUCCESS);
+	}
+
+	crowd.characters.clear();
+
+	for (uint32_t i = 0; i < locomotion_sequence_count; ++i)
+	{
+		result = amberDestroySequence(crowd.instance, crowd.sequences[i]);
+		assert(result == AMBER_SUCCESS);
+	}
+
+	result = amberDestroySequence(crowd.instance, crowd.additive_sequence);
+	assert(result == AMBER_SUCCESS);
+
+	result = amberDestroyArmature(crowd.instance, crowd.armature);
+	assert(result == AMBER_SUCCESS);
+}
+
+/*
+ */
+static void animateCharacter(const Crowd &crowd, Character &character)
+{
+	Amber_Instance instance = crowd.instance;
+	Amber_Result result = AMBER_SUCCESS;
+
+	character.time = fmodf(character.time + frame_delta, sequence_duration);
+
+	for (uint32_t l = 0; l < character.layer_count; ++l)
+	{
+		result = amberSamplePose(instance, crowd.sequences[character.sequence_indices[l]], character.time, character.layer_poses[l]);
+		assert(result == AMBER_SUCCESS);
+	}
+
+	result = amberBlendPoses(instance, character.layer_count, character.layer_poses, character.weights, character.local_pose);
+	assert(result == AMBER_SUCCESS);
+
+	result = amberSamplePose(instance, crowd.additive_sequence, character.time, character.additive_pose);
+	assert(result == AMBER_SUCCESS);
+
+	const float additive_weight = 1.0f;
+
+	result = amberApplyAdditivePoses(instance, character.local_pose, 1, &character.additive_pose, &additive_weight, character.local_pose);
+	assert(result == AMBER_SUCCESS);
+
+	result = amberConvertToWorldPose(instance, character.local_pose, character.world_pose);
+	assert(result == AMBER_SUCCESS);
+}
+
+// Note: characters are split in contiguous ranges, one per thread, the instance
+//       is safe to use from several threads as long as destination poses are distinct
+static double animateCrowd(Crowd &crowd, uint32_t thread_count, uint32_t frame_count)
+{
+	uint32_t character_count = (uint32_t)crowd.characters.size();
+	auto start = std::chrono::steady_clock::now();
+
+	for (uint32_t frame = 0; frame < frame_count; ++frame)
+	{
+		auto work = [&crowd, character_count, thread_count](uint32_t thread_index)
+		{
+			uint32_t begin = (uint32_t)((uint64_t)character_count * thread_index / thread_count);
+			uint32_t end = (uint32_t)((uint64_t)character_count * (thread_index + 1) / thread_count);
+
+			for (uint32_t i = begin; i < end; ++i)
+				animateCharacter(crowd, crowd.characters[i]);
+		};
+
+		std::vector<std::thread> threads;
+		for (uint32_t t = 1; t < thread_count; ++t)
+			threads.emplace_back(work, t);
+
+		work(0);
+
+		for (std::thread &thread : threads)
+			thread.join();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static void validateCrowd(const Crowd &crowd)
+{
+	for (const Character &character : crowd.characters)
+	{
+		Amber_Transform *transforms = NULL;
+
+		Amber_Result result = amberMapPose(crowd.instance, character.world_pose, &transforms);
+		assert(result == AMBER_SUCCESS);
+
+		for (uint32_t i = 0; i < joint_count; ++i)
+		{
+			const Amber_Quat &q = transforms[i].rotation;
+			float length = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+
+			assert(fabsf(length - 1.0f) < 0.001f);
+			(void)length;
+		}
+
+		result = amberUnmapPose(crowd.instance, character.world_pose);
+		assert(result == AMBER_SUCCESS);
+	}
+}
+
+/*
+ */
+int main(int argc, char **argv)
+{
+	uint32_t character_count = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 1000;
+	uint32_t max_thread_count = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : std::max(1u, std::thread::hardware_concurrency());
+	uint32_t frame_count = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 10) : 30;
+
+	character_count = std::max(character_count, 1u);
+	max_thread_count = std::max(max_thread_count, 1u);
+	frame_count = std::max(frame_count, 1u);
+
+	Amber_Instance instance = AMBER_NULL_HANDLE;
+
+	// Note: the crowd is parallelized by the sample itself, so the instance needs no worker threads
+	Amber_InstanceDesc instance_desc = {};
+	instance_desc.thread_count = 1;
+
+	Amber_Result result = amberCreateInstance(&instance_desc, &instance);
+	assert(result == AMBER_SUCCESS);
+
+	Crowd crowd;
+	crowd.instance = instance;
+
+	createCrowd(crowd, character_count);
+
+	printf("characters: %u, joints: %u, frames: %u\n", character_count, joint_count, frame_count);
+	printf("%8s %12s %16s\n", "threads", "ms/frame", "characters/ms");
+
+	// Note: powers of two below the maximum, then the maximum itself
+	std::vector<uint32_t> thread_counts;
+
+	for (uint32_t thread_count = 1; thread_count < max_thread_count; thread_count *= 2)
+		thread_counts.push_back(thread_count);
+
+	thread_counts.push_back(max_thread_count);
+
+	for (uint32_t thread_count : thread_counts)
+	{
+		double total_ms = animateCrowd(crowd, thread_count, frame_count);
+		double frame_ms = total_ms / (double)frame_count;
+
+		printf("%8u %12.3f %16.1f\n", thread_count, frame_ms, (double)character_count / frame_ms);
+	}
+
+	validateCrowd(crowd);
+	destroyCrowd(crowd);
+
+	result = amberDestroyInstance(instance);
+	assert(result == AMBER_SUCCESS);
+
+	return 0;
+}
@@ -14,7 +14,33 @@ typedef struct Amber_InstanceInternal_t
  */
 Amber_Result amberCreateInstance(const Amber_InstanceDesc *desc, Amber_Instance *instance)
 {
-	return impl_createInstance(desc, instance);
+	Amber_Result result = impl_createInstance(desc, instance);
+	if (result != AMBER_SUCCESS)
+		return result;
+
+	// Note: layers wrap the chain from the innermost one outwards, so layers[0] ends up on top
+	for (uint32_t i = desc->layer_count; i > 0; --i)
+	{
+		const Amber_LayerDesc *layer = &desc->layers[i - 1];
+		assert(layer->create);
+
+		Amber_InstanceInternal *next = (Amber_InstanceInternal *)*instance;
+		assert(next->vtbl);
+
+		Amber_Instance layer_instance = AMBER_NULL_HANDLE;
+		result = layer->create(layer->user_data, desc->allocation_callbacks, *instance, next->vtbl, &layer_instance);
+
+		if (result != AMBER_SUCCESS)
+		{
+			next->vtbl->destroyInstance(*instance);
+			*instance = AMBER_NULL_HANDLE;
+			return result;
+		}
+
+		*instance = layer_instance;
+	}
+
+	return AMBER_SUCCESS;
 }
 
 Amber_Result amberGetInstanceTable(Amber_Instance instance, Amber_InstanceTable *instance_table)
@@ -32,6 +58,47 @@ Amber_Result amberGetInstanceTable(Amber_Instance instance, Amber_InstanceTable
 	return AMBER_SUCCESS;
 }
 
+Amber_Result amberGetProfilingLayer(Amber_ProfilingCounters *counters, Amber_LayerDesc *layer)
+{
+	if (counters == NULL || layer == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	layer->user_data = counters;
+	layer->create = layer_createProfiling;
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amberCreateLibrary(const Amber_LibraryDesc *desc, Amber_Library *library)
+{
+	if (library == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	return impl_createLibrary(desc, library);
+}
+
+Amber_Result amberDestroyLibrary(Amber_Library library)
+{
+	if (library == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_DATA;
+
+	return impl_destroyLibrary(library);
+}
+
+/*
+ */
+Amber_Result amberReserveCapacity(Amber_Instance instance, const Amber_CapacityDesc *desc)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->reserveCapacity);
+
+	return ptr->vtbl->reserveCapacity(instance, desc);
+}
+
 /*
  */
 Amber_Result amberCreateArmature(Amber_Instance instance, const Amber_ArmatureDesc *desc, Amber_Armature* armature)
@@ -58,6 +125,30 @@ Amber_Result amberCreatePose(Amber_Instance instance, const Amber_PoseDesc *desc
 	return ptr->vtbl->createPose(instance, desc, pose);
 }
 
+Amber_Result amberCreatePoses(Amber_Instance instance, uint32_t pose_count, const Amber_PoseDesc *descs, Amber_Pose *poses)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->createPoses);
+
+	return ptr->vtbl->createPoses(instance, pose_count, descs, poses);
+}
+
+Amber_Result amberCreateTransientPose(Amber_Instance instance, const Amber_PoseDesc *desc, Amber_Pose *pose)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->createTransientPose);
+
+	return ptr->vtbl->createTransientPose(instance, desc, pose);
+}
+
 Amber_Result amberCreateSequence(Amber_Instance instance, const Amber_SequenceDesc *desc, Amber_Sequence *sequence)
 {
 	if (instance == AMBER_NULL_HANDLE)
@@ -70,6 +161,117 @@ Amber_Result amberCreateSequence(Amber_Instance instance, const Amber_SequenceDe
 	return ptr->vtbl->createSequence(instance, desc, sequence);
 }
 
+Amber_Result amberCreateSequences(Amber_Instance instance, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Sequence *sequences)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->createSequences);
+
+	return ptr->vtbl->createSequences(instance, sequence_count, descs, sequences);
+}
+
+Amber_Result amberCreateSequenceFromMemory(Amber_Instance instance, const Amber_SequenceMemoryDesc *desc, Amber_Sequence *sequence)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (sequence == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->createSequenceFromMemory);
+
+	return ptr->vtbl->createSequenceFromMemory(instance, desc, sequence);
+}
+
+Amber_Result amberCreateSequencesAsync(Amber_Instance instance, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Pose fallback_pose, Amber_Sequence *sequences, uint64_t *fence)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (fence == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->createSequencesAsync);
+
+	return ptr->vtbl->createSequencesAsync(instance, sequence_count, descs, fallback_pose, sequences, fence);
+}
+
+Amber_Result amberCreateStreamingSequence(Amber_Instance instance, const Amber_StreamingSequenceDesc *desc, Amber_Sequence *sequence)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (sequence == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->createStreamingSequence);
+
+	return ptr->vtbl->createStreamingSequence(instance, desc, sequence);
+}
+
+Amber_Result amberCreateCachedSequence(Amber_Instance instance, const Amber_CachedSequenceDesc *desc, Amber_Sequence *sequence)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (sequence == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->createCachedSequence);
+
+	return ptr->vtbl->createCachedSequence(instance, desc, sequence);
+}
+
+Amber_Result amberLoadSnapshot(Amber_Instance instance, const Amber_SnapshotDesc *desc)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->loadSnapshot);
+
+	return ptr->vtbl->loadSnapshot(instance, desc);
+}
+
+Amber_Result amberAttachLibrary(Amber_Instance instance, Amber_Library library)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (library == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_DATA;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->attachLibrary);
+
+	return ptr->vtbl->attachLibrary(instance, library);
+}
+
+Amber_Result amberCreateGraph(Amber_Instance instance, const Amber_GraphDesc *desc, Amber_Graph *graph)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->createGraph);
+
+	return ptr->vtbl->createGraph(instance, desc, graph);
+}
+
 Amber_Result amberDestroyArmature(Amber_Instance instance, Amber_Armature armature)
 {
 	if (instance == AMBER_NULL_HANDLE)
@@ -94,6 +296,30 @@ Amber_Result amberDestroyPose(Amber_Instance instance, Amber_Pose pose)
 	return ptr->vtbl->destroyPose(instance, pose);
 }
 
+Amber_Result amberDestroyPoses(Amber_Instance instance, uint32_t pose_count, const Amber_Pose *poses)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->destroyPoses);
+
+	return ptr->vtbl->destroyPoses(instance, pose_count, poses);
+}
+
+Amber_Result amberResetTransientPoses(Amber_Instance instance)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->resetTransientPoses);
+
+	return ptr->vtbl->resetTransientPoses(instance);
+}
+
 Amber_Result amberDestroySequence(Amber_Instance instance, Amber_Sequence sequence)
 {
 	if (instance == AMBER_NULL_HANDLE)
@@ -106,6 +332,30 @@ Amber_Result amberDestroySequence(Amber_Instance instance, Amber_Sequence sequen
 	return ptr->vtbl->destroySequence(instance, sequence);
 }
 
+Amber_Result amberDestroySequences(Amber_Instance instance, uint32_t sequence_count, const Amber_Sequence *sequences)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->destroySequences);
+
+	return ptr->vtbl->destroySequences(instance, sequence_count, sequences);
+}
+
+Amber_Result amberDestroyGraph(Amber_Instance instance, Amber_Graph graph)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->destroyGraph);
+
+	return ptr->vtbl->destroyGraph(instance, graph);
+}
+
 Amber_Result amberDestroyInstance(Amber_Instance instance)
 {
 	if (instance == AMBER_NULL_HANDLE)
@@ -178,6 +428,111 @@ Amber_Result amberUnmapPose(Amber_Instance instance, Amber_Pose pose)
 	return ptr->vtbl->unmapPose(instance, pose);
 }
 
+Amber_Result amberEnumeratePoses(Amber_Instance instance, Amber_Armature armature, uint32_t *pose_count, Amber_Pose *poses)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (pose_count == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->enumeratePoses);
+
+	return ptr->vtbl->enumeratePoses(instance, armature, pose_count, poses);
+}
+
+Amber_Result amberGetPoseJointCount(Amber_Instance instance, Amber_Pose pose, uint32_t *joint_count)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (joint_count == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->getPoseJointCount);
+
+	return ptr->vtbl->getPoseJointCount(instance, pose, joint_count);
+}
+
+Amber_Result amberGetInstanceStats(Amber_Instance instance, Amber_InstanceStats *stats)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (stats == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->getInstanceStats);
+
+	return ptr->vtbl->getInstanceStats(instance, stats);
+}
+
+Amber_Result amberGetSequenceStats(Amber_Instance instance, Amber_Sequence sequence, Amber_SequenceStats *stats)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (stats == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->getSequenceStats);
+
+	return ptr->vtbl->getSequenceStats(instance, sequence, stats);
+}
+
+Amber_Result amberSerializeSequence(Amber_Instance instance, Amber_Sequence sequence, uint64_t *size, void *data)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (size == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->serializeSequence);
+
+	return ptr->vtbl->serializeSequence(instance, sequence, size, data);
+}
+
+Amber_Result amberSerializeStreamingSequence(Amber_Instance instance, Amber_Sequence sequence, float chunk_duration, uint64_t *size, void *data)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (size == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->serializeStreamingSequence);
+
+	return ptr->vtbl->serializeStreamingSequence(instance, sequence, chunk_duration, size, data);
+}
+
+Amber_Result amberSerializeSnapshot(Amber_Instance instance, uint64_t *size, void *data)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (size == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->serializeSnapshot);
+
+	return ptr->vtbl->serializeSnapshot(instance, size, data);
+}
+
 Amber_Result amberSampleRootMotion(Amber_Instance instance, Amber_Sequence sequence, float prev_time, float time, Amber_Transform *dst_transform)
 {
 	if (instance == AMBER_NULL_HANDLE)
@@ -202,6 +557,18 @@ Amber_Result amberSamplePose(Amber_Instance instance, Amber_Sequence sequence, f
 	return ptr->vtbl->samplePose(instance, sequence, time, dst_pose);
 }
 
+Amber_Result amberSamplePoseBatch(Amber_Instance instance, uint32_t count, const Amber_Sequence *sequences, const float *times, const Amber_Pose *dst_poses)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->samplePoseBatch);
+
+	return ptr->vtbl->samplePoseBatch(instance, count, sequences, times, dst_poses);
+}
+
 Amber_Result amberBlendPoses(Amber_Instance instance, uint32_t src_pose_count, const Amber_Pose *src_poses, const float *src_weights, Amber_Pose dst_pose)
 {
 	if (instance == AMBER_NULL_HANDLE)
@@ -214,6 +581,18 @@ Amber_Result amberBlendPoses(Amber_Instance instance, uint32_t src_pose_count, c
 	return ptr->vtbl->blendPoses(instance, src_pose_count, src_poses, src_weights, dst_pose);
 }
 
+Amber_Result amberBlendPoseBatch(Amber_Instance instance, uint32_t count, const Amber_BlendDesc *descs)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->blendPoseBatch);
+
+	return ptr->vtbl->blendPoseBatch(instance, count, descs);
+}
+
 Amber_Result amberComputeAdditivePose(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose src_reference_pose, Amber_Pose dst_pose)
 {
 	if (instance == AMBER_NULL_HANDLE)
@@ -250,6 +629,18 @@ Amber_Result amberConvertToWorldPose(Amber_Instance instance, Amber_Pose src_pos
 	return ptr->vtbl->convertToWorldPose(instance, src_pose, dst_pose);
 }
 
+Amber_Result amberConvertToWorldPoseBatch(Amber_Instance instance, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->convertToWorldPoseBatch);
+
+	return ptr->vtbl->convertToWorldPoseBatch(instance, count, src_poses, dst_poses);
+}
+
 Amber_Result amberConvertToLocalPose(Amber_Instance instance, Amber_Pose src_pose, Amber_Pose dst_pose)
 {
 	if (instance == AMBER_NULL_HANDLE)
@@ -261,3 +652,154 @@ Amber_Result amberConvertToLocalPose(Amber_Instance instance, Amber_Pose src_pos
 
 	return ptr->vtbl->convertToLocalPose(instance, src_pose, dst_pose);
 }
+
+Amber_Result amberConvertToLocalPoseBatch(Amber_Instance instance, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->convertToLocalPoseBatch);
+
+	return ptr->vtbl->convertToLocalPoseBatch(instance, count, src_poses, dst_poses);
+}
+
+Amber_Result amberEvaluateGraph(Amber_Instance instance, Amber_Graph graph, uint32_t parameter_count, const float *parameters, Amber_Pose dst_pose)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->evaluateGraph);
+
+	return ptr->vtbl->evaluateGraph(instance, graph, parameter_count, parameters, dst_pose);
+}
+
+/*
+ */
+Amber_Result amberResolvePose(Amber_Instance instance, Amber_Pose pose, Amber_ResolvedPose *resolved_pose)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (resolved_pose == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->resolvePose);
+
+	return ptr->vtbl->resolvePose(instance, pose, resolved_pose);
+}
+
+Amber_Result amberResolveSequence(Amber_Instance instance, Amber_Sequence sequence, Amber_ResolvedSequence *resolved_sequence)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (resolved_sequence == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->resolveSequence);
+
+	return ptr->vtbl->resolveSequence(instance, sequence, resolved_sequence);
+}
+
+Amber_Result amberGetUncheckedTable(Amber_Instance instance, Amber_UncheckedTable *unchecked_table)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (unchecked_table == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->getUncheckedTable);
+
+	return ptr->vtbl->getUncheckedTable(instance, unchecked_table);
+}
+
+/*
+ */
+Amber_Result amberBeginCapture(Amber_Instance instance, const Amber_CaptureDesc *desc)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->beginCapture);
+
+	return ptr->vtbl->beginCapture(instance, desc);
+}
+
+Amber_Result amberEndCapture(Amber_Instance instance, const char *path)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->endCapture);
+
+	return ptr->vtbl->endCapture(instance, path);
+}
+
+Amber_Result amberGetFenceStatus(Amber_Instance instance, uint64_t fence, uint32_t *complete)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (complete == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->getFenceStatus);
+
+	return ptr->vtbl->getFenceStatus(instance, fence, complete);
+}
+
+Amber_Result amberWaitFence(Amber_Instance instance, uint64_t fence)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->waitFence);
+
+	return ptr->vtbl->waitFence(instance, fence);
+}
+
+Amber_Result amberPrefetchStreamingSequence(Amber_Instance instance, Amber_Sequence sequence, float time, uint64_t *fence)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	if (fence == NULL)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->prefetchStreamingSequence);
+
+	return ptr->vtbl->prefetchStreamingSequence(instance, sequence, time, fence);
+}
+
+Amber_Result amberSetSequenceCacheBudget(Amber_Instance instance, uint64_t budget)
+{
+	if (instance == AMBER_NULL_HANDLE)
+		return AMBER_INVALID_INSTANCE;
+
+	Amber_InstanceInternal *ptr = (Amber_InstanceInternal *)instance;
+	assert(ptr->vtbl);
+	assert(ptr->vtbl->setSequenceCacheBudget);
+
+	return ptr->vtbl->setSequenceCacheBudget(instance, budget);
+}
@@ -5,3 +5,6 @@
 #define AMBER_UNUSED(x) do { (void)(x); } while(0)
 
 Amber_Result impl_createInstance(const Amber_InstanceDesc *desc, Amber_Instance *instance);
+Amber_Result impl_createLibrary(const Amber_LibraryDesc *desc, Amber_Library *library);
+Amber_Result impl_destroyLibrary(Amber_Library library);
+Amber_Result layer_createProfiling(void *user_data, const Amber_AllocationCallbacks *allocation_callbacks, Amber_Instance next_instance, const Amber_InstanceTable *next_table, Amber_Instance *instance);
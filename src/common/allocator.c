@@ -0,0 +1,198 @@
+#include "allocator.h"
+#include "atomics.h"
+#include "intrinsics.h"
+#include "amber_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if defined(AMBER_PLATFORM_WIN32)
+	#include <malloc.h>
+#endif
+
+/*
+ */
+static void *amber_defaultAllocate(void *user_data, uint64_t size, uint32_t alignment, Amber_MemoryCategory category)
+{
+	AMBER_UNUSED(user_data);
+	AMBER_UNUSED(category);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	return _aligned_malloc((size_t)size, alignment);
+#else
+	if (alignment <= AMBER_DEFAULT_ALIGNMENT)
+		return malloc((size_t)size);
+
+	void *memory = NULL;
+	if (posix_memalign(&memory, alignment, (size_t)size) != 0)
+		return NULL;
+
+	return memory;
+#endif
+}
+
+static void *amber_defaultReallocate(void *user_data, void *memory, uint64_t old_size, uint64_t new_size, uint32_t alignment, Amber_MemoryCategory category)
+{
+	AMBER_UNUSED(user_data);
+	AMBER_UNUSED(old_size);
+	AMBER_UNUSED(category);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	return _aligned_realloc(memory, (size_t)new_size, alignment);
+#else
+	if (alignment <= AMBER_DEFAULT_ALIGNMENT)
+		return realloc(memory, (size_t)new_size);
+
+	void *new_memory = amber_defaultAllocate(user_data, new_size, alignment, category);
+	if (new_memory == NULL)
+		return NULL;
+
+	if (memory)
+		memcpy(new_memory, memory, (size_t)((old_size < new_size) ? old_size : new_size));
+
+	free(memory);
+	return new_memory;
+#endif
+}
+
+static void amber_defaultFree(void *user_data, void *memory, uint64_t size, Amber_MemoryCategory category)
+{
+	AMBER_UNUSED(user_data);
+	AMBER_UNUSED(size);
+	AMBER_UNUSED(category);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	_aligned_free(memory);
+#else
+	free(memory);
+#endif
+}
+
+// Note: stats are the only mutable part of an allocator, allocators are passed around as const
+//       pointers everywhere else, so the const is dropped here on purpose
+static AMBER_INLINE Amber_AllocatorStats *amber_allocatorGetMutableStats(const Amber_Allocator *allocator)
+{
+	return (Amber_AllocatorStats *)&allocator->stats;
+}
+
+static AMBER_INLINE void amber_allocatorRecordAllocate(const Amber_Allocator *allocator, uint64_t size, Amber_MemoryCategory category)
+{
+	assert(category < AMBER_MEMORY_CATEGORY_ENUM_MAX);
+
+	Amber_AllocatorStats *stats = amber_allocatorGetMutableStats(allocator);
+	amber_atomicAdd64(&stats->allocated_bytes[category], size);
+	amber_atomicAdd64(&stats->allocation_count, 1);
+	amber_atomicAdd64(&stats->total_allocation_count, 1);
+}
+
+static AMBER_INLINE void amber_allocatorRecordFree(const Amber_Allocator *allocator, uint64_t size, Amber_MemoryCategory category)
+{
+	assert(category < AMBER_MEMORY_CATEGORY_ENUM_MAX);
+
+	Amber_AllocatorStats *stats = amber_allocatorGetMutableStats(allocator);
+	amber_atomicSubtract64(&stats->allocated_bytes[category], size);
+	amber_atomicSubtract64(&stats->allocation_count, 1);
+}
+
+/*
+ */
+Amber_Result amber_allocatorInitialize(Amber_Allocator *allocator, const Amber_AllocationCallbacks *callbacks)
+{
+	assert(allocator);
+
+	memset(allocator, 0, sizeof(Amber_Allocator));
+
+	if (callbacks)
+	{
+		assert(callbacks->allocate);
+		assert(callbacks->free);
+
+		allocator->callbacks = *callbacks;
+		return AMBER_SUCCESS;
+	}
+
+	allocator->callbacks.allocate = amber_defaultAllocate;
+	allocator->callbacks.reallocate = amber_defaultReallocate;
+	allocator->callbacks.free = amber_defaultFree;
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+void *amber_allocatorAllocate(const Amber_Allocator *allocator, uint64_t size, uint32_t alignment, Amber_MemoryCategory category)
+{
+	assert(allocator);
+	assert(allocator->callbacks.allocate);
+	assert(size > 0);
+	assert(isPow2u(alignment));
+
+	const Amber_AllocationCallbacks *callbacks = &allocator->callbacks;
+	void *memory = callbacks->allocate(callbacks->user_data, size, alignment, category);
+
+	if (memory)
+		amber_allocatorRecordAllocate(allocator, size, category);
+
+	return memory;
+}
+
+void *amber_allocatorReallocate(const Amber_Allocator *allocator, void *memory, uint64_t old_size, uint64_t new_size, uint32_t alignment, Amber_MemoryCategory category)
+{
+	assert(allocator);
+	assert(new_size > 0);
+	assert(isPow2u(alignment));
+
+	if (memory == NULL)
+		return amber_allocatorAllocate(allocator, new_size, alignment, category);
+
+	const Amber_AllocationCallbacks *callbacks = &allocator->callbacks;
+
+	if (callbacks->reallocate)
+	{
+		void *new_memory = callbacks->reallocate(callbacks->user_data, memory, old_size, new_size, alignment, category);
+
+		if (new_memory)
+		{
+			amber_allocatorRecordFree(allocator, old_size, category);
+			amber_allocatorRecordAllocate(allocator, new_size, category);
+		}
+
+		return new_memory;
+	}
+
+	void *new_memory = amber_allocatorAllocate(allocator, new_size, alignment, category);
+	if (new_memory == NULL)
+		return NULL;
+
+	memcpy(new_memory, memory, (size_t)((old_size < new_size) ? old_size : new_size));
+	amber_allocatorFree(allocator, memory, old_size, category);
+
+	return new_memory;
+}
+
+void amber_allocatorFree(const Amber_Allocator *allocator, void *memory, uint64_t size, Amber_MemoryCategory category)
+{
+	assert(allocator);
+	assert(allocator->callbacks.free);
+
+	if (memory == NULL)
+		return;
+
+	const Amber_AllocationCallbacks *callbacks = &allocator->callbacks;
+	callbacks->free(callbacks->user_data, memory, size, category);
+
+	amber_allocatorRecordFree(allocator, size, category);
+}
+
+void amber_allocatorGetStats(const Amber_Allocator *allocator, Amber_AllocatorStats *stats)
+{
+	assert(allocator);
+	assert(stats);
+
+	for (uint32_t i = 0; i < AMBER_MEMORY_CATEGORY_ENUM_MAX; ++i)
+		stats->allocated_bytes[i] = amber_atomicLoad64(&allocator->stats.allocated_bytes[i]);
+
+	stats->allocation_count = amber_atomicLoad64(&allocator->stats.allocation_count);
+	stats->total_allocation_count = amber_atomicLoad64(&allocator->stats.total_allocation_count);
+}
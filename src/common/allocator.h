@@ -0,0 +1,28 @@
+#pragma once
+
+#include <amber.h>
+
+#define AMBER_DEFAULT_ALIGNMENT 16
+#define AMBER_SIMD_ALIGNMENT 64
+
+// Note: live bytes per category and allocation counts, updated atomically on every call
+typedef struct Amber_AllocatorStats_t
+{
+	uint64_t allocated_bytes[AMBER_MEMORY_CATEGORY_ENUM_MAX];
+	uint64_t allocation_count;
+	uint64_t total_allocation_count;
+} Amber_AllocatorStats;
+
+typedef struct Amber_Allocator_t
+{
+	Amber_AllocationCallbacks callbacks;
+	Amber_AllocatorStats stats;
+} Amber_Allocator;
+
+Amber_Result amber_allocatorInitialize(Amber_Allocator *allocator, const Amber_AllocationCallbacks *callbacks);
+
+void *amber_allocatorAllocate(const Amber_Allocator *allocator, uint64_t size, uint32_t alignment, Amber_MemoryCategory category);
+void *amber_allocatorReallocate(const Amber_Allocator *allocator, void *memory, uint64_t old_size, uint64_t new_size, uint32_t alignment, Amber_MemoryCategory category);
+void amber_allocatorFree(const Amber_Allocator *allocator, void *memory, uint64_t size, Amber_MemoryCategory category);
+
+void amber_allocatorGetStats(const Amber_Allocator *allocator, Amber_AllocatorStats *stats);
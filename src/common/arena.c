@@ -0,0 +1,112 @@
+#include "arena.h"
+#include "intrinsics.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+static AMBER_INLINE uint32_t amber_arenaGetHeaderSize(void)
+{
+	return alignUp(sizeof(Amber_ArenaBlock), AMBER_SIMD_ALIGNMENT);
+}
+
+static Amber_ArenaBlock *amber_arenaCreateBlock(const Amber_Allocator *allocator, uint32_t size)
+{
+	uint32_t header_size = amber_arenaGetHeaderSize();
+
+	Amber_ArenaBlock *block = (Amber_ArenaBlock *)amber_allocatorAllocate(allocator, header_size + size, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_TRANSIENT);
+	assert(block);
+
+	block->next = NULL;
+	block->size = size;
+	block->offset = 0;
+
+	return block;
+}
+
+static void amber_arenaDestroyBlocks(const Amber_Allocator *allocator, Amber_ArenaBlock *block)
+{
+	uint32_t header_size = amber_arenaGetHeaderSize();
+
+	while (block)
+	{
+		Amber_ArenaBlock *next = block->next;
+		amber_allocatorFree(allocator, block, header_size + block->size, AMBER_MEMORY_CATEGORY_TRANSIENT);
+
+		block = next;
+	}
+}
+
+/*
+ */
+Amber_Result amber_arenaInitialize(Amber_Arena *arena, const Amber_Allocator *allocator, uint32_t block_size)
+{
+	assert(arena);
+	assert(allocator);
+	assert(block_size > 0);
+
+	memset(arena, 0, sizeof(Amber_Arena));
+
+	arena->allocator = allocator;
+	arena->block_size = block_size;
+	arena->total_size = block_size;
+	arena->head = amber_arenaCreateBlock(allocator, block_size);
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_arenaShutdown(Amber_Arena *arena)
+{
+	assert(arena);
+
+	amber_arenaDestroyBlocks(arena->allocator, arena->head);
+	memset(arena, 0, sizeof(Amber_Arena));
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+void *amber_arenaAllocate(Amber_Arena *arena, uint32_t size, uint32_t alignment)
+{
+	assert(arena);
+	assert(arena->head);
+	assert(alignment <= AMBER_SIMD_ALIGNMENT);
+
+	Amber_ArenaBlock *block = arena->head;
+	uint32_t offset = alignUp(block->offset, alignment);
+
+	if (offset + size > block->size)
+	{
+		uint32_t block_size = max(arena->block_size, alignUp(size, AMBER_SIMD_ALIGNMENT));
+
+		block = amber_arenaCreateBlock(arena->allocator, block_size);
+		block->next = arena->head;
+
+		arena->head = block;
+		arena->total_size += block_size;
+
+		offset = 0;
+	}
+
+	block->offset = offset + size;
+	return (uint8_t *)block + amber_arenaGetHeaderSize() + offset;
+}
+
+Amber_Result amber_arenaReset(Amber_Arena *arena)
+{
+	assert(arena);
+	assert(arena->head);
+
+	// Note: if the arena overflowed since the last reset, all blocks are merged into a single one,
+	//       so the steady state is a single block and reset is just a matter of rewinding the offset
+	if (arena->head->next)
+	{
+		amber_arenaDestroyBlocks(arena->allocator, arena->head);
+		arena->head = amber_arenaCreateBlock(arena->allocator, arena->total_size);
+	}
+
+	arena->head->offset = 0;
+	return AMBER_SUCCESS;
+}
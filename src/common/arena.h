@@ -0,0 +1,26 @@
+#pragma once
+
+#include <amber.h>
+
+#include "allocator.h"
+
+typedef struct Amber_ArenaBlock_t
+{
+	struct Amber_ArenaBlock_t *next;
+	uint32_t size;
+	uint32_t offset;
+} Amber_ArenaBlock;
+
+typedef struct Amber_Arena_t
+{
+	const Amber_Allocator *allocator;
+	Amber_ArenaBlock *head;
+	uint32_t block_size;
+	uint32_t total_size;
+} Amber_Arena;
+
+Amber_Result amber_arenaInitialize(Amber_Arena *arena, const Amber_Allocator *allocator, uint32_t block_size);
+Amber_Result amber_arenaShutdown(Amber_Arena *arena);
+
+void *amber_arenaAllocate(Amber_Arena *arena, uint32_t size, uint32_t alignment);
+Amber_Result amber_arenaReset(Amber_Arena *arena);
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <amber.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Note: loads have acquire semantics, stores have release semantics,
+//       read-modify-write operations are sequentially consistent.
+
+typedef uint32_t Amber_SpinLock;
+
+/*
+ */
+static AMBER_INLINE uint32_t amber_atomicLoad32(const volatile uint32_t *ptr)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	uint32_t value = *ptr;
+	_ReadWriteBarrier();
+	return value;
+#elif defined(_MSC_VER)
+	return (uint32_t)_InterlockedOr((volatile long *)ptr, 0);
+#else
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static AMBER_INLINE void amber_atomicStore32(volatile uint32_t *ptr, uint32_t value)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	_ReadWriteBarrier();
+	*ptr = value;
+#elif defined(_MSC_VER)
+	_InterlockedExchange((volatile long *)ptr, (long)value);
+#else
+	__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static AMBER_INLINE uint32_t amber_atomicIncrement32(volatile uint32_t *ptr)
+{
+#ifdef _MSC_VER
+	return (uint32_t)_InterlockedIncrement((volatile long *)ptr);
+#else
+	return __atomic_add_fetch(ptr, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static AMBER_INLINE uint32_t amber_atomicDecrement32(volatile uint32_t *ptr)
+{
+#ifdef _MSC_VER
+	return (uint32_t)_InterlockedDecrement((volatile long *)ptr);
+#else
+	return __atomic_sub_fetch(ptr, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static AMBER_INLINE uint32_t amber_atomicAdd32(volatile uint32_t *ptr, uint32_t value)
+{
+#ifdef _MSC_VER
+	return (uint32_t)_InterlockedExchangeAdd((volatile long *)ptr, (long)value) + value;
+#else
+	return __atomic_add_fetch(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static AMBER_INLINE uint32_t amber_atomicSubtract32(volatile uint32_t *ptr, uint32_t value)
+{
+#ifdef _MSC_VER
+	return (uint32_t)_InterlockedExchangeAdd((volatile long *)ptr, -(long)value) - value;
+#else
+	return __atomic_sub_fetch(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static AMBER_INLINE uint64_t amber_atomicAdd64(volatile uint64_t *ptr, uint64_t value)
+{
+#ifdef _MSC_VER
+	return (uint64_t)_InterlockedExchangeAdd64((volatile __int64 *)ptr, (__int64)value) + value;
+#else
+	return __atomic_add_fetch(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static AMBER_INLINE uint64_t amber_atomicSubtract64(volatile uint64_t *ptr, uint64_t value)
+{
+#ifdef _MSC_VER
+	return (uint64_t)_InterlockedExchangeAdd64((volatile __int64 *)ptr, -(__int64)value) - value;
+#else
+	return __atomic_sub_fetch(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static AMBER_INLINE uint64_t amber_atomicLoad64(const volatile uint64_t *ptr)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	uint64_t value = *ptr;
+	_ReadWriteBarrier();
+	return value;
+#elif defined(_MSC_VER)
+	return (uint64_t)_InterlockedCompareExchange64((volatile __int64 *)ptr, 0, 0);
+#else
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static AMBER_INLINE void amber_atomicStore64(volatile uint64_t *ptr, uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	_ReadWriteBarrier();
+	*ptr = value;
+#elif defined(_MSC_VER)
+	_InterlockedExchange64((volatile __int64 *)ptr, (__int64)value);
+#else
+	__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static AMBER_INLINE uint32_t amber_atomicCompareExchange32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired)
+{
+#ifdef _MSC_VER
+	return (uint32_t)_InterlockedCompareExchange((volatile long *)ptr, (long)desired, (long)expected) == expected;
+#else
+	return __atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static AMBER_INLINE void *amber_atomicLoadPtr(void *const volatile *ptr)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	void *value = *ptr;
+	_ReadWriteBarrier();
+	return value;
+#elif defined(_MSC_VER)
+	return _InterlockedCompareExchangePointer((void *volatile *)ptr, NULL, NULL);
+#else
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static AMBER_INLINE void amber_atomicStorePtr(void *volatile *ptr, void *value)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	_ReadWriteBarrier();
+	*ptr = value;
+#elif defined(_MSC_VER)
+	_InterlockedExchangePointer(ptr, value);
+#else
+	__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static AMBER_INLINE void amber_atomicPause(void)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	_mm_pause();
+#elif defined(_MSC_VER)
+	__yield();
+#elif defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
+/*
+ */
+static AMBER_INLINE void amber_spinLockAcquire(volatile Amber_SpinLock *lock)
+{
+	for (;;)
+	{
+		if (amber_atomicCompareExchange32(lock, 0, 1))
+			return;
+
+		while (amber_atomicLoad32(lock) != 0)
+			amber_atomicPause();
+	}
+}
+
+static AMBER_INLINE void amber_spinLockRelease(volatile Amber_SpinLock *lock)
+{
+	amber_atomicStore32(lock, 0);
+}
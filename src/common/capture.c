@@ -0,0 +1,106 @@
+#include "capture.h"
+#include "intrinsics.h"
+#include "threads.h"
+#include "timer.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#define AMBER_CAPTURE_MAX_EVENT_CAPACITY	(1 << 24)
+
+/*
+ */
+Amber_Result amber_captureInitialize(Amber_Capture *capture, const Amber_Allocator *allocator, uint32_t event_capacity)
+{
+	assert(capture);
+	assert(allocator);
+
+	memset(capture, 0, sizeof(Amber_Capture));
+
+	if (event_capacity == 0)
+		event_capacity = AMBER_CAPTURE_DEFAULT_EVENT_CAPACITY;
+
+	event_capacity = min(event_capacity, AMBER_CAPTURE_MAX_EVENT_CAPACITY);
+
+	if (!isPow2u(event_capacity))
+		event_capacity = 1u << (32 - lzcnt(event_capacity));
+
+	capture->allocator = allocator;
+	capture->capacity = event_capacity;
+	capture->events = (Amber_CaptureEvent *)amber_allocatorAllocate(allocator, sizeof(Amber_CaptureEvent) * event_capacity, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_INSTANCE);
+
+	if (capture->events == NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	capture->start_timestamp = amber_timerGetNanoseconds();
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_captureShutdown(Amber_Capture *capture)
+{
+	assert(capture);
+
+	if (capture->events)
+		amber_allocatorFree(capture->allocator, capture->events, sizeof(Amber_CaptureEvent) * capture->capacity, AMBER_MEMORY_CATEGORY_INSTANCE);
+
+	memset(capture, 0, sizeof(Amber_Capture));
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+void amber_captureRecord(Amber_Capture *capture, const char *name, Amber_CapturePhase phase)
+{
+	assert(capture);
+	assert(capture->events);
+	assert(name);
+
+	uint64_t index = amber_atomicAdd64(&capture->write_count, 1) - 1;
+
+	Amber_CaptureEvent *event = &capture->events[index & (capture->capacity - 1)];
+	event->name = name;
+	event->timestamp = amber_timerGetNanoseconds();
+	event->thread_id = amber_threadGetCurrentId();
+	event->phase = phase;
+}
+
+Amber_Result amber_captureWriteTrace(const Amber_Capture *capture, const char *path)
+{
+	assert(capture);
+	assert(path);
+
+	FILE *file = fopen(path, "wb");
+	if (file == NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	// Note: only the most recent 'capacity' events survive, so the oldest end events
+	//       may lose their begin events, trace viewers simply drop unmatched ones
+	uint64_t count = capture->write_count;
+	uint64_t first = (count > capture->capacity) ? count - capture->capacity : 0;
+
+	fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"amber\"}}");
+
+	for (uint64_t i = first; i < count; ++i)
+	{
+		const Amber_CaptureEvent *event = &capture->events[i & (capture->capacity - 1)];
+
+		uint64_t timestamp = (event->timestamp > capture->start_timestamp) ? event->timestamp - capture->start_timestamp : 0;
+		char phase = (event->phase == AMBER_CAPTURE_PHASE_BEGIN) ? 'B' : 'E';
+
+		// Note: trace timestamps are in microseconds
+		fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"amber\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%llu}",
+			event->name, phase, (double)timestamp / 1000.0, (unsigned long long)event->thread_id);
+	}
+
+	fprintf(file, "\n]}\n");
+
+	int error = ferror(file);
+	if (fclose(file) != 0 || error)
+		return AMBER_INTERNAL_ERROR;
+
+	return AMBER_SUCCESS;
+}
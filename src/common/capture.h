@@ -0,0 +1,39 @@
+#pragma once
+
+#include <amber.h>
+
+#include "allocator.h"
+#include "atomics.h"
+
+#define AMBER_CAPTURE_DEFAULT_EVENT_CAPACITY	65536
+
+typedef enum Amber_CapturePhase_t
+{
+	AMBER_CAPTURE_PHASE_BEGIN = 0,
+	AMBER_CAPTURE_PHASE_END,
+} Amber_CapturePhase;
+
+typedef struct Amber_CaptureEvent_t
+{
+	const char *name;
+	uint64_t timestamp;
+	uint64_t thread_id;
+	Amber_CapturePhase phase;
+} Amber_CaptureEvent;
+
+// Note: writers claim slots with a single atomic increment and never wait for each other,
+//       events are only read back once recording has stopped and no writer is in flight.
+typedef struct Amber_Capture_t
+{
+	const Amber_Allocator *allocator;
+	Amber_CaptureEvent *events;
+	uint32_t capacity;
+	uint64_t start_timestamp;
+	uint64_t write_count;
+} Amber_Capture;
+
+Amber_Result amber_captureInitialize(Amber_Capture *capture, const Amber_Allocator *allocator, uint32_t event_capacity);
+Amber_Result amber_captureShutdown(Amber_Capture *capture);
+
+void amber_captureRecord(Amber_Capture *capture, const char *name, Amber_CapturePhase phase);
+Amber_Result amber_captureWriteTrace(const Amber_Capture *capture, const char *path);
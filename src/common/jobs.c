@@ -0,0 +1,61 @@
+#include "jobs.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+Amber_Result amber_jobSystemInitialize(Amber_JobSystem *jobs, const Amber_Allocator *allocator, const Amber_JobCallbacks *callbacks, uint32_t thread_count)
+{
+	assert(jobs);
+	assert(allocator);
+
+	memset(jobs, 0, sizeof(Amber_JobSystem));
+
+	if (callbacks)
+	{
+		assert(callbacks->parallel_for);
+		assert(callbacks->wait);
+
+		jobs->callbacks = *callbacks;
+		return AMBER_SUCCESS;
+	}
+
+	if (thread_count == 0)
+		thread_count = amber_getHardwareThreadCount();
+
+	// Note: the calling thread always takes part in the work, so it is not counted as a worker
+	return amber_threadPoolInitialize(&jobs->thread_pool, allocator, thread_count - 1);
+}
+
+Amber_Result amber_jobSystemShutdown(Amber_JobSystem *jobs)
+{
+	assert(jobs);
+
+	if (jobs->callbacks.parallel_for == NULL)
+		amber_threadPoolShutdown(&jobs->thread_pool);
+
+	memset(jobs, 0, sizeof(Amber_JobSystem));
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+void amber_jobSystemParallelFor(Amber_JobSystem *jobs, uint32_t count, uint32_t granularity, PFN_amberJobFunction function, void *job_data)
+{
+	assert(jobs);
+	assert(function);
+
+	if (count == 0)
+		return;
+
+	if (jobs->callbacks.parallel_for == NULL)
+	{
+		amber_threadPoolParallelFor(&jobs->thread_pool, count, granularity, function, job_data);
+		return;
+	}
+
+	uint64_t job = jobs->callbacks.parallel_for(jobs->callbacks.user_data, count, granularity, function, job_data);
+	jobs->callbacks.wait(jobs->callbacks.user_data, job);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <amber.h>
+
+#include "allocator.h"
+#include "thread_pool.h"
+
+// Note: dispatches parallel work to user job callbacks if provided, otherwise to the built-in thread pool.
+typedef struct Amber_JobSystem_t
+{
+	Amber_JobCallbacks callbacks;
+	Amber_ThreadPool thread_pool;
+} Amber_JobSystem;
+
+Amber_Result amber_jobSystemInitialize(Amber_JobSystem *jobs, const Amber_Allocator *allocator, const Amber_JobCallbacks *callbacks, uint32_t thread_count);
+Amber_Result amber_jobSystemShutdown(Amber_JobSystem *jobs);
+
+void amber_jobSystemParallelFor(Amber_JobSystem *jobs, uint32_t count, uint32_t granularity, PFN_amberJobFunction function, void *job_data);
@@ -0,0 +1,135 @@
+#include "loader.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+static void amber_loaderMain(void *data)
+{
+	Amber_Loader *loader = (Amber_Loader *)data;
+	assert(loader);
+
+	amber_mutexLock(&loader->mutex);
+
+	for (;;)
+	{
+		while (!loader->quit && loader->head == NULL)
+			amber_conditionWait(&loader->condition, &loader->mutex);
+
+		Amber_LoaderTask *task = loader->head;
+		if (task == NULL)
+			break;
+
+		loader->head = task->next;
+		if (loader->head == NULL)
+			loader->tail = NULL;
+
+		amber_mutexUnlock(&loader->mutex);
+
+		// Note: the task may be released by its own function, so the fence is read beforehand
+		uint64_t fence = task->fence;
+		task->function(task->data);
+
+		amber_mutexLock(&loader->mutex);
+
+		amber_atomicStore64(&loader->completed_fence, fence);
+		amber_conditionNotifyAll(&loader->condition);
+	}
+
+	amber_mutexUnlock(&loader->mutex);
+}
+
+/*
+ */
+Amber_Result amber_loaderInitialize(Amber_Loader *loader)
+{
+	assert(loader);
+
+	memset(loader, 0, sizeof(Amber_Loader));
+
+	amber_mutexInitialize(&loader->mutex);
+	amber_conditionInitialize(&loader->condition);
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_loaderShutdown(Amber_Loader *loader)
+{
+	assert(loader);
+
+	amber_mutexLock(&loader->mutex);
+	loader->quit = 1;
+	amber_conditionNotifyAll(&loader->condition);
+	amber_mutexUnlock(&loader->mutex);
+
+	if (loader->started)
+		amber_threadJoin(&loader->thread);
+
+	assert(loader->head == NULL);
+
+	amber_conditionShutdown(&loader->condition);
+	amber_mutexShutdown(&loader->mutex);
+
+	memset(loader, 0, sizeof(Amber_Loader));
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+uint64_t amber_loaderSubmit(Amber_Loader *loader, Amber_LoaderTask *task)
+{
+	assert(loader);
+	assert(task);
+	assert(task->function);
+
+	amber_mutexLock(&loader->mutex);
+
+	if (!loader->started && amber_threadCreate(&loader->thread, amber_loaderMain, loader) == AMBER_SUCCESS)
+		loader->started = 1;
+
+	uint64_t fence = ++loader->submitted_fence;
+	task->fence = fence;
+	task->next = NULL;
+
+	// Note: without a thread earlier tasks have completed already, the task runs under the lock
+	//       so fences still complete in submission order
+	if (!loader->started)
+	{
+		task->function(task->data);
+
+		amber_atomicStore64(&loader->completed_fence, fence);
+		amber_mutexUnlock(&loader->mutex);
+
+		return fence;
+	}
+
+	if (loader->tail)
+		loader->tail->next = task;
+	else
+		loader->head = task;
+
+	loader->tail = task;
+
+	amber_conditionNotifyAll(&loader->condition);
+	amber_mutexUnlock(&loader->mutex);
+
+	return fence;
+}
+
+void amber_loaderWait(Amber_Loader *loader, uint64_t fence)
+{
+	assert(loader);
+
+	if (amber_loaderIsComplete(loader, fence))
+		return;
+
+	amber_mutexLock(&loader->mutex);
+	assert(fence <= loader->submitted_fence);
+
+	while (loader->completed_fence < fence)
+		amber_conditionWait(&loader->condition, &loader->mutex);
+
+	amber_mutexUnlock(&loader->mutex);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <amber.h>
+
+#include "atomics.h"
+#include "threads.h"
+
+typedef void (*PFN_amberLoaderFunction)(void *data);
+
+// Note: tasks are embedded in caller owned memory, which may be released by the task function itself
+typedef struct Amber_LoaderTask_t
+{
+	PFN_amberLoaderFunction function;
+	void *data;
+	uint64_t fence;
+	struct Amber_LoaderTask_t *next;
+} Amber_LoaderTask;
+
+// Note: runs tasks one by one in submission order on a single background thread, so a fence is
+//       complete once every task submitted up to and including it has finished. The thread is
+//       started on the first submission, if it can't be started tasks run on the submitting thread.
+//       Shutdown finishes all pending tasks before returning.
+typedef struct Amber_Loader_t
+{
+	Amber_Thread thread;
+	uint32_t started;
+	uint32_t quit;
+
+	Amber_LoaderTask *head;
+	Amber_LoaderTask *tail;
+	uint64_t submitted_fence;
+	uint64_t completed_fence;
+
+	Amber_Mutex mutex;
+	Amber_Condition condition;
+} Amber_Loader;
+
+Amber_Result amber_loaderInitialize(Amber_Loader *loader);
+Amber_Result amber_loaderShutdown(Amber_Loader *loader);
+
+uint64_t amber_loaderSubmit(Amber_Loader *loader, Amber_LoaderTask *task);
+void amber_loaderWait(Amber_Loader *loader, uint64_t fence);
+
+static AMBER_INLINE uint32_t amber_loaderIsComplete(const Amber_Loader *loader, uint64_t fence)
+{
+	return amber_atomicLoad64(&loader->completed_fence) >= fence;
+}
@@ -1,7 +1,6 @@
 #include "pool.h"
 #include "intrinsics.h"
 
-#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
@@ -24,108 +23,197 @@ static AMBER_INLINE uint8_t amber_poolHandleGetGeneration(Amber_PoolHandle handl
 
 /*
  */
-static AMBER_INLINE uint32_t amber_poolGrabIndex(Amber_Pool *pool)
+static AMBER_INLINE Amber_PoolPage *amber_poolGetPage(const Amber_Pool *pool, uint32_t index)
 {
 	assert(pool);
-	assert(pool->num_free_indices > 0);
+	assert(index < pool->capacity);
 
-	uint32_t index = pool->indices[pool->num_free_indices - 1];
-	pool->num_free_indices--;
+	return pool->table->pages[index >> AMBER_POOL_PAGE_SHIFT];
+}
 
-	uint32_t mask_index = index / 32;
-	uint32_t mask_bit = index % 32;
+static AMBER_INLINE uint32_t amber_poolGetPageSize(const Amber_Pool *pool)
+{
+	assert(pool);
 
-	pool->masks[mask_index] &= ~(1 << mask_bit);
+	uint32_t size = alignUp(sizeof(Amber_PoolPage), AMBER_DEFAULT_ALIGNMENT);
+	size += alignUp(pool->element_size * AMBER_POOL_PAGE_ELEMENTS, AMBER_DEFAULT_ALIGNMENT);
+	size += sizeof(void *) * AMBER_POOL_PAGE_ELEMENTS;
+	size += sizeof(Amber_PoolHandle) * AMBER_POOL_PAGE_ELEMENTS;
+	size += sizeof(uint32_t) * AMBER_POOL_PAGE_ELEMENTS;
+	size += sizeof(uint32_t) * AMBER_POOL_PAGE_ELEMENTS;
 
-	return index;
+	return size;
+}
+
+static AMBER_INLINE uint32_t amber_poolGetPageTableSize(uint32_t max_pages)
+{
+	return alignUp(sizeof(Amber_PoolPageTable), AMBER_DEFAULT_ALIGNMENT) + sizeof(Amber_PoolPage *) * max_pages;
 }
 
-static AMBER_INLINE void amber_poolReleaseIndex(Amber_Pool *pool, uint32_t index)
+static Amber_PoolPageTable *amber_poolCreatePageTable(Amber_Pool *pool, uint32_t max_pages)
 {
 	assert(pool);
-	assert(pool->num_free_indices < pool->capacity);
-	assert(index < pool->capacity);
+	assert(max_pages > 0);
+
+	uint8_t *memory = (uint8_t *)amber_allocatorAllocate(pool->allocator, amber_poolGetPageTableSize(max_pages), AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_POOL);
+	assert(memory);
+
+	Amber_PoolPageTable *table = (Amber_PoolPageTable *)memory;
+	table->retired = pool->table;
+	table->pages = (Amber_PoolPage **)(memory + alignUp(sizeof(Amber_PoolPageTable), AMBER_DEFAULT_ALIGNMENT));
+	table->max_pages = max_pages;
 
-	pool->num_free_indices++;
-	pool->indices[pool->num_free_indices - 1] = index;
+	memset(table->pages, 0, sizeof(Amber_PoolPage *) * max_pages);
 
-	uint32_t mask_index = index / 32;
-	uint32_t mask_bit = index % 32;
+	if (pool->table)
+		memcpy(table->pages, pool->table->pages, sizeof(Amber_PoolPage *) * pool->num_pages);
 
-	pool->masks[mask_index] |= 1 << mask_bit;
+	return table;
 }
 
-static AMBER_INLINE uint32_t amber_poolIsIndexFree(const Amber_Pool *pool, uint32_t index)
+static void amber_poolAddPage(Amber_Pool *pool)
 {
 	assert(pool);
-	assert(index < pool->capacity);
+	assert(pool->capacity + AMBER_POOL_PAGE_ELEMENTS - 1 <= AMBER_POOL_MAX_ELEMENTS);
+
+	AMBER_PROFILER_ZONE_BEGIN(pool->profiler, "amberPoolGrow");
+
+	uint8_t *memory = (uint8_t *)amber_allocatorAllocate(pool->allocator, amber_poolGetPageSize(pool), AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_POOL);
+	assert(memory);
 
-	uint32_t mask_index = index / 32;
-	uint32_t mask_bit = index % 32;
+	Amber_PoolPage *page = (Amber_PoolPage *)memory;
+	memory += alignUp(sizeof(Amber_PoolPage), AMBER_DEFAULT_ALIGNMENT);
+
+	page->data = memory;
+	memory += alignUp(pool->element_size * AMBER_POOL_PAGE_ELEMENTS, AMBER_DEFAULT_ALIGNMENT);
+
+	page->dense_elements = (void **)memory;
+	memory += sizeof(void *) * AMBER_POOL_PAGE_ELEMENTS;
+
+	page->dense_handles = (Amber_PoolHandle *)memory;
+	memory += sizeof(Amber_PoolHandle) * AMBER_POOL_PAGE_ELEMENTS;
+
+	page->sparse = (uint32_t *)memory;
+	memory += sizeof(uint32_t) * AMBER_POOL_PAGE_ELEMENTS;
+
+	page->states = (uint32_t *)memory;
+
+	// Note: capacity only grows, so the new dense positions are exactly the new indices
+	uint32_t first = pool->num_pages << AMBER_POOL_PAGE_SHIFT;
+
+	for (uint32_t i = 0; i < AMBER_POOL_PAGE_ELEMENTS; ++i)
+	{
+		page->dense_elements[i] = page->data + i * pool->element_size;
+		page->dense_handles[i] = amber_poolHandlePack(first + i, 0);
+		page->sparse[i] = first + i;
+		page->states[i] = 0;
+	}
+
+	// Note: only the page table is ever reallocated, elements themselves are never copied
+	Amber_PoolPageTable *table = pool->table;
+
+	if (table == NULL || pool->num_pages == table->max_pages)
+	{
+		uint32_t new_max_pages = (table == NULL) ? 4 : table->max_pages * 2;
+		table = amber_poolCreatePageTable(pool, new_max_pages);
+	}
 
-	uint32_t free_mask = pool->masks[mask_index];
-	uint32_t element_mask = 1 << mask_bit;
+	table->pages[pool->num_pages] = page;
+	pool->num_pages++;
 
-	return free_mask & element_mask;
+	// Note: the table is published before the capacity, so readers that pass
+	//       the capacity check always observe a table containing the page
+	amber_atomicStorePtr((void *volatile *)&pool->table, table);
+	amber_atomicStore32(&pool->capacity, pool->capacity + AMBER_POOL_PAGE_ELEMENTS);
+
+	AMBER_PROFILER_ZONE_END(pool->profiler, "amberPoolGrow");
 }
 
-static AMBER_INLINE uint32_t amber_poolGetNumMasks(const Amber_Pool *pool)
+static AMBER_INLINE void amber_poolSwapDense(Amber_Pool *pool, uint32_t position_a, uint32_t position_b)
 {
 	assert(pool);
+	assert(position_a < pool->capacity);
+	assert(position_b < pool->capacity);
+
+	if (position_a == position_b)
+		return;
+
+	Amber_PoolPage *page_a = amber_poolGetPage(pool, position_a);
+	Amber_PoolPage *page_b = amber_poolGetPage(pool, position_b);
+
+	uint32_t element_a = position_a & AMBER_POOL_PAGE_MASK;
+	uint32_t element_b = position_b & AMBER_POOL_PAGE_MASK;
+
+	Amber_PoolHandle handle_a = page_a->dense_handles[element_a];
+	Amber_PoolHandle handle_b = page_b->dense_handles[element_b];
+
+	void *data_a = page_a->dense_elements[element_a];
+	void *data_b = page_b->dense_elements[element_b];
+
+	page_a->dense_handles[element_a] = handle_b;
+	page_a->dense_elements[element_a] = data_b;
 
-	return alignUp(pool->capacity, 32) / 32;
+	page_b->dense_handles[element_b] = handle_a;
+	page_b->dense_elements[element_b] = data_a;
+
+	uint32_t index_a = amber_poolHandleGetIndex(handle_a);
+	uint32_t index_b = amber_poolHandleGetIndex(handle_b);
+
+	amber_poolGetPage(pool, index_a)->sparse[index_a & AMBER_POOL_PAGE_MASK] = position_b;
+	amber_poolGetPage(pool, index_b)->sparse[index_b & AMBER_POOL_PAGE_MASK] = position_a;
 }
 
 /*
  */
-Amber_Result amber_poolInitialize(Amber_Pool *pool, uint32_t element_size, uint32_t capacity)
+Amber_Result amber_poolInitialize(Amber_Pool *pool, const Amber_Allocator *allocator, const Amber_Profiler *profiler, uint32_t element_size, uint32_t capacity)
 {
 	assert(pool);
+	assert(allocator);
 	assert(element_size > 0);
 
 	memset(pool, 0, sizeof(Amber_Pool));
 
+	pool->allocator = allocator;
+	pool->profiler = profiler;
 	pool->element_size = element_size;
-	pool->capacity = capacity;
-	pool->num_free_indices = capacity;
-	pool->head = AMBER_POOL_HANDLE_NULL;
-	pool->tail = AMBER_POOL_HANDLE_NULL;
 
-	if (capacity > 0)
+	return amber_poolReserve(pool, capacity);
+}
+
+Amber_Result amber_poolShutdown(Amber_Pool *pool)
+{
+	assert(pool);
+
+	uint32_t page_size = amber_poolGetPageSize(pool);
+	Amber_PoolPageTable *table = pool->table;
+
+	for (uint32_t i = 0; i < pool->num_pages; ++i)
+		amber_allocatorFree(pool->allocator, table->pages[i], page_size, AMBER_MEMORY_CATEGORY_POOL);
+
+	while (table)
 	{
-		uint32_t num_masks = amber_poolGetNumMasks(pool);
-
-		pool->data = (uint8_t *)malloc(element_size * capacity);
-		pool->generations = (uint8_t *)malloc(sizeof(uint8_t) * capacity);
-		pool->nexts = (uint32_t *)malloc(sizeof(uint32_t) * capacity);
-		pool->prevs = (uint32_t *)malloc(sizeof(uint32_t) * capacity);
-		pool->indices = (uint32_t *)malloc(sizeof(uint32_t) * capacity);
-		pool->masks = (uint32_t *)malloc(sizeof(uint32_t) * num_masks);
-
-		for (uint32_t i = 0; i < capacity; ++i)
-			pool->indices[i] = capacity - i - 1;
-
-		memset(pool->nexts, AMBER_POOL_HANDLE_NULL, sizeof(uint32_t) * capacity);
-		memset(pool->prevs, AMBER_POOL_HANDLE_NULL, sizeof(uint32_t) * capacity);
-		memset(pool->masks, 0xFFFFFFFF, sizeof(uint32_t) * num_masks);
-		memset(pool->generations, 0, sizeof(uint8_t) * capacity);
+		Amber_PoolPageTable *retired = table->retired;
+		amber_allocatorFree(pool->allocator, table, amber_poolGetPageTableSize(table->max_pages), AMBER_MEMORY_CATEGORY_POOL);
+
+		table = retired;
 	}
 
+	memset(pool, 0, sizeof(Amber_Pool));
+
 	return AMBER_SUCCESS;
 }
 
-Amber_Result amber_poolShutdown(Amber_Pool *pool)
+Amber_Result amber_poolReserve(Amber_Pool *pool, uint32_t capacity)
 {
 	assert(pool);
+	assert(capacity <= AMBER_POOL_MAX_ELEMENTS);
 
-	free(pool->data);
-	free(pool->generations);
-	free(pool->nexts);
-	free(pool->prevs);
-	free(pool->indices);
-	free(pool->masks);
+	amber_spinLockAcquire(&pool->lock);
 
-	memset(pool, 0, sizeof(Amber_Pool));
+	while (pool->capacity < capacity)
+		amber_poolAddPage(pool);
+
+	amber_spinLockRelease(&pool->lock);
 
 	return AMBER_SUCCESS;
 }
@@ -137,115 +225,126 @@ Amber_PoolHandle amber_poolAddElement(Amber_Pool *pool, const void *data)
 	assert(pool);
 	assert(data);
 
+	amber_spinLockAcquire(&pool->lock);
+
 	if (pool->size == pool->capacity)
-	{
-		uint32_t old_capacity = pool->capacity;
-		uint32_t old_num_masks = amber_poolGetNumMasks(pool);
-
-		pool->capacity = (pool->capacity == 0) ? 1 : pool->capacity * 2;
-		uint32_t new_num_masks = amber_poolGetNumMasks(pool);
-
-		pool->data = (uint8_t *)realloc(pool->data, pool->element_size * pool->capacity);
-		pool->generations = (uint8_t *)realloc(pool->generations, sizeof(uint8_t) * pool->capacity);
-		pool->nexts = (uint32_t *)realloc(pool->nexts, sizeof(uint32_t) * pool->capacity);
-		pool->prevs = (uint32_t *)realloc(pool->prevs, sizeof(uint32_t) * pool->capacity);
-		pool->indices = (uint32_t *)realloc(pool->indices, sizeof(uint32_t) * pool->capacity);
-
-		if (old_num_masks != new_num_masks)
-			pool->masks = (uint32_t *)realloc(pool->masks, sizeof(uint32_t) * new_num_masks);
-
-		for (uint32_t i = old_capacity; i < pool->capacity; ++i)
-		{
-			pool->num_free_indices++;
-			pool->indices[pool->num_free_indices - 1] = old_capacity + pool->capacity - i - 1;
-			pool->generations[i] = 0;
-			pool->nexts[i] = AMBER_POOL_HANDLE_NULL;
-			pool->prevs[i] = AMBER_POOL_HANDLE_NULL;
-		}
-
-		for (uint32_t i = old_num_masks; i < new_num_masks; ++i)
-			pool->masks[i] = 0xFFFFFFFF;
-	}
+		amber_poolAddPage(pool);
 
-	assert(pool->num_free_indices > 0);
+	uint32_t position = pool->size;
+	Amber_PoolPage *dense_page = amber_poolGetPage(pool, position);
+	uint32_t dense_element = position & AMBER_POOL_PAGE_MASK;
 
-	uint32_t index = amber_poolGrabIndex(pool);
+	uint32_t index = amber_poolHandleGetIndex(dense_page->dense_handles[dense_element]);
+	uint32_t element = index & AMBER_POOL_PAGE_MASK;
 
-	uint8_t *data_ptr = pool->data + index * pool->element_size;
-	uint8_t *generation_ptr = pool->generations + index;
+	Amber_PoolPage *page = amber_poolGetPage(pool, index);
+	uint8_t *data_ptr = page->data + element * pool->element_size;
 
-	if (pool->head == AMBER_POOL_HANDLE_NULL)
-		pool->head = index;
+	memcpy(data_ptr, data, pool->element_size);
 
-	if (pool->tail == AMBER_POOL_HANDLE_NULL)
-	{
-		pool->tail = index;
-	}
-	else
-	{
-		pool->nexts[pool->tail] = index;
-		pool->prevs[index] = pool->tail;
+	uint8_t generation = (uint8_t)(page->states[element] & AMBER_POOL_MAX_GENERATIONS) + 1;
+	generation = (uint8_t)max(1, generation);
 
-		pool->tail = index;
-	}
+	Amber_PoolHandle handle = amber_poolHandlePack(index, generation);
+	dense_page->dense_handles[dense_element] = handle;
 
-	memcpy(data_ptr, data, pool->element_size);
+	pool->size++;
 
-	uint8_t generation = *generation_ptr + 1;
-	*generation_ptr = max(1, generation);
+	// Note: the element becomes visible to lock-free lookups only after its data is written
+	amber_atomicStore32(&page->states[element], generation | AMBER_POOL_STATE_ALIVE);
 
-	pool->size++;
+	amber_spinLockRelease(&pool->lock);
 
-	return amber_poolHandlePack(index, *generation_ptr);
+	return handle;
 }
 
-Amber_Result amber_poolRemoveElement(Amber_Pool *pool, Amber_PoolHandle handle)
+// Note: claims the exact index and generation of 'handle' (e.g. when restoring a snapshot), fails if the index is in use
+Amber_Result amber_poolInsertElement(Amber_Pool *pool, Amber_PoolHandle handle, const void *data)
 {
 	assert(pool);
+	assert(data);
 
 	if (handle == AMBER_POOL_HANDLE_NULL)
 		return AMBER_INTERNAL_ERROR;
 
-	if (pool->size == 0)
-		return AMBER_INTERNAL_ERROR;
-
 	uint32_t index = amber_poolHandleGetIndex(handle);
 	uint8_t generation = amber_poolHandleGetGeneration(handle);
 
-	if (pool->generations[index] != generation)
+	if (index >= AMBER_POOL_MAX_ELEMENTS || generation == 0)
 		return AMBER_INTERNAL_ERROR;
 
-	if (amber_poolIsIndexFree(pool, index))
+	amber_spinLockAcquire(&pool->lock);
+
+	while (pool->capacity <= index)
+		amber_poolAddPage(pool);
+
+	uint32_t element = index & AMBER_POOL_PAGE_MASK;
+	Amber_PoolPage *page = amber_poolGetPage(pool, index);
+
+	if (page->states[element] & AMBER_POOL_STATE_ALIVE)
+	{
+		amber_spinLockRelease(&pool->lock);
 		return AMBER_INTERNAL_ERROR;
+	}
+
+	// Note: the free index is moved right past the last live position, then claimed as in amber_poolAddElement
+	uint32_t position = pool->size;
+	amber_poolSwapDense(pool, page->sparse[element], position);
 
-	uint32_t prev = pool->prevs[index];
-	uint32_t next = pool->nexts[index];
+	memcpy(page->data + element * pool->element_size, data, pool->element_size);
 
-	pool->prevs[index] = AMBER_POOL_HANDLE_NULL;
-	pool->nexts[index] = AMBER_POOL_HANDLE_NULL;
+	amber_poolGetPage(pool, position)->dense_handles[position & AMBER_POOL_PAGE_MASK] = handle;
 
-	if (next != AMBER_POOL_HANDLE_NULL)
-		pool->prevs[next] = prev;
+	pool->size++;
 
-	if (prev != AMBER_POOL_HANDLE_NULL)
-		pool->nexts[prev] = next;
+	amber_atomicStore32(&page->states[element], generation | AMBER_POOL_STATE_ALIVE);
 
-	if (pool->head == index)
-		pool->head = next;
+	amber_spinLockRelease(&pool->lock);
 
-	if (pool->tail == index)
-		pool->tail = prev;
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_poolRemoveElement(Amber_Pool *pool, Amber_PoolHandle handle)
+{
+	assert(pool);
 
-	amber_poolReleaseIndex(pool, index);
+	if (handle == AMBER_POOL_HANDLE_NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	uint32_t index = amber_poolHandleGetIndex(handle);
+	uint8_t generation = amber_poolHandleGetGeneration(handle);
+
+	amber_spinLockAcquire(&pool->lock);
+
+	if (index >= pool->capacity)
+	{
+		amber_spinLockRelease(&pool->lock);
+		return AMBER_INTERNAL_ERROR;
+	}
+
+	uint32_t element = index & AMBER_POOL_PAGE_MASK;
+	Amber_PoolPage *page = amber_poolGetPage(pool, index);
+
+	if (page->states[element] != (generation | AMBER_POOL_STATE_ALIVE))
+	{
+		amber_spinLockRelease(&pool->lock);
+		return AMBER_INTERNAL_ERROR;
+	}
+
+	amber_atomicStore32(&page->states[element], generation);
+
+	// Note: swap-remove, the freed index ends up right past the last live position
+	amber_poolSwapDense(pool, page->sparse[element], pool->size - 1);
 	pool->size--;
 
+	amber_spinLockRelease(&pool->lock);
+
 	return AMBER_SUCCESS;
 }
 
 void *amber_poolGetElement(const Amber_Pool *pool, Amber_PoolHandle handle)
 {
 	assert(pool);
-	assert(pool->size > 0);
 
 	if (handle == AMBER_POOL_HANDLE_NULL)
 		return NULL;
@@ -253,53 +352,52 @@ void *amber_poolGetElement(const Amber_Pool *pool, Amber_PoolHandle handle)
 	uint32_t index = amber_poolHandleGetIndex(handle);
 	uint8_t generation = amber_poolHandleGetGeneration(handle);
 
-	if (pool->generations[index] != generation)
+	if (index >= amber_atomicLoad32(&pool->capacity))
 		return NULL;
 
-	if (amber_poolIsIndexFree(pool, index))
+	const Amber_PoolPageTable *table = (const Amber_PoolPageTable *)amber_atomicLoadPtr((void *const volatile *)&pool->table);
+	const Amber_PoolPage *page = table->pages[index >> AMBER_POOL_PAGE_SHIFT];
+
+	uint32_t element = index & AMBER_POOL_PAGE_MASK;
+
+	if (amber_atomicLoad32(&page->states[element]) != (generation | AMBER_POOL_STATE_ALIVE))
 		return NULL;
 
-	return pool->data + index * pool->element_size;
+	return page->data + element * pool->element_size;
 }
 
-void *amber_poolGetElementByIndex(const Amber_Pool *pool, uint32_t index)
+/*
+ */
+void amber_poolLock(Amber_Pool *pool)
 {
 	assert(pool);
-	assert(pool->size > 0);
-	assert(pool->capacity > index);
-	assert(index != AMBER_POOL_HANDLE_NULL);
-
-	return pool->data + index * pool->element_size;
+	amber_spinLockAcquire(&pool->lock);
 }
 
-uint32_t amber_poolGetHeadIndex(const Amber_Pool *pool)
+void amber_poolUnlock(Amber_Pool *pool)
 {
 	assert(pool);
-	return pool->head;
+	amber_spinLockRelease(&pool->lock);
 }
 
-uint32_t amber_poolGetTailIndex(const Amber_Pool *pool)
+uint32_t amber_poolGetSize(const Amber_Pool *pool)
 {
 	assert(pool);
-	return pool->tail;
+	return pool->size;
 }
 
-uint32_t amber_poolGetNextIndex(const Amber_Pool *pool, uint32_t index)
+Amber_PoolHandle amber_poolGetDenseHandle(const Amber_Pool *pool, uint32_t position)
 {
 	assert(pool);
-	assert(pool->size > 0);
-	assert(pool->capacity > index);
-	assert(index != AMBER_POOL_HANDLE_NULL);
-	
-	return pool->nexts[index];
+	assert(position < pool->size);
+
+	return amber_poolGetPage(pool, position)->dense_handles[position & AMBER_POOL_PAGE_MASK];
 }
 
-uint32_t amber_poolGetPrevIndex(const Amber_Pool *pool, uint32_t index)
+void *amber_poolGetDenseElement(const Amber_Pool *pool, uint32_t position)
 {
 	assert(pool);
-	assert(pool->size > 0);
-	assert(pool->capacity > index);
-	assert(index != AMBER_POOL_HANDLE_NULL);
-	
-	return pool->prevs[index];
+	assert(position < pool->size);
+
+	return amber_poolGetPage(pool, position)->dense_elements[position & AMBER_POOL_PAGE_MASK];
 }
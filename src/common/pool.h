@@ -2,39 +2,76 @@
 
 #include <amber.h>
 
+#include "allocator.h"
+#include "atomics.h"
+#include "profiler.h"
+
 #define AMBER_POOL_MAX_ELEMENTS		0x00FFFFFF
 #define AMBER_POOL_MAX_GENERATIONS	0xFF
 #define AMBER_POOL_HANDLE_NULL		0xFFFFFFFF
+#define AMBER_POOL_STATE_ALIVE		0x100
+
+#define AMBER_POOL_PAGE_SHIFT		8
+#define AMBER_POOL_PAGE_ELEMENTS	(1 << AMBER_POOL_PAGE_SHIFT)
+#define AMBER_POOL_PAGE_MASK		(AMBER_POOL_PAGE_ELEMENTS - 1)
 
 typedef uint32_t Amber_PoolHandle;
 
-typedef struct Amber_Pool_t
+typedef struct Amber_PoolPage_t
 {
 	uint8_t *data;
-	uint8_t *generations;
-	uint32_t *nexts;
-	uint32_t *prevs;
-	uint32_t head;
-	uint32_t tail;
+	void **dense_elements;
+	Amber_PoolHandle *dense_handles;
+	uint32_t *sparse;
+	uint32_t *states;
+} Amber_PoolPage;
+
+// Note: page tables are never freed while the pool is alive, lock-free readers may still hold
+//       a pointer to an older table, so replaced tables are chained through 'retired'.
+typedef struct Amber_PoolPageTable_t
+{
+	struct Amber_PoolPageTable_t *retired;
+	Amber_PoolPage **pages;
+	uint32_t max_pages;
+} Amber_PoolPageTable;
+
+// Note: elements are stored in fixed size pages which are never moved or reallocated,
+//       so element addresses stay stable for the whole lifetime of the element.
+//
+//       Live elements are also tracked in a dense array (sparse set), positions [0, size)
+//       hold live handles & element pointers, positions [size, capacity) hold free indices.
+//       Removal swaps the last live entry into the hole, so dense order is not stable.
+//
+//       Handle lookups are lock-free and may run concurrently with add / remove / reserve,
+//       which are serialized by an internal spin lock. Dense iteration is only safe while
+//       holding the lock or when no other thread mutates the pool.
+typedef struct Amber_Pool_t
+{
+	const Amber_Allocator *allocator;
+	const Amber_Profiler *profiler;
+
+	Amber_PoolPageTable *table;
+	uint32_t num_pages;
 
 	uint32_t element_size;
 	uint32_t size;
 	uint32_t capacity;
 
-	uint32_t *masks;
-	uint32_t *indices;
-	uint32_t num_free_indices;
+	Amber_SpinLock lock;
 } Amber_Pool;
 
-Amber_Result amber_poolInitialize(Amber_Pool *pool, uint32_t element_size, uint32_t capacity);
+Amber_Result amber_poolInitialize(Amber_Pool *pool, const Amber_Allocator *allocator, const Amber_Profiler *profiler, uint32_t element_size, uint32_t capacity);
 Amber_Result amber_poolShutdown(Amber_Pool *pool);
+Amber_Result amber_poolReserve(Amber_Pool *pool, uint32_t capacity);
 
 Amber_PoolHandle amber_poolAddElement(Amber_Pool *pool, const void *data);
+Amber_Result amber_poolInsertElement(Amber_Pool *pool, Amber_PoolHandle handle, const void *data);
 Amber_Result amber_poolRemoveElement(Amber_Pool *pool, Amber_PoolHandle handle);
 void *amber_poolGetElement(const Amber_Pool *pool, Amber_PoolHandle handle);
 
-void *amber_poolGetElementByIndex(const Amber_Pool *pool, uint32_t index);
-uint32_t amber_poolGetHeadIndex(const Amber_Pool *pool);
-uint32_t amber_poolGetTailIndex(const Amber_Pool *pool);
-uint32_t amber_poolGetNextIndex(const Amber_Pool *pool, uint32_t index);
-uint32_t amber_poolGetPrevIndex(const Amber_Pool *pool, uint32_t index);
\ No newline at end of file
+void amber_poolLock(Amber_Pool *pool);
+void amber_poolUnlock(Amber_Pool *pool);
+
+uint32_t amber_poolGetSize(const Amber_Pool *pool);
+Amber_PoolHandle amber_poolGetDenseHandle(const Amber_Pool *pool, uint32_t position);
+void *amber_poolGetDenseElement(const Amber_Pool *pool, uint32_t position);
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "profiler.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+Amber_Result amber_profilerInitialize(Amber_Profiler *profiler, const Amber_ProfilerCallbacks *callbacks)
+{
+	assert(profiler);
+
+	memset(profiler, 0, sizeof(Amber_Profiler));
+
+	if (callbacks)
+	{
+		// Note: zones are always emitted in pairs, so both callbacks are required
+		assert(callbacks->begin_zone);
+		assert(callbacks->end_zone);
+
+		profiler->callbacks = *callbacks;
+	}
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_profilerShutdown(Amber_Profiler *profiler)
+{
+	assert(profiler);
+
+	memset(profiler, 0, sizeof(Amber_Profiler));
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+Amber_Result amber_profilerBeginCapture(Amber_Profiler *profiler, Amber_Capture *capture)
+{
+	assert(profiler);
+	assert(capture);
+
+	if (amber_atomicLoadPtr((void *const volatile *)&profiler->capture) != NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	// Note: the capture is published before zones are allowed to record into it
+	amber_atomicStorePtr((void *volatile *)&profiler->capture, capture);
+	amber_atomicAdd32(&profiler->capture_state, AMBER_PROFILER_CAPTURE_ACTIVE);
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Capture *amber_profilerEndCapture(Amber_Profiler *profiler)
+{
+	assert(profiler);
+
+	Amber_Capture *capture = (Amber_Capture *)amber_atomicLoadPtr((void *const volatile *)&profiler->capture);
+	if (capture == NULL)
+		return NULL;
+
+	// Note: zones registering after the bit is cleared never touch the capture, and since they see
+	//       the pointer cleared first, the count drains even while other threads keep running zones
+	amber_atomicStorePtr((void *volatile *)&profiler->capture, NULL);
+	amber_atomicSubtract32(&profiler->capture_state, AMBER_PROFILER_CAPTURE_ACTIVE);
+
+	while (amber_atomicLoad32(&profiler->capture_state) != 0)
+		amber_atomicPause();
+
+	return capture;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <amber.h>
+
+#include "atomics.h"
+#include "capture.h"
+
+#include <stddef.h>
+
+// Note: zone macros expand to nothing unless the library is built with AMBER_PROFILE_ZONES,
+//       otherwise a zone costs a couple of branches when neither callbacks nor a capture are set.
+//       The active capture is swapped atomically, zones running on other threads see it appear or
+//       disappear between two events. Zones that record into it are counted in 'capture_state',
+//       whose top bit is set while the capture is active, so ending it can wait for them to leave.
+#define AMBER_PROFILER_CAPTURE_ACTIVE 0x80000000
+
+typedef struct Amber_Profiler_t
+{
+	Amber_ProfilerCallbacks callbacks;
+	Amber_Capture *capture;
+	uint32_t capture_state;
+} Amber_Profiler;
+
+Amber_Result amber_profilerInitialize(Amber_Profiler *profiler, const Amber_ProfilerCallbacks *callbacks);
+Amber_Result amber_profilerShutdown(Amber_Profiler *profiler);
+
+Amber_Result amber_profilerBeginCapture(Amber_Profiler *profiler, Amber_Capture *capture);
+Amber_Capture *amber_profilerEndCapture(Amber_Profiler *profiler);
+
+/*
+ */
+static AMBER_INLINE void amber_profilerRecord(const Amber_Profiler *profiler, const char *name, Amber_CapturePhase phase)
+{
+	if (amber_atomicLoadPtr((void *const volatile *)&profiler->capture) == NULL)
+		return;
+
+	// Note: the capture is loaded again once registered, the one seen above may already be gone
+	volatile uint32_t *state = (volatile uint32_t *)&profiler->capture_state;
+
+	if (amber_atomicIncrement32(state) & AMBER_PROFILER_CAPTURE_ACTIVE)
+	{
+		Amber_Capture *capture = (Amber_Capture *)amber_atomicLoadPtr((void *const volatile *)&profiler->capture);
+		if (capture)
+			amber_captureRecord(capture, name, phase);
+	}
+
+	amber_atomicDecrement32(state);
+}
+
+static AMBER_INLINE void amber_profilerBeginZone(const Amber_Profiler *profiler, const char *name)
+{
+	if (profiler == NULL)
+		return;
+
+	if (profiler->callbacks.begin_zone)
+		profiler->callbacks.begin_zone(profiler->callbacks.user_data, name);
+
+	amber_profilerRecord(profiler, name, AMBER_CAPTURE_PHASE_BEGIN);
+}
+
+static AMBER_INLINE void amber_profilerEndZone(const Amber_Profiler *profiler, const char *name)
+{
+	if (profiler == NULL)
+		return;
+
+	amber_profilerRecord(profiler, name, AMBER_CAPTURE_PHASE_END);
+
+	if (profiler->callbacks.end_zone)
+		profiler->callbacks.end_zone(profiler->callbacks.user_data, name);
+}
+
+/*
+ */
+#if defined(AMBER_PROFILE_ZONES)
+	#define AMBER_PROFILER_ZONE_BEGIN(profiler, name) amber_profilerBeginZone((profiler), (name))
+	#define AMBER_PROFILER_ZONE_END(profiler, name) amber_profilerEndZone((profiler), (name))
+#else
+	#define AMBER_PROFILER_ZONE_BEGIN(profiler, name) ((void)0)
+	#define AMBER_PROFILER_ZONE_END(profiler, name) ((void)0)
+#endif
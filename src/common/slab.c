@@ -0,0 +1,120 @@
+#include "slab.h"
+#include "intrinsics.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+static AMBER_INLINE uint32_t amber_slabGetHeaderSize(void)
+{
+	return alignUp(sizeof(Amber_SlabChunk), AMBER_SIMD_ALIGNMENT);
+}
+
+static AMBER_INLINE uint64_t amber_slabGetChunkSize(const Amber_Slab *slab)
+{
+	assert(slab);
+
+	return amber_slabGetHeaderSize() + (uint64_t)slab->stride * slab->chunk_capacity;
+}
+
+static void amber_slabAddChunk(Amber_Slab *slab)
+{
+	assert(slab);
+
+	Amber_SlabChunk *chunk = (Amber_SlabChunk *)amber_allocatorAllocate(slab->allocator, amber_slabGetChunkSize(slab), AMBER_SIMD_ALIGNMENT, slab->category);
+	assert(chunk);
+
+	chunk->next = slab->chunks;
+	slab->chunks = chunk;
+
+	// Note: link slots in reverse, so they are handed out in address order
+	uint8_t *slots = (uint8_t *)chunk + amber_slabGetHeaderSize();
+
+	for (uint32_t i = slab->chunk_capacity; i > 0; --i)
+	{
+		void *slot = slots + (i - 1) * slab->stride;
+		*(void **)slot = slab->free_head;
+		slab->free_head = slot;
+	}
+
+	slab->capacity += slab->chunk_capacity;
+}
+
+/*
+ */
+Amber_Result amber_slabInitialize(Amber_Slab *slab, const Amber_Allocator *allocator, uint32_t stride, uint32_t chunk_capacity, Amber_MemoryCategory category)
+{
+	assert(slab);
+	assert(allocator);
+	assert(stride >= sizeof(void *));
+	assert(isAlignedu(stride, AMBER_SIMD_ALIGNMENT));
+	assert(chunk_capacity > 0);
+
+	memset(slab, 0, sizeof(Amber_Slab));
+
+	slab->allocator = allocator;
+	slab->stride = stride;
+	slab->chunk_capacity = chunk_capacity;
+	slab->category = category;
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_slabShutdown(Amber_Slab *slab)
+{
+	assert(slab);
+
+	uint64_t chunk_size = amber_slabGetChunkSize(slab);
+	Amber_SlabChunk *chunk = slab->chunks;
+
+	while (chunk)
+	{
+		Amber_SlabChunk *next = chunk->next;
+		amber_allocatorFree(slab->allocator, chunk, chunk_size, slab->category);
+
+		chunk = next;
+	}
+
+	memset(slab, 0, sizeof(Amber_Slab));
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+void *amber_slabAllocate(Amber_Slab *slab)
+{
+	assert(slab);
+
+	amber_spinLockAcquire(&slab->lock);
+
+	if (slab->free_head == NULL)
+		amber_slabAddChunk(slab);
+
+	void *slot = slab->free_head;
+	slab->free_head = *(void **)slot;
+	slab->size++;
+
+	amber_spinLockRelease(&slab->lock);
+
+	return slot;
+}
+
+void amber_slabFree(Amber_Slab *slab, void *memory)
+{
+	assert(slab);
+
+	if (memory == NULL)
+		return;
+
+	amber_spinLockAcquire(&slab->lock);
+
+	assert(slab->size > 0);
+
+	*(void **)memory = slab->free_head;
+	slab->free_head = memory;
+	slab->size--;
+
+	amber_spinLockRelease(&slab->lock);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <amber.h>
+
+#include "allocator.h"
+#include "atomics.h"
+
+typedef struct Amber_SlabChunk_t
+{
+	struct Amber_SlabChunk_t *next;
+} Amber_SlabChunk;
+
+// Note: fixed stride allocator, slots are carved out of chunks of 'chunk_capacity' slots.
+//       Chunks are never moved, freed slots are linked through their own memory.
+//       Allocate and free are serialized with a spin lock.
+typedef struct Amber_Slab_t
+{
+	const Amber_Allocator *allocator;
+	Amber_SlabChunk *chunks;
+	void *free_head;
+	uint32_t stride;
+	uint32_t chunk_capacity;
+	uint32_t size;
+	uint32_t capacity;
+	Amber_MemoryCategory category;
+	Amber_SpinLock lock;
+} Amber_Slab;
+
+Amber_Result amber_slabInitialize(Amber_Slab *slab, const Amber_Allocator *allocator, uint32_t stride, uint32_t chunk_capacity, Amber_MemoryCategory category);
+Amber_Result amber_slabShutdown(Amber_Slab *slab);
+
+void *amber_slabAllocate(Amber_Slab *slab);
+void amber_slabFree(Amber_Slab *slab, void *memory);
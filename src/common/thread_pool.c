@@ -0,0 +1,363 @@
+#include "thread_pool.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+static AMBER_INLINE uint32_t amber_threadPoolNextRandom(uint32_t *seed)
+{
+	assert(seed);
+
+	// Note: xorshift32, only used to pick steal victims
+	uint32_t value = *seed;
+	value ^= value << 13;
+	value ^= value >> 17;
+	value ^= value << 5;
+
+	*seed = value;
+	return value;
+}
+
+static AMBER_INLINE uint32_t amber_threadPoolGetDequeCount(const Amber_ThreadPool *pool)
+{
+	assert(pool);
+	return pool->worker_count + 1;
+}
+
+static AMBER_INLINE Amber_ThreadPoolDeque *amber_threadPoolGetSharedDeque(const Amber_ThreadPool *pool)
+{
+	assert(pool);
+	return &pool->deques[pool->worker_count];
+}
+
+/*
+ */
+static uint32_t amber_threadPoolPush(Amber_ThreadPool *pool, Amber_ThreadPoolDeque *deque, const Amber_ThreadPoolTask *task)
+{
+	assert(pool);
+	assert(deque);
+	assert(task);
+
+	amber_spinLockAcquire(&deque->lock);
+
+	if (deque->bottom - deque->top == AMBER_THREAD_POOL_DEQUE_CAPACITY)
+	{
+		amber_spinLockRelease(&deque->lock);
+		return 0;
+	}
+
+	deque->tasks[deque->bottom & AMBER_THREAD_POOL_DEQUE_MASK] = *task;
+	amber_atomicStore32(&deque->bottom, deque->bottom + 1);
+
+	amber_spinLockRelease(&deque->lock);
+
+	amber_atomicIncrement32(&pool->task_count);
+
+	if (amber_atomicLoad32(&pool->sleeping_count) > 0)
+	{
+		amber_mutexLock(&pool->mutex);
+		amber_conditionNotifyOne(&pool->condition);
+		amber_mutexUnlock(&pool->mutex);
+	}
+
+	return 1;
+}
+
+static uint32_t amber_threadPoolPop(Amber_ThreadPool *pool, Amber_ThreadPoolDeque *deque, Amber_ThreadPoolTask *task)
+{
+	assert(pool);
+	assert(deque);
+	assert(task);
+
+	if (amber_atomicLoad32(&deque->bottom) == amber_atomicLoad32(&deque->top))
+		return 0;
+
+	amber_spinLockAcquire(&deque->lock);
+
+	if (deque->bottom == deque->top)
+	{
+		amber_spinLockRelease(&deque->lock);
+		return 0;
+	}
+
+	amber_atomicStore32(&deque->bottom, deque->bottom - 1);
+	*task = deque->tasks[deque->bottom & AMBER_THREAD_POOL_DEQUE_MASK];
+
+	amber_spinLockRelease(&deque->lock);
+
+	amber_atomicDecrement32(&pool->task_count);
+	return 1;
+}
+
+static uint32_t amber_threadPoolStealFrom(Amber_ThreadPool *pool, Amber_ThreadPoolDeque *deque, Amber_ThreadPoolTask *task)
+{
+	assert(pool);
+	assert(deque);
+	assert(task);
+
+	if (amber_atomicLoad32(&deque->bottom) == amber_atomicLoad32(&deque->top))
+		return 0;
+
+	amber_spinLockAcquire(&deque->lock);
+
+	if (deque->bottom == deque->top)
+	{
+		amber_spinLockRelease(&deque->lock);
+		return 0;
+	}
+
+	*task = deque->tasks[deque->top & AMBER_THREAD_POOL_DEQUE_MASK];
+	amber_atomicStore32(&deque->top, deque->top + 1);
+
+	amber_spinLockRelease(&deque->lock);
+
+	amber_atomicDecrement32(&pool->task_count);
+	return 1;
+}
+
+static uint32_t amber_threadPoolSteal(Amber_ThreadPool *pool, uint32_t thief_index, uint32_t *seed, Amber_ThreadPoolTask *task)
+{
+	assert(pool);
+	assert(seed);
+	assert(task);
+
+	uint32_t deque_count = amber_threadPoolGetDequeCount(pool);
+	uint32_t first = amber_threadPoolNextRandom(seed) % deque_count;
+
+	for (uint32_t i = 0; i < deque_count; ++i)
+	{
+		uint32_t victim = (first + i) % deque_count;
+
+		if (victim == thief_index)
+			continue;
+
+		if (amber_threadPoolStealFrom(pool, &pool->deques[victim], task))
+			return 1;
+	}
+
+	return 0;
+}
+
+/*
+ */
+static void amber_threadPoolExecute(Amber_ThreadPool *pool, Amber_ThreadPoolDeque *deque, Amber_ThreadPoolTask task)
+{
+	assert(pool);
+	assert(deque);
+
+	Amber_ThreadPoolJob *job = task.job;
+	assert(job);
+
+	// Note: keep the lower half and expose the upper half to thieves, if the deque is full
+	//       the remaining range is simply processed here
+	while (task.end - task.begin > job->granularity)
+	{
+		Amber_ThreadPoolTask upper = task;
+		upper.begin = task.begin + (task.end - task.begin) / 2;
+
+		if (!amber_threadPoolPush(pool, deque, &upper))
+			break;
+
+		task.end = upper.begin;
+	}
+
+	job->function(job->job_data, task.begin, task.end);
+
+	// Note: this is the last access to the job, its owner may return as soon as 'remaining' reaches zero
+	amber_atomicSubtract32(&job->remaining, task.end - task.begin);
+}
+
+static void amber_threadPoolWorkerMain(void *data)
+{
+	Amber_ThreadPoolWorker *worker = (Amber_ThreadPoolWorker *)data;
+	assert(worker);
+
+	Amber_ThreadPool *pool = worker->pool;
+	assert(pool);
+
+	Amber_ThreadPoolDeque *deque = &pool->deques[worker->index];
+	uint32_t idle_count = 0;
+
+	for (;;)
+	{
+		Amber_ThreadPoolTask task;
+
+		if (amber_threadPoolPop(pool, deque, &task) || amber_threadPoolSteal(pool, worker->index, &worker->seed, &task))
+		{
+			amber_threadPoolExecute(pool, deque, task);
+			idle_count = 0;
+			continue;
+		}
+
+		if (++idle_count < AMBER_THREAD_POOL_SPIN_COUNT)
+		{
+			amber_atomicPause();
+			continue;
+		}
+
+		idle_count = 0;
+
+		// Note: pushers check 'sleeping_count' after publishing a task, sleepers check 'task_count'
+		//       after announcing themselves, so a wakeup is never lost
+		amber_mutexLock(&pool->mutex);
+		amber_atomicIncrement32(&pool->sleeping_count);
+
+		while (!pool->quit && amber_atomicLoad32(&pool->task_count) == 0)
+			amber_conditionWait(&pool->condition, &pool->mutex);
+
+		amber_atomicDecrement32(&pool->sleeping_count);
+		uint32_t quit = pool->quit;
+
+		amber_mutexUnlock(&pool->mutex);
+
+		if (quit)
+			break;
+	}
+}
+
+static void amber_threadPoolStart(Amber_ThreadPool *pool)
+{
+	assert(pool);
+
+	amber_mutexLock(&pool->mutex);
+
+	if (pool->started)
+	{
+		amber_mutexUnlock(&pool->mutex);
+		return;
+	}
+
+	uint32_t deque_count = amber_threadPoolGetDequeCount(pool);
+
+	pool->deques = (Amber_ThreadPoolDeque *)amber_allocatorAllocate(pool->allocator, sizeof(Amber_ThreadPoolDeque) * deque_count, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_INSTANCE);
+	assert(pool->deques);
+
+	memset(pool->deques, 0, sizeof(Amber_ThreadPoolDeque) * deque_count);
+
+	pool->workers = (Amber_ThreadPoolWorker *)amber_allocatorAllocate(pool->allocator, sizeof(Amber_ThreadPoolWorker) * pool->worker_count, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_INSTANCE);
+	assert(pool->workers);
+
+	// Note: if thread creation fails, the pool keeps working with the workers started so far,
+	//       deques of missing workers simply stay empty
+	for (uint32_t i = 0; i < pool->worker_count; ++i)
+	{
+		Amber_ThreadPoolWorker *worker = &pool->workers[i];
+		worker->pool = pool;
+		worker->index = i;
+		worker->seed = 0x9E3779B9u * (i + 1);
+
+		if (amber_threadCreate(&worker->thread, amber_threadPoolWorkerMain, worker) != AMBER_SUCCESS)
+			break;
+
+		pool->started_count++;
+	}
+
+	amber_atomicStore32(&pool->started, 1);
+
+	amber_mutexUnlock(&pool->mutex);
+}
+
+/*
+ */
+Amber_Result amber_threadPoolInitialize(Amber_ThreadPool *pool, const Amber_Allocator *allocator, uint32_t worker_count)
+{
+	assert(pool);
+	assert(allocator);
+
+	memset(pool, 0, sizeof(Amber_ThreadPool));
+
+	pool->allocator = allocator;
+	pool->worker_count = worker_count;
+
+	amber_mutexInitialize(&pool->mutex);
+	amber_conditionInitialize(&pool->condition);
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_threadPoolShutdown(Amber_ThreadPool *pool)
+{
+	assert(pool);
+
+	amber_mutexLock(&pool->mutex);
+	pool->quit = 1;
+	amber_conditionNotifyAll(&pool->condition);
+	amber_mutexUnlock(&pool->mutex);
+
+	for (uint32_t i = 0; i < pool->started_count; ++i)
+		amber_threadJoin(&pool->workers[i].thread);
+
+	if (pool->workers)
+		amber_allocatorFree(pool->allocator, pool->workers, sizeof(Amber_ThreadPoolWorker) * pool->worker_count, AMBER_MEMORY_CATEGORY_INSTANCE);
+
+	if (pool->deques)
+		amber_allocatorFree(pool->allocator, pool->deques, sizeof(Amber_ThreadPoolDeque) * amber_threadPoolGetDequeCount(pool), AMBER_MEMORY_CATEGORY_INSTANCE);
+
+	amber_conditionShutdown(&pool->condition);
+	amber_mutexShutdown(&pool->mutex);
+
+	memset(pool, 0, sizeof(Amber_ThreadPool));
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+void amber_threadPoolParallelFor(Amber_ThreadPool *pool, uint32_t count, uint32_t granularity, PFN_amberJobFunction function, void *job_data)
+{
+	assert(pool);
+	assert(function);
+
+	if (count == 0)
+		return;
+
+	if (granularity == 0)
+		granularity = 1;
+
+	if (pool->worker_count == 0 || count <= granularity)
+	{
+		function(job_data, 0, count);
+		return;
+	}
+
+	if (!amber_atomicLoad32(&pool->started))
+		amber_threadPoolStart(pool);
+
+	Amber_ThreadPoolJob job;
+	job.function = function;
+	job.job_data = job_data;
+	job.granularity = granularity;
+	job.remaining = count;
+
+	Amber_ThreadPoolTask task;
+	task.job = &job;
+	task.begin = 0;
+	task.end = count;
+
+	// Note: callers from outside the pool share one deque, the calling thread keeps
+	//       running tasks (possibly of other jobs) until its own job is complete
+	uint32_t shared_index = pool->worker_count;
+	Amber_ThreadPoolDeque *deque = amber_threadPoolGetSharedDeque(pool);
+	uint32_t seed = (uint32_t)(uintptr_t)&job | 1;
+
+	uint32_t idle_count = 0;
+
+	amber_threadPoolExecute(pool, deque, task);
+
+	while (amber_atomicLoad32(&job.remaining) > 0)
+	{
+		if (amber_threadPoolPop(pool, deque, &task) || amber_threadPoolSteal(pool, shared_index, &seed, &task))
+		{
+			amber_threadPoolExecute(pool, deque, task);
+			idle_count = 0;
+			continue;
+		}
+
+		// Note: the last ranges are being processed by workers
+		if (++idle_count < AMBER_THREAD_POOL_SPIN_COUNT)
+			amber_atomicPause();
+		else
+			amber_threadYield();
+	}
+}
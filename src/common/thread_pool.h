@@ -0,0 +1,72 @@
+#pragma once
+
+#include <amber.h>
+
+#include "allocator.h"
+#include "atomics.h"
+#include "threads.h"
+
+#define AMBER_THREAD_POOL_DEQUE_CAPACITY	256
+#define AMBER_THREAD_POOL_DEQUE_MASK		(AMBER_THREAD_POOL_DEQUE_CAPACITY - 1)
+#define AMBER_THREAD_POOL_SPIN_COUNT		64
+
+typedef struct Amber_ThreadPool_t Amber_ThreadPool;
+
+typedef struct Amber_ThreadPoolJob_t
+{
+	PFN_amberJobFunction function;
+	void *job_data;
+	uint32_t granularity;
+	uint32_t remaining;
+} Amber_ThreadPoolJob;
+
+typedef struct Amber_ThreadPoolTask_t
+{
+	Amber_ThreadPoolJob *job;
+	uint32_t begin;
+	uint32_t end;
+} Amber_ThreadPoolTask;
+
+// Note: the owner pushes and pops at the bottom, thieves steal from the top
+typedef struct Amber_ThreadPoolDeque_t
+{
+	Amber_SpinLock lock;
+	uint32_t top;
+	uint32_t bottom;
+	Amber_ThreadPoolTask tasks[AMBER_THREAD_POOL_DEQUE_CAPACITY];
+} Amber_ThreadPoolDeque;
+
+typedef struct Amber_ThreadPoolWorker_t
+{
+	Amber_Thread thread;
+	Amber_ThreadPool *pool;
+	uint32_t index;
+	uint32_t seed;
+} Amber_ThreadPoolWorker;
+
+// Note: every worker owns a deque, threads outside the pool share one extra deque.
+//       A task larger than the job granularity is split in halves, the upper half is pushed
+//       to the local deque where idle workers can steal it, so work spreads without a central queue.
+//       Jobs live on the stack of the thread calling amber_threadPoolParallelFor, which keeps running
+//       tasks until every item of its job is processed. Workers are started lazily on the first job.
+struct Amber_ThreadPool_t
+{
+	const Amber_Allocator *allocator;
+	Amber_ThreadPoolWorker *workers;
+	Amber_ThreadPoolDeque *deques;
+	uint32_t worker_count;
+	uint32_t started_count;
+	uint32_t started;
+
+	uint32_t task_count;
+	uint32_t sleeping_count;
+	uint32_t quit;
+
+	Amber_Mutex mutex;
+	Amber_Condition condition;
+};
+
+Amber_Result amber_threadPoolInitialize(Amber_ThreadPool *pool, const Amber_Allocator *allocator, uint32_t worker_count);
+Amber_Result amber_threadPoolShutdown(Amber_ThreadPool *pool);
+
+void amber_threadPoolParallelFor(Amber_ThreadPool *pool, uint32_t count, uint32_t granularity, PFN_amberJobFunction function, void *job_data);
@@ -0,0 +1,208 @@
+#include "threads.h"
+
+#include <assert.h>
+
+#if !defined(AMBER_PLATFORM_WIN32)
+	#include <sched.h>
+	#include <unistd.h>
+#endif
+
+/*
+ */
+#if defined(AMBER_PLATFORM_WIN32)
+static DWORD WINAPI amber_threadEntry(LPVOID data)
+{
+	Amber_Thread *thread = (Amber_Thread *)data;
+	thread->function(thread->data);
+
+	return 0;
+}
+#else
+static void *amber_threadEntry(void *data)
+{
+	Amber_Thread *thread = (Amber_Thread *)data;
+	thread->function(thread->data);
+
+	return NULL;
+}
+#endif
+
+/*
+ */
+Amber_Result amber_threadCreate(Amber_Thread *thread, PFN_amberThreadFunction function, void *data)
+{
+	assert(thread);
+	assert(function);
+
+	thread->function = function;
+	thread->data = data;
+
+#if defined(AMBER_PLATFORM_WIN32)
+	thread->handle = CreateThread(NULL, 0, amber_threadEntry, thread, 0, NULL);
+	if (thread->handle == NULL)
+		return AMBER_INTERNAL_ERROR;
+#else
+	if (pthread_create(&thread->handle, NULL, amber_threadEntry, thread) != 0)
+		return AMBER_INTERNAL_ERROR;
+#endif
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_threadJoin(Amber_Thread *thread)
+{
+	assert(thread);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+
+	return AMBER_SUCCESS;
+}
+
+void amber_threadYield(void)
+{
+#if defined(AMBER_PLATFORM_WIN32)
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
+uint64_t amber_threadGetCurrentId(void)
+{
+#if defined(AMBER_PLATFORM_WIN32)
+	return (uint64_t)GetCurrentThreadId();
+#else
+	// Note: pthread_t is opaque, it is only used as a unique value while the thread is alive
+	return (uint64_t)(uintptr_t)pthread_self();
+#endif
+}
+
+uint32_t amber_getHardwareThreadCount(void)
+{
+#if defined(AMBER_PLATFORM_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+
+	return (info.dwNumberOfProcessors > 0) ? (uint32_t)info.dwNumberOfProcessors : 1;
+#elif defined(AMBER_PLATFORM_WEB)
+	// Note: threads are not available unless the module is built with shared memory support
+	return 1;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (count > 0) ? (uint32_t)count : 1;
+#endif
+}
+
+/*
+ */
+Amber_Result amber_mutexInitialize(Amber_Mutex *mutex)
+{
+	assert(mutex);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	InitializeSRWLock(mutex);
+#else
+	pthread_mutex_init(mutex, NULL);
+#endif
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_mutexShutdown(Amber_Mutex *mutex)
+{
+	assert(mutex);
+
+#if !defined(AMBER_PLATFORM_WIN32)
+	pthread_mutex_destroy(mutex);
+#endif
+
+	return AMBER_SUCCESS;
+}
+
+void amber_mutexLock(Amber_Mutex *mutex)
+{
+	assert(mutex);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	AcquireSRWLockExclusive(mutex);
+#else
+	pthread_mutex_lock(mutex);
+#endif
+}
+
+void amber_mutexUnlock(Amber_Mutex *mutex)
+{
+	assert(mutex);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	ReleaseSRWLockExclusive(mutex);
+#else
+	pthread_mutex_unlock(mutex);
+#endif
+}
+
+/*
+ */
+Amber_Result amber_conditionInitialize(Amber_Condition *condition)
+{
+	assert(condition);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	InitializeConditionVariable(condition);
+#else
+	pthread_cond_init(condition, NULL);
+#endif
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result amber_conditionShutdown(Amber_Condition *condition)
+{
+	assert(condition);
+
+#if !defined(AMBER_PLATFORM_WIN32)
+	pthread_cond_destroy(condition);
+#endif
+
+	return AMBER_SUCCESS;
+}
+
+void amber_conditionWait(Amber_Condition *condition, Amber_Mutex *mutex)
+{
+	assert(condition);
+	assert(mutex);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	SleepConditionVariableSRW(condition, mutex, INFINITE, 0);
+#else
+	pthread_cond_wait(condition, mutex);
+#endif
+}
+
+void amber_conditionNotifyOne(Amber_Condition *condition)
+{
+	assert(condition);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	WakeConditionVariable(condition);
+#else
+	pthread_cond_signal(condition);
+#endif
+}
+
+void amber_conditionNotifyAll(Amber_Condition *condition)
+{
+	assert(condition);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	WakeAllConditionVariable(condition);
+#else
+	pthread_cond_broadcast(condition);
+#endif
+}
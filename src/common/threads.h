@@ -0,0 +1,48 @@
+#pragma once
+
+#include <amber.h>
+
+#if defined(AMBER_PLATFORM_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+typedef void (*PFN_amberThreadFunction)(void *data);
+
+#if defined(AMBER_PLATFORM_WIN32)
+typedef HANDLE Amber_ThreadHandle;
+typedef SRWLOCK Amber_Mutex;
+typedef CONDITION_VARIABLE Amber_Condition;
+#else
+typedef pthread_t Amber_ThreadHandle;
+typedef pthread_mutex_t Amber_Mutex;
+typedef pthread_cond_t Amber_Condition;
+#endif
+
+// Note: the thread entry point receives a pointer to this struct, so it must not move while the thread runs.
+typedef struct Amber_Thread_t
+{
+	Amber_ThreadHandle handle;
+	PFN_amberThreadFunction function;
+	void *data;
+} Amber_Thread;
+
+Amber_Result amber_threadCreate(Amber_Thread *thread, PFN_amberThreadFunction function, void *data);
+Amber_Result amber_threadJoin(Amber_Thread *thread);
+void amber_threadYield(void);
+uint64_t amber_threadGetCurrentId(void);
+
+uint32_t amber_getHardwareThreadCount(void);
+
+Amber_Result amber_mutexInitialize(Amber_Mutex *mutex);
+Amber_Result amber_mutexShutdown(Amber_Mutex *mutex);
+void amber_mutexLock(Amber_Mutex *mutex);
+void amber_mutexUnlock(Amber_Mutex *mutex);
+
+Amber_Result amber_conditionInitialize(Amber_Condition *condition);
+Amber_Result amber_conditionShutdown(Amber_Condition *condition);
+void amber_conditionWait(Amber_Condition *condition, Amber_Mutex *mutex);
+void amber_conditionNotifyOne(Amber_Condition *condition);
+void amber_conditionNotifyAll(Amber_Condition *condition);
@@ -0,0 +1,32 @@
+#include "timer.h"
+
+#if defined(AMBER_PLATFORM_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+/*
+ */
+uint64_t amber_timerGetNanoseconds(void)
+{
+#if defined(AMBER_PLATFORM_WIN32)
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+
+	// Note: split into whole seconds and remainder to avoid overflowing the multiplication
+	uint64_t ticks = (uint64_t)counter.QuadPart;
+	uint64_t ticks_per_second = (uint64_t)frequency.QuadPart;
+
+	return (ticks / ticks_per_second) * 1000000000ull + ((ticks % ticks_per_second) * 1000000000ull) / ticks_per_second;
+#else
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+#endif
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <amber.h>
+
+// Note: monotonic clock, only differences between two timestamps are meaningful
+uint64_t amber_timerGetNanoseconds(void);
@@ -0,0 +1,136 @@
+#include "impl_internal.h"
+
+#include <assert.h>
+
+// Note: items are whole poses, so a range of items maps to a range of characters
+#define IMPL_BATCH_GRANULARITY 16
+
+/*
+ */
+typedef struct Impl_SampleBatch_t
+{
+	Amber_Instance instance;
+	const Amber_Sequence *sequences;
+	const float *times;
+	const Amber_Pose *dst_poses;
+} Impl_SampleBatch;
+
+typedef struct Impl_BlendBatch_t
+{
+	Amber_Instance instance;
+	const Amber_BlendDesc *descs;
+} Impl_BlendBatch;
+
+typedef struct Impl_ConvertBatch_t
+{
+	Amber_Instance instance;
+	const Amber_Pose *src_poses;
+	const Amber_Pose *dst_poses;
+} Impl_ConvertBatch;
+
+/*
+ */
+static void impl_sampleBatchJob(void *job_data, uint32_t begin, uint32_t end)
+{
+	const Impl_SampleBatch *batch = (const Impl_SampleBatch *)job_data;
+	assert(batch);
+
+	for (uint32_t i = begin; i < end; ++i)
+		impl_instanceSamplePose(batch->instance, batch->sequences[i], batch->times[i], batch->dst_poses[i]);
+}
+
+static void impl_blendBatchJob(void *job_data, uint32_t begin, uint32_t end)
+{
+	const Impl_BlendBatch *batch = (const Impl_BlendBatch *)job_data;
+	assert(batch);
+
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const Amber_BlendDesc *desc = &batch->descs[i];
+		impl_instanceBlendPoses(batch->instance, desc->src_pose_count, desc->src_poses, desc->src_weights, desc->dst_pose);
+	}
+}
+
+static void impl_convertToWorldBatchJob(void *job_data, uint32_t begin, uint32_t end)
+{
+	const Impl_ConvertBatch *batch = (const Impl_ConvertBatch *)job_data;
+	assert(batch);
+
+	for (uint32_t i = begin; i < end; ++i)
+		impl_instanceConvertToWorldPose(batch->instance, batch->src_poses[i], batch->dst_poses[i]);
+}
+
+static void impl_convertToLocalBatchJob(void *job_data, uint32_t begin, uint32_t end)
+{
+	const Impl_ConvertBatch *batch = (const Impl_ConvertBatch *)job_data;
+	assert(batch);
+
+	for (uint32_t i = begin; i < end; ++i)
+		impl_instanceConvertToLocalPose(batch->instance, batch->src_poses[i], batch->dst_poses[i]);
+}
+
+/*
+ */
+Amber_Result impl_instanceSamplePoseBatch(Amber_Instance this, uint32_t count, const Amber_Sequence *sequences, const float *times, const Amber_Pose *dst_poses)
+{
+	assert(this);
+	assert(count == 0 || sequences);
+	assert(count == 0 || times);
+	assert(count == 0 || dst_poses);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	Impl_SampleBatch batch = { this, sequences, times, dst_poses };
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberSamplePoseBatch");
+	amber_jobSystemParallelFor(&instance_ptr->jobs, count, IMPL_BATCH_GRANULARITY, impl_sampleBatchJob, &batch);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberSamplePoseBatch");
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceBlendPoseBatch(Amber_Instance this, uint32_t count, const Amber_BlendDesc *descs)
+{
+	assert(this);
+	assert(count == 0 || descs);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	Impl_BlendBatch batch = { this, descs };
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberBlendPoseBatch");
+	amber_jobSystemParallelFor(&instance_ptr->jobs, count, IMPL_BATCH_GRANULARITY, impl_blendBatchJob, &batch);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberBlendPoseBatch");
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceConvertToWorldPoseBatch(Amber_Instance this, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses)
+{
+	assert(this);
+	assert(count == 0 || src_poses);
+	assert(count == 0 || dst_poses);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	Impl_ConvertBatch batch = { this, src_poses, dst_poses };
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberConvertToWorldPoseBatch");
+	amber_jobSystemParallelFor(&instance_ptr->jobs, count, IMPL_BATCH_GRANULARITY, impl_convertToWorldBatchJob, &batch);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberConvertToWorldPoseBatch");
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceConvertToLocalPoseBatch(Amber_Instance this, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses)
+{
+	assert(this);
+	assert(count == 0 || src_poses);
+	assert(count == 0 || dst_poses);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	Impl_ConvertBatch batch = { this, src_poses, dst_poses };
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberConvertToLocalPoseBatch");
+	amber_jobSystemParallelFor(&instance_ptr->jobs, count, IMPL_BATCH_GRANULARITY, impl_convertToLocalBatchJob, &batch);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberConvertToLocalPoseBatch");
+
+	return AMBER_SUCCESS;
+}
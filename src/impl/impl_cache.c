@@ -0,0 +1,532 @@
+#include "impl_internal.h"
+#include "common/intrinsics.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#define IMPL_CACHE_MAX_ACQUIRE_ATTEMPTS 4
+
+/*
+ */
+static void impl_cacheLoadTask(void *data)
+{
+	Impl_CacheEntry *entry = (Impl_CacheEntry *)data;
+	assert(entry);
+	assert(entry->memory);
+	assert(amber_atomicLoad32(&entry->state) == IMPL_CACHE_ENTRY_LOADING);
+
+	Impl_Instance *instance_ptr = entry->instance_ptr;
+	assert(instance_ptr);
+
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberLoadCachedSequence");
+
+	uint32_t state = IMPL_CACHE_ENTRY_FAILED;
+	Amber_Result result = AMBER_INVALID_DATA;
+
+	if (entry->callbacks.read)
+	{
+		result = entry->callbacks.read(entry->callbacks.user_data, entry->offset, entry->size, entry->memory);
+	}
+	else
+	{
+		FILE *file = fopen(entry->path, "rb");
+
+		if (file)
+		{
+			result = impl_fileRead(file, entry->offset, entry->size, entry->memory);
+			fclose(file);
+		}
+	}
+
+	if (result == AMBER_SUCCESS)
+		result = impl_validateSequenceBlob(entry->memory, entry->size, entry->armature_joint_count);
+
+	if (result == AMBER_SUCCESS)
+	{
+		const Impl_SequenceBlobHeader *blob = (const Impl_SequenceBlobHeader *)entry->memory;
+
+		if (blob->size == entry->size && blob->joint_count == entry->joint_count)
+		{
+			impl_bindSequence(blob, entry->armature, NULL, &entry->sequence);
+			state = IMPL_CACHE_ENTRY_RESIDENT;
+		}
+	}
+
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberLoadCachedSequence");
+
+	amber_atomicStore32(&entry->state, state);
+}
+
+/*
+ */
+// Note: the functions below must be called with the cache lock held
+// Note: entries are linked right behind the hand, so they are the last ones it reaches
+static void impl_cacheLink(Impl_SequenceCache *cache, Impl_CacheEntry *entry)
+{
+	assert(cache);
+	assert(entry);
+
+	if (cache->hand == NULL)
+		cache->hand = cache->head;
+
+	Impl_CacheEntry *next = cache->hand;
+
+	entry->prev = (next) ? next->prev : NULL;
+	entry->next = next;
+
+	if (entry->prev)
+		entry->prev->next = entry;
+	else
+		cache->head = entry;
+
+	if (next)
+		next->prev = entry;
+}
+
+static void impl_cacheUnlink(Impl_SequenceCache *cache, Impl_CacheEntry *entry)
+{
+	assert(cache);
+	assert(entry);
+
+	if (cache->hand == entry)
+		cache->hand = entry->next;
+
+	if (entry->prev)
+		entry->prev->next = entry->next;
+	else
+		cache->head = entry->next;
+
+	if (entry->next)
+		entry->next->prev = entry->prev;
+
+	entry->prev = NULL;
+	entry->next = NULL;
+}
+
+// Note: returns 0 and keeps the entry if it is pinned
+static uint32_t impl_cacheUnload(Impl_SequenceCache *cache, Impl_CacheEntry *entry, uint32_t state)
+{
+	assert(cache);
+	assert(entry);
+	assert(entry->memory);
+	assert(amber_atomicLoad32(&entry->state) != IMPL_CACHE_ENTRY_LOADING);
+
+	if (!amber_atomicCompareExchange32(&entry->pin_count, 0, IMPL_CACHE_PIN_EVICTING))
+		return 0;
+
+	impl_cacheUnlink(cache, entry);
+
+	amber_allocatorFree(&entry->instance_ptr->allocator, entry->memory, entry->size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	entry->memory = NULL;
+
+	assert(cache->resident_bytes >= entry->size);
+	assert(cache->resident_count > 0);
+
+	cache->resident_bytes -= entry->size;
+	cache->resident_count--;
+
+	amber_atomicStore32(&entry->state, state);
+	amber_atomicSubtract32(&entry->pin_count, IMPL_CACHE_PIN_EVICTING);
+
+	return 1;
+}
+
+// Note: clock sweep, entries sampled since the hand last passed them are spared once. Entries that are loading
+//       or pinned are skipped, the budget may be exceeded until they are released.
+static void impl_cacheTrim(Impl_SequenceCache *cache, uint64_t size)
+{
+	assert(cache);
+
+	if (cache->budget == 0)
+		return;
+
+	// Note: two turns of the hand clear every reference, whatever is left after that can't be unloaded
+	uint32_t remaining = cache->resident_count * 2;
+
+	while (cache->head && remaining > 0 && cache->resident_bytes + size > cache->budget)
+	{
+		Impl_CacheEntry *entry = (cache->hand) ? cache->hand : cache->head;
+		cache->hand = entry->next;
+		remaining--;
+
+		uint32_t state = amber_atomicLoad32(&entry->state);
+
+		if (state == IMPL_CACHE_ENTRY_FAILED)
+		{
+			impl_cacheUnload(cache, entry, IMPL_CACHE_ENTRY_FAILED);
+		}
+		else if (state == IMPL_CACHE_ENTRY_RESIDENT)
+		{
+			if (amber_atomicLoad32(&entry->referenced))
+				amber_atomicStore32(&entry->referenced, 0);
+			else if (impl_cacheUnload(cache, entry, IMPL_CACHE_ENTRY_EVICTED))
+				cache->eviction_count++;
+		}
+	}
+}
+
+static void impl_cacheRequest(Impl_SequenceCache *cache, Impl_CacheEntry *entry)
+{
+	assert(cache);
+	assert(entry);
+	assert(entry->memory == NULL);
+	assert(amber_atomicLoad32(&entry->state) == IMPL_CACHE_ENTRY_EVICTED);
+
+	Impl_Instance *instance_ptr = entry->instance_ptr;
+
+	impl_cacheTrim(cache, entry->size);
+
+	entry->memory = (uint8_t *)amber_allocatorAllocate(&instance_ptr->allocator, entry->size, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	assert(entry->memory);
+
+	cache->resident_bytes += entry->size;
+	cache->resident_count++;
+
+	impl_cacheLink(cache, entry);
+
+	amber_atomicStore32(&entry->referenced, 1);
+	amber_atomicStore32(&entry->state, IMPL_CACHE_ENTRY_LOADING);
+	entry->fence = amber_loaderSubmit(&instance_ptr->loader, &entry->task);
+}
+
+/*
+ */
+// Note: may be called without the cache lock, the pin holds off eviction so a resident state seen after it
+//       stays valid until the entry is released
+static uint32_t impl_cachePin(Impl_CacheEntry *entry)
+{
+	assert(entry);
+
+	uint32_t pin_count = amber_atomicIncrement32(&entry->pin_count);
+
+	if ((pin_count & IMPL_CACHE_PIN_EVICTING) == 0 && amber_atomicLoad32(&entry->state) == IMPL_CACHE_ENTRY_RESIDENT)
+	{
+		if (!amber_atomicLoad32(&entry->referenced))
+			amber_atomicStore32(&entry->referenced, 1);
+
+		return 1;
+	}
+
+	amber_atomicDecrement32(&entry->pin_count);
+	return 0;
+}
+
+// Note: pins the entry so it can't be evicted while sampled, loads it and waits for it if it isn't resident.
+//       Hits don't take the cache lock. Returns NULL if the entry failed to load or was evicted by other
+//       threads before it could be pinned.
+const Impl_Sequence *impl_cacheAcquire(Impl_CacheEntry *entry)
+{
+	assert(entry);
+
+	if (amber_atomicLoad32(&entry->state) == IMPL_CACHE_ENTRY_RESIDENT && impl_cachePin(entry))
+	{
+		amber_atomicAdd64(&entry->hit_count, 1);
+		return &entry->sequence;
+	}
+
+	Impl_Instance *instance_ptr = entry->instance_ptr;
+	Impl_SequenceCache *cache = &instance_ptr->sequence_cache;
+
+	uint32_t missed = 0;
+
+	for (uint32_t i = 0; i < IMPL_CACHE_MAX_ACQUIRE_ATTEMPTS; ++i)
+	{
+		amber_spinLockAcquire(&cache->lock);
+
+		if (impl_cachePin(entry))
+		{
+			amber_spinLockRelease(&cache->lock);
+
+			if (!missed)
+				amber_atomicAdd64(&entry->hit_count, 1);
+
+			return &entry->sequence;
+		}
+
+		uint32_t state = amber_atomicLoad32(&entry->state);
+
+		// Note: failed entries are not loaded again, their memory is released on first sight
+		if (state == IMPL_CACHE_ENTRY_FAILED)
+		{
+			if (entry->memory)
+				impl_cacheUnload(cache, entry, IMPL_CACHE_ENTRY_FAILED);
+
+			amber_spinLockRelease(&cache->lock);
+			return NULL;
+		}
+
+		if (!missed)
+		{
+			cache->miss_count++;
+			missed = 1;
+		}
+
+		if (state == IMPL_CACHE_ENTRY_EVICTED)
+			impl_cacheRequest(cache, entry);
+
+		uint64_t fence = entry->fence;
+
+		amber_spinLockRelease(&cache->lock);
+
+		amber_loaderWait(&instance_ptr->loader, fence);
+	}
+
+	return NULL;
+}
+
+void impl_cacheRelease(Impl_CacheEntry *entry)
+{
+	assert(entry);
+	assert(amber_atomicLoad32(&entry->pin_count) > 0);
+
+	amber_atomicDecrement32(&entry->pin_count);
+}
+
+/*
+ */
+// Note: 'sequence_ptr' is the cached sequence itself, its fallback transforms are written if the entry fails to load
+void impl_cacheSample(const Impl_Sequence *sequence_ptr, float time, uint32_t joint_count, Amber_Transform *dst_transforms)
+{
+	assert(sequence_ptr);
+	assert(sequence_ptr->cache_entry);
+	assert(dst_transforms);
+
+	Impl_CacheEntry *entry = sequence_ptr->cache_entry;
+	const Impl_Sequence *resident_ptr = impl_cacheAcquire(entry);
+
+	if (resident_ptr == NULL)
+	{
+		impl_poseSampleFallback(sequence_ptr, joint_count, dst_transforms);
+		return;
+	}
+
+	impl_poseSample(resident_ptr, time, joint_count, dst_transforms);
+	impl_cacheRelease(entry);
+}
+
+void impl_cacheSampleRootMotion(Impl_CacheEntry *entry, float prev_time, float time, Amber_Transform *dst_transform)
+{
+	assert(entry);
+	assert(dst_transform);
+
+	const Impl_Sequence *sequence_ptr = impl_cacheAcquire(entry);
+
+	if (sequence_ptr == NULL)
+	{
+		*dst_transform = (Amber_Transform)
+		{
+			0.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f,
+			1.0f, 1.0f, 1.0f,
+		};
+
+		return;
+	}
+
+	impl_sequenceSampleRootMotion(sequence_ptr, prev_time, time, dst_transform);
+	impl_cacheRelease(entry);
+}
+
+uint64_t impl_cachePrefetch(Impl_CacheEntry *entry)
+{
+	assert(entry);
+
+	Impl_SequenceCache *cache = &entry->instance_ptr->sequence_cache;
+	uint64_t result = 0;
+
+	amber_spinLockAcquire(&cache->lock);
+
+	uint32_t state = amber_atomicLoad32(&entry->state);
+
+	if (state == IMPL_CACHE_ENTRY_EVICTED)
+		impl_cacheRequest(cache, entry);
+	else if (state == IMPL_CACHE_ENTRY_RESIDENT)
+		amber_atomicStore32(&entry->referenced, 1);
+
+	if (amber_atomicLoad32(&entry->state) == IMPL_CACHE_ENTRY_LOADING)
+		result = entry->fence;
+
+	amber_spinLockRelease(&cache->lock);
+
+	return result;
+}
+
+void impl_destroyCacheEntry(Impl_Instance *instance_ptr, Impl_CacheEntry *entry)
+{
+	assert(instance_ptr);
+	assert(entry);
+	assert(amber_atomicLoad32(&entry->pin_count) == 0);
+
+	// Note: the loader may already be shut down when the instance is destroyed, all loads are finished then
+	if (amber_atomicLoad32(&entry->state) == IMPL_CACHE_ENTRY_LOADING)
+		amber_loaderWait(&instance_ptr->loader, entry->fence);
+
+	Impl_SequenceCache *cache = &instance_ptr->sequence_cache;
+	amber_spinLockAcquire(&cache->lock);
+
+	if (entry->memory)
+	{
+		uint32_t unloaded = impl_cacheUnload(cache, entry, IMPL_CACHE_ENTRY_EVICTED);
+		assert(unloaded);
+		AMBER_UNUSED(unloaded);
+	}
+
+	assert(cache->sequence_count > 0);
+	cache->sequence_count--;
+
+	cache->hit_count += amber_atomicLoad64(&entry->hit_count);
+
+	amber_spinLockRelease(&cache->lock);
+
+	if (entry->callbacks.close)
+		entry->callbacks.close(entry->callbacks.user_data);
+
+	amber_allocatorFree(&instance_ptr->allocator, entry, entry->allocation_size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+}
+
+/*
+ */
+static Amber_Result impl_validateCachedSequenceHeader(const Impl_SequenceBlobHeader *header)
+{
+	assert(header);
+
+	if (header->magic != IMPL_SEQUENCE_BLOB_MAGIC || header->version != IMPL_SEQUENCE_BLOB_VERSION)
+		return AMBER_INVALID_DATA;
+
+	if (header->joint_count == 0 || header->size < sizeof(Impl_SequenceBlobHeader))
+		return AMBER_INVALID_DATA;
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceCreateCachedSequence(Amber_Instance this, const Amber_CachedSequenceDesc *desc, Amber_Sequence *sequence)
+{
+	assert(this);
+	assert(desc);
+	assert(desc->callbacks.read || desc->path);
+	assert(sequence);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Armature *armature_ptr = (const Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)desc->armature);
+	assert(armature_ptr);
+
+	const Amber_StreamCallbacks *callbacks = &desc->callbacks;
+
+	Impl_SequenceBlobHeader header;
+	Amber_Result result = AMBER_INVALID_DATA;
+
+	if (callbacks->read)
+	{
+		result = callbacks->read(callbacks->user_data, desc->offset, sizeof(Impl_SequenceBlobHeader), &header);
+	}
+	else
+	{
+		FILE *file = fopen(desc->path, "rb");
+
+		if (file)
+		{
+			result = impl_fileRead(file, desc->offset, sizeof(Impl_SequenceBlobHeader), &header);
+			fclose(file);
+		}
+	}
+
+	if (result == AMBER_SUCCESS)
+		result = impl_validateCachedSequenceHeader(&header);
+
+	if (result != AMBER_SUCCESS)
+	{
+		if (callbacks->close)
+			callbacks->close(callbacks->user_data);
+
+		return AMBER_INVALID_DATA;
+	}
+
+	const Impl_Pose *fallback_pose_ptr = NULL;
+	uint32_t fallback_joint_count = 0;
+
+	if (desc->fallback_pose != AMBER_NULL_HANDLE)
+	{
+		fallback_pose_ptr = impl_getPose(instance_ptr, desc->fallback_pose);
+		assert(fallback_pose_ptr);
+		assert(fallback_pose_ptr->transforms);
+
+		fallback_joint_count = fallback_pose_ptr->joint_count;
+	}
+
+	uint64_t fallback_offset = alignUpul(sizeof(Impl_CacheEntry), AMBER_SIMD_ALIGNMENT);
+	uint64_t fallback_size = sizeof(Amber_Transform) * fallback_joint_count;
+	uint64_t path_offset = fallback_offset + fallback_size;
+	uint64_t path_size = (callbacks->read) ? 0 : strlen(desc->path) + 1;
+	uint64_t size = path_offset + path_size;
+
+	uint8_t *memory = (uint8_t *)amber_allocatorAllocate(&instance_ptr->allocator, size, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	assert(memory);
+
+	Impl_CacheEntry *entry = (Impl_CacheEntry *)memory;
+	memset(entry, 0, sizeof(Impl_CacheEntry));
+
+	entry->task.function = impl_cacheLoadTask;
+	entry->task.data = entry;
+	entry->instance_ptr = instance_ptr;
+	entry->armature = desc->armature;
+	entry->armature_joint_count = armature_ptr->joint_count;
+	entry->callbacks = *callbacks;
+	entry->offset = desc->offset;
+	entry->size = header.size;
+	entry->allocation_size = size;
+	entry->joint_count = header.joint_count;
+	entry->state = IMPL_CACHE_ENTRY_EVICTED;
+
+	if (path_size > 0)
+	{
+		memcpy(memory + path_offset, desc->path, path_size);
+		entry->path = (const char *)(memory + path_offset);
+	}
+
+	// Note: fallback transforms live in the entry allocation, so they go away with the sequence
+	Amber_Transform *fallback_transforms = NULL;
+
+	if (fallback_pose_ptr)
+	{
+		fallback_transforms = (Amber_Transform *)(memory + fallback_offset);
+		memcpy(fallback_transforms, fallback_pose_ptr->transforms, fallback_size);
+	}
+
+	Impl_SequenceCache *cache = &instance_ptr->sequence_cache;
+
+	amber_spinLockAcquire(&cache->lock);
+	cache->sequence_count++;
+	amber_spinLockRelease(&cache->lock);
+
+	Impl_Sequence sequence_ptr;
+	memset(&sequence_ptr, 0, sizeof(Impl_Sequence));
+	sequence_ptr.armature = desc->armature;
+	sequence_ptr.joint_count = header.joint_count;
+	sequence_ptr.min_time = header.min_time;
+	sequence_ptr.max_time = header.max_time;
+	sequence_ptr.state = IMPL_SEQUENCE_STATE_READY;
+	sequence_ptr.fallback_joint_count = fallback_joint_count;
+	sequence_ptr.fallback_transforms = fallback_transforms;
+	sequence_ptr.cache_entry = entry;
+
+	*sequence = (Amber_Sequence)amber_poolAddElement(&instance_ptr->sequences, &sequence_ptr);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceSetSequenceCacheBudget(Amber_Instance this, uint64_t budget)
+{
+	assert(this);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_SequenceCache *cache = &instance_ptr->sequence_cache;
+
+	amber_spinLockAcquire(&cache->lock);
+
+	cache->budget = budget;
+	impl_cacheTrim(cache, 0);
+
+	amber_spinLockRelease(&cache->lock);
+
+	return AMBER_SUCCESS;
+}
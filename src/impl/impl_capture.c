@@ -0,0 +1,72 @@
+#include "impl_internal.h"
+
+#include <assert.h>
+
+/*
+ */
+void impl_destroyCapture(Impl_Instance *instance_ptr, Amber_Capture *capture)
+{
+	assert(instance_ptr);
+	assert(capture);
+
+	amber_captureShutdown(capture);
+	amber_allocatorFree(&instance_ptr->allocator, capture, sizeof(Amber_Capture), AMBER_MEMORY_CATEGORY_INSTANCE);
+}
+
+/*
+ */
+Amber_Result impl_instanceBeginCapture(Amber_Instance this, const Amber_CaptureDesc *desc)
+{
+	assert(this);
+
+#if defined(AMBER_PROFILE_ZONES)
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	if (amber_atomicLoadPtr((void *const volatile *)&instance_ptr->profiler.capture) != NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	Amber_Capture *capture = (Amber_Capture *)amber_allocatorAllocate(&instance_ptr->allocator, sizeof(Amber_Capture), AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_INSTANCE);
+	if (capture == NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	Amber_Result result = amber_captureInitialize(capture, &instance_ptr->allocator, (desc) ? desc->event_capacity : 0);
+
+	// Note: the capture is fully initialized before zones can observe it
+	if (result == AMBER_SUCCESS)
+		result = amber_profilerBeginCapture(&instance_ptr->profiler, capture);
+
+	if (result != AMBER_SUCCESS)
+		impl_destroyCapture(instance_ptr, capture);
+
+	return result;
+#else
+	AMBER_UNUSED(desc);
+	return AMBER_NOT_IMPLEMENTED;
+#endif
+}
+
+Amber_Result impl_instanceEndCapture(Amber_Instance this, const char *path)
+{
+	assert(this);
+
+#if defined(AMBER_PROFILE_ZONES)
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	// Note: returns once no zone is recording into the capture anymore, including loader thread zones
+	Amber_Capture *capture = amber_profilerEndCapture(&instance_ptr->profiler);
+	if (capture == NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	Amber_Result result = AMBER_SUCCESS;
+
+	if (path)
+		result = amber_captureWriteTrace(capture, path);
+
+	impl_destroyCapture(instance_ptr, capture);
+
+	return result;
+#else
+	AMBER_UNUSED(path);
+	return AMBER_NOT_IMPLEMENTED;
+#endif
+}
@@ -0,0 +1,558 @@
+#include "impl_internal.h"
+#include "common/intrinsics.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define IMPL_GRAPH_CACHE_NONE 0xFFFFFFFF
+
+/*
+ */
+// Note: graphs are immutable, everything written during an evaluation lives in its context
+typedef struct Impl_GraphContext_t
+{
+	const Impl_Graph *graph_ptr;
+	const float *parameters;
+	Amber_Transform *dst_transforms;
+	Amber_Transform *scratch_transforms;
+	const Impl_Sequence **sequences;
+	uint8_t *cache_valid;
+} Impl_GraphContext;
+
+/*
+ */
+static AMBER_INLINE float impl_graphGetWeight(const Impl_GraphContext *context, uint32_t parameter)
+{
+	assert(context);
+
+	if (parameter == AMBER_GRAPH_PARAMETER_NONE)
+		return 1.0f;
+
+	assert(parameter < context->graph_ptr->parameter_count);
+	return context->parameters[parameter];
+}
+
+static AMBER_INLINE Amber_Transform *impl_graphGetSlot(const Impl_GraphContext *context, uint32_t depth)
+{
+	assert(context);
+
+	const Impl_Graph *graph_ptr = context->graph_ptr;
+
+	if (depth == 0)
+		return context->dst_transforms;
+
+	assert(depth - 1 < graph_ptr->scratch_count);
+	return context->scratch_transforms + (depth - 1) * graph_ptr->joint_count;
+}
+
+static AMBER_INLINE Amber_Transform *impl_graphGetCache(const Impl_GraphContext *context, uint32_t cache_index)
+{
+	assert(context);
+
+	const Impl_Graph *graph_ptr = context->graph_ptr;
+	assert(cache_index < graph_ptr->cache_count);
+
+	uint32_t offset = graph_ptr->scratch_count + cache_index;
+	return context->scratch_transforms + offset * graph_ptr->joint_count;
+}
+
+/*
+ */
+static const Amber_Transform *impl_graphEvaluateNode(const Impl_GraphContext *context, uint32_t node_index, uint32_t depth);
+
+static const Amber_Transform *impl_graphEvaluateClip(const Impl_GraphContext *context, const Impl_GraphNode *node, uint32_t depth)
+{
+	const Impl_Graph *graph_ptr = context->graph_ptr;
+
+	const Impl_Sequence *sequence_ptr = context->sequences[node - graph_ptr->nodes];
+	assert(sequence_ptr);
+
+	float time = impl_graphGetWeight(context, node->time_parameter);
+	Amber_Transform *dst_transforms = NULL;
+
+	if (node->cache_index != IMPL_GRAPH_CACHE_NONE)
+	{
+		dst_transforms = impl_graphGetCache(context, node->cache_index);
+
+		if (context->cache_valid[node->cache_index])
+			return dst_transforms;
+
+		context->cache_valid[node->cache_index] = 1;
+	}
+	else
+		dst_transforms = impl_graphGetSlot(context, depth);
+
+	memcpy(dst_transforms, graph_ptr->reference_transforms, sizeof(Amber_Transform) * graph_ptr->joint_count);
+	impl_poseSample(sequence_ptr, time, graph_ptr->joint_count, dst_transforms);
+
+	return dst_transforms;
+}
+
+static const Amber_Transform *impl_graphEvaluateBlend(const Impl_GraphContext *context, const Impl_GraphNode *node, uint32_t depth)
+{
+	const Impl_Graph *graph_ptr = context->graph_ptr;
+
+	uint32_t active_count = 0;
+	uint32_t active_input = 0;
+	float active_weight = 0.0f;
+
+	for (uint32_t i = 0; i < node->input_count; ++i)
+	{
+		float weight = impl_graphGetWeight(context, node->weight_parameters[i]);
+		if (weight == 0.0f)
+			continue;
+
+		active_count++;
+		active_input = i;
+		active_weight = weight;
+	}
+
+	// Note: a single fully weighted input is forwarded as is, without touching the stack
+	if (active_count == 1 && active_weight == 1.0f)
+		return impl_graphEvaluateNode(context, node->inputs[active_input], depth);
+
+	Amber_Transform *dst_transforms = impl_graphGetSlot(context, depth);
+
+	if (active_count == 0)
+	{
+		memcpy(dst_transforms, graph_ptr->reference_transforms, sizeof(Amber_Transform) * graph_ptr->joint_count);
+		return dst_transforms;
+	}
+
+	memset(dst_transforms, 0, sizeof(Amber_Transform) * graph_ptr->joint_count);
+
+	for (uint32_t i = 0; i < node->input_count; ++i)
+	{
+		float weight = impl_graphGetWeight(context, node->weight_parameters[i]);
+		if (weight == 0.0f)
+			continue;
+
+		const Amber_Transform *src_transforms = impl_graphEvaluateNode(context, node->inputs[i], depth + 1);
+		impl_poseAccumulate(graph_ptr->joint_count, src_transforms, weight, dst_transforms);
+	}
+
+	impl_poseNormalize(graph_ptr->joint_count, dst_transforms);
+	return dst_transforms;
+}
+
+static const Amber_Transform *impl_graphEvaluateAdditive(const Impl_GraphContext *context, const Impl_GraphNode *node, uint32_t depth)
+{
+	const Impl_Graph *graph_ptr = context->graph_ptr;
+
+	assert(node->input_count > 0);
+
+	uint32_t active_count = 0;
+	for (uint32_t i = 1; i < node->input_count; ++i)
+		if (impl_graphGetWeight(context, node->weight_parameters[i]) != 0.0f)
+			active_count++;
+
+	const Amber_Transform *base_transforms = impl_graphEvaluateNode(context, node->inputs[0], depth);
+
+	if (active_count == 0)
+		return base_transforms;
+
+	Amber_Transform *dst_transforms = impl_graphGetSlot(context, depth);
+
+	if (base_transforms != dst_transforms)
+		memcpy(dst_transforms, base_transforms, sizeof(Amber_Transform) * graph_ptr->joint_count);
+
+	for (uint32_t i = 1; i < node->input_count; ++i)
+	{
+		float weight = impl_graphGetWeight(context, node->weight_parameters[i]);
+		if (weight == 0.0f)
+			continue;
+
+		const Amber_Transform *src_transforms = impl_graphEvaluateNode(context, node->inputs[i], depth + 1);
+		impl_poseApplyAdditive(graph_ptr->joint_count, src_transforms, weight, dst_transforms);
+	}
+
+	return dst_transforms;
+}
+
+static const Amber_Transform *impl_graphEvaluateMask(const Impl_GraphContext *context, const Impl_GraphNode *node, uint32_t depth)
+{
+	const Impl_Graph *graph_ptr = context->graph_ptr;
+
+	assert(node->input_count == 2);
+
+	float weight = impl_graphGetWeight(context, node->weight_parameters[1]);
+	const Amber_Transform *base_transforms = impl_graphEvaluateNode(context, node->inputs[0], depth);
+
+	if (weight == 0.0f)
+		return base_transforms;
+
+	Amber_Transform *dst_transforms = impl_graphGetSlot(context, depth);
+
+	if (base_transforms != dst_transforms)
+		memcpy(dst_transforms, base_transforms, sizeof(Amber_Transform) * graph_ptr->joint_count);
+
+	const Amber_Transform *src_transforms = impl_graphEvaluateNode(context, node->inputs[1], depth + 1);
+	impl_poseLerp(graph_ptr->joint_count, src_transforms, node->joint_weights, weight, dst_transforms);
+
+	return dst_transforms;
+}
+
+static const Amber_Transform *impl_graphEvaluateNode(const Impl_GraphContext *context, uint32_t node_index, uint32_t depth)
+{
+	assert(context);
+	assert(node_index < context->graph_ptr->node_count);
+
+	const Impl_GraphNode *node = &context->graph_ptr->nodes[node_index];
+
+	switch (node->type)
+	{
+		case AMBER_GRAPH_NODE_TYPE_CLIP: return impl_graphEvaluateClip(context, node, depth);
+		case AMBER_GRAPH_NODE_TYPE_BLEND: return impl_graphEvaluateBlend(context, node, depth);
+		case AMBER_GRAPH_NODE_TYPE_ADDITIVE: return impl_graphEvaluateAdditive(context, node, depth);
+		case AMBER_GRAPH_NODE_TYPE_MASK: return impl_graphEvaluateMask(context, node, depth);
+		default: assert(0); return NULL;
+	}
+}
+
+/*
+ */
+void impl_destroyGraph(Impl_Instance *instance_ptr, Impl_Graph *graph_ptr)
+{
+	assert(instance_ptr);
+	assert(graph_ptr);
+
+	const Amber_Allocator *allocator = &instance_ptr->allocator;
+	uint32_t joint_count = graph_ptr->joint_count;
+
+	amber_allocatorFree(allocator, graph_ptr->reference_transforms, sizeof(Amber_Transform) * joint_count, AMBER_MEMORY_CATEGORY_GRAPH);
+	amber_allocatorFree(allocator, graph_ptr->joint_weight_memory, sizeof(float) * graph_ptr->joint_weight_count, AMBER_MEMORY_CATEGORY_GRAPH);
+	amber_allocatorFree(allocator, graph_ptr->input_memory, sizeof(uint32_t) * graph_ptr->input_memory_count, AMBER_MEMORY_CATEGORY_GRAPH);
+	amber_allocatorFree(allocator, graph_ptr->nodes, sizeof(Impl_GraphNode) * graph_ptr->node_count, AMBER_MEMORY_CATEGORY_GRAPH);
+}
+
+/*
+ */
+Amber_Result impl_instanceCreateGraph(Amber_Instance this, const Amber_GraphDesc *desc, Amber_Graph *graph)
+{
+	assert(this);
+	assert(desc);
+	assert(desc->node_count > 0);
+	assert(desc->nodes);
+	assert(graph);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)desc->armature);
+	assert(armature_ptr);
+	assert(armature_ptr->joint_count > 0);
+
+	uint32_t joint_count = armature_ptr->joint_count;
+
+	uint32_t total_inputs = 0;
+	uint32_t total_masks = 0;
+
+	for (uint32_t i = 0; i < desc->node_count; ++i)
+	{
+		const Amber_GraphNodeDesc *node_desc = &desc->nodes[i];
+		total_inputs += node_desc->input_count;
+
+		if (node_desc->type == AMBER_GRAPH_NODE_TYPE_MASK && node_desc->joint_weights)
+			total_masks++;
+	}
+
+	const Amber_Allocator *allocator = &instance_ptr->allocator;
+
+	Impl_GraphNode *nodes = (Impl_GraphNode *)amber_allocatorAllocate(allocator, sizeof(Impl_GraphNode) * desc->node_count, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_GRAPH);
+	memset(nodes, 0, sizeof(Impl_GraphNode) * desc->node_count);
+
+	uint32_t input_memory_count = total_inputs * 2;
+	uint32_t *input_memory = NULL;
+	if (input_memory_count > 0)
+		input_memory = (uint32_t *)amber_allocatorAllocate(allocator, sizeof(uint32_t) * input_memory_count, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_GRAPH);
+
+	uint32_t joint_weight_count = total_masks * joint_count;
+	float *joint_weight_memory = NULL;
+	if (joint_weight_count > 0)
+		joint_weight_memory = (float *)amber_allocatorAllocate(allocator, sizeof(float) * joint_weight_count, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_GRAPH);
+
+	// Note: reference counts are needed to find out which clips are shared and have to be cached
+	uint32_t *reference_counts = (uint32_t *)amber_allocatorAllocate(allocator, sizeof(uint32_t) * desc->node_count, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_GRAPH);
+	memset(reference_counts, 0, sizeof(uint32_t) * desc->node_count);
+	reference_counts[desc->node_count - 1] = 1;
+
+	uint32_t *input_ptr = input_memory;
+	float *joint_weight_ptr = joint_weight_memory;
+	uint32_t stack_depth = 0;
+
+	for (uint32_t i = 0; i < desc->node_count; ++i)
+	{
+		const Amber_GraphNodeDesc *node_desc = &desc->nodes[i];
+		Impl_GraphNode *node = &nodes[i];
+
+		assert(node_desc->type < AMBER_GRAPH_NODE_TYPE_ENUM_MAX);
+		assert(node_desc->input_count == 0 || node_desc->inputs);
+
+		node->type = node_desc->type;
+		node->input_count = node_desc->input_count;
+		node->sequence = node_desc->sequence;
+		node->time_parameter = node_desc->time_parameter;
+		node->cache_index = IMPL_GRAPH_CACHE_NONE;
+
+		if (node->input_count > 0)
+		{
+			node->inputs = input_ptr;
+			node->weight_parameters = input_ptr + node->input_count;
+			input_ptr += node->input_count * 2;
+
+			memcpy(node->inputs, node_desc->inputs, sizeof(uint32_t) * node->input_count);
+
+			if (node_desc->weight_parameters)
+				memcpy(node->weight_parameters, node_desc->weight_parameters, sizeof(uint32_t) * node->input_count);
+			else
+				memset(node->weight_parameters, 0xFF, sizeof(uint32_t) * node->input_count);
+		}
+
+		for (uint32_t j = 0; j < node->input_count; ++j)
+		{
+			assert(node->inputs[j] < i);
+			assert(node->weight_parameters[j] == AMBER_GRAPH_PARAMETER_NONE || node->weight_parameters[j] < desc->parameter_count);
+
+			reference_counts[node->inputs[j]]++;
+		}
+
+		uint32_t input_depth = 0;
+		for (uint32_t j = 1; j < node->input_count; ++j)
+			input_depth = max(input_depth, nodes[node->inputs[j]].stack_depth);
+
+		switch (node->type)
+		{
+			case AMBER_GRAPH_NODE_TYPE_CLIP:
+			{
+				assert(node->input_count == 0);
+				assert(node->time_parameter < desc->parameter_count);
+
+				Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)node->sequence);
+				assert(sequence_ptr);
+				assert(sequence_ptr->armature == desc->armature);
+				AMBER_UNUSED(sequence_ptr);
+
+				node->stack_depth = 1;
+			}
+			break;
+
+			case AMBER_GRAPH_NODE_TYPE_BLEND:
+			{
+				input_depth = (node->input_count > 0) ? max(input_depth, nodes[node->inputs[0]].stack_depth) : 0;
+				node->stack_depth = 1 + input_depth;
+			}
+			break;
+
+			case AMBER_GRAPH_NODE_TYPE_ADDITIVE:
+			{
+				assert(node->input_count > 0);
+				node->stack_depth = max(nodes[node->inputs[0]].stack_depth, 1 + input_depth);
+			}
+			break;
+
+			case AMBER_GRAPH_NODE_TYPE_MASK:
+			{
+				assert(node->input_count == 2);
+				node->stack_depth = max(nodes[node->inputs[0]].stack_depth, 1 + input_depth);
+
+				if (node_desc->joint_weights)
+				{
+					node->joint_weights = joint_weight_ptr;
+					joint_weight_ptr += joint_count;
+
+					memcpy(node->joint_weights, node_desc->joint_weights, sizeof(float) * joint_count);
+				}
+			}
+			break;
+
+			default: assert(0); break;
+		}
+
+		stack_depth = max(stack_depth, node->stack_depth);
+	}
+
+	// Note: clips sampling the same sequence with the same time parameter are merged,
+	//       and if merged clip is referenced more than once it gets a dedicated cache slot
+	uint32_t cache_count = 0;
+
+	for (uint32_t i = 0; i < desc->node_count; ++i)
+	{
+		Impl_GraphNode *node = &nodes[i];
+		if (node->type != AMBER_GRAPH_NODE_TYPE_CLIP || reference_counts[i] == 0)
+			continue;
+
+		uint32_t canonical = i;
+		for (uint32_t j = 0; j < i; ++j)
+		{
+			const Impl_GraphNode *other = &nodes[j];
+			if (other->type != AMBER_GRAPH_NODE_TYPE_CLIP || reference_counts[j] == 0)
+				continue;
+
+			if (other->sequence == node->sequence && other->time_parameter == node->time_parameter)
+			{
+				canonical = j;
+				break;
+			}
+		}
+
+		if (canonical != i)
+		{
+			reference_counts[canonical] += reference_counts[i];
+			reference_counts[i] = 0;
+		}
+	}
+
+	for (uint32_t i = 0; i < desc->node_count; ++i)
+	{
+		Impl_GraphNode *node = &nodes[i];
+		if (node->type != AMBER_GRAPH_NODE_TYPE_CLIP)
+			continue;
+
+		if (reference_counts[i] > 1)
+		{
+			node->cache_index = cache_count++;
+			continue;
+		}
+
+		for (uint32_t j = 0; j < i; ++j)
+		{
+			const Impl_GraphNode *other = &nodes[j];
+			if (other->type != AMBER_GRAPH_NODE_TYPE_CLIP || other->cache_index == IMPL_GRAPH_CACHE_NONE)
+				continue;
+
+			if (other->sequence == node->sequence && other->time_parameter == node->time_parameter)
+			{
+				node->cache_index = other->cache_index;
+				break;
+			}
+		}
+	}
+
+	amber_allocatorFree(allocator, reference_counts, sizeof(uint32_t) * desc->node_count, AMBER_MEMORY_CATEGORY_GRAPH);
+
+	Amber_Transform *reference_transforms = (Amber_Transform *)amber_allocatorAllocate(allocator, sizeof(Amber_Transform) * joint_count, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_GRAPH);
+
+	if (desc->reference_pose != AMBER_NULL_HANDLE)
+	{
+		Impl_Pose *reference_pose_ptr = impl_getPose(instance_ptr, desc->reference_pose);
+		assert(reference_pose_ptr);
+		assert(reference_pose_ptr->transforms);
+		assert(reference_pose_ptr->armature == desc->armature);
+
+		memcpy(reference_transforms, reference_pose_ptr->transforms, sizeof(Amber_Transform) * joint_count);
+	}
+	else
+	{
+		for (uint32_t i = 0; i < joint_count; ++i)
+		{
+			reference_transforms[i] = (Amber_Transform)
+			{
+				0.0f, 0.0f, 0.0f,
+				0.0f, 0.0f, 0.0f, 1.0f,
+				1.0f, 1.0f, 1.0f,
+			};
+		}
+	}
+
+	// Note: slot 0 of the stack is always the destination pose
+	uint32_t scratch_count = (stack_depth > 0) ? stack_depth - 1 : 0;
+
+	Impl_Graph result = {0};
+	result.armature = desc->armature;
+	result.joint_count = joint_count;
+	result.parameter_count = desc->parameter_count;
+	result.node_count = desc->node_count;
+	result.nodes = nodes;
+	result.input_memory = input_memory;
+	result.input_memory_count = input_memory_count;
+	result.joint_weight_memory = joint_weight_memory;
+	result.joint_weight_count = joint_weight_count;
+	result.reference_transforms = reference_transforms;
+	result.scratch_count = scratch_count;
+	result.cache_count = cache_count;
+
+	*graph = (Amber_Graph)amber_poolAddElement(&instance_ptr->graphs, &result);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceDestroyGraph(Amber_Instance this, Amber_Graph graph)
+{
+	assert(this);
+	assert(graph);
+
+	Amber_PoolHandle handle = (Amber_PoolHandle)graph;
+	assert(handle != AMBER_POOL_HANDLE_NULL);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_Graph *graph_ptr = (Impl_Graph *)amber_poolGetElement(&instance_ptr->graphs, handle);
+	assert(graph_ptr);
+
+	impl_destroyGraph(instance_ptr, graph_ptr);
+	amber_poolRemoveElement(&instance_ptr->graphs, handle);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceEvaluateGraph(Amber_Instance this, Amber_Graph graph, uint32_t parameter_count, const float *parameters, Amber_Pose dst_pose)
+{
+	assert(this);
+	assert(graph);
+	assert(dst_pose);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Graph *graph_ptr = (const Impl_Graph *)amber_poolGetElement(&instance_ptr->graphs, (Amber_PoolHandle)graph);
+	assert(graph_ptr);
+
+	if (parameter_count < graph_ptr->parameter_count || (parameter_count > 0 && parameters == NULL))
+		return AMBER_INVALID_DATA;
+
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
+	assert(dst_pose_ptr);
+	assert(dst_pose_ptr->transforms);
+	assert(dst_pose_ptr->armature == graph_ptr->armature);
+
+	// Note: scratch is allocated per call, so concurrent evaluations of one graph don't share state
+	//       and nothing is left behind once the evaluation returns
+	uint64_t scratch_total = graph_ptr->scratch_count + graph_ptr->cache_count;
+	uint64_t scratch_size = sizeof(Amber_Transform) * scratch_total * graph_ptr->joint_count;
+	uint64_t sequences_size = sizeof(const Impl_Sequence *) * graph_ptr->node_count;
+	uint64_t size = scratch_size + sequences_size + graph_ptr->cache_count;
+
+	uint8_t *memory = (uint8_t *)amber_allocatorAllocate(&instance_ptr->allocator, size, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_GRAPH);
+	if (memory == NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	Impl_GraphContext context = {0};
+	context.graph_ptr = graph_ptr;
+	context.parameters = parameters;
+	context.dst_transforms = dst_pose_ptr->transforms;
+	context.scratch_transforms = (Amber_Transform *)memory;
+	context.sequences = (const Impl_Sequence **)(memory + scratch_size);
+	context.cache_valid = memory + scratch_size + sequences_size;
+
+	memset(context.sequences, 0, sequences_size);
+	memset(context.cache_valid, 0, sizeof(uint8_t) * graph_ptr->cache_count);
+
+	// Note: graphs don't keep their sequences alive, clips are resolved up front so a destroyed one fails cleanly
+	for (uint32_t i = 0; i < graph_ptr->node_count; ++i)
+	{
+		const Impl_GraphNode *node = &graph_ptr->nodes[i];
+		if (node->type != AMBER_GRAPH_NODE_TYPE_CLIP)
+			continue;
+
+		const Impl_Sequence *sequence_ptr = (const Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)node->sequence);
+
+		if (sequence_ptr == NULL || sequence_ptr->armature != graph_ptr->armature)
+		{
+			amber_allocatorFree(&instance_ptr->allocator, memory, size, AMBER_MEMORY_CATEGORY_GRAPH);
+			return AMBER_INVALID_HANDLE;
+		}
+
+		context.sequences[i] = sequence_ptr;
+	}
+
+	const Amber_Transform *result = impl_graphEvaluateNode(&context, graph_ptr->node_count - 1, 0);
+
+	if (result != dst_pose_ptr->transforms)
+		memcpy(dst_pose_ptr->transforms, result, sizeof(Amber_Transform) * graph_ptr->joint_count);
+
+	amber_allocatorFree(&instance_ptr->allocator, memory, size, AMBER_MEMORY_CATEGORY_GRAPH);
+	return AMBER_SUCCESS;
+}
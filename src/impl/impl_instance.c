@@ -1,11 +1,13 @@
 #include "impl_internal.h"
+#include "common/intrinsics.h"
 
 #include <assert.h>
 #include <string.h>
-#include <stdlib.h>
 #include <math.h>
 #include <float.h>
 
+#define IMPL_TRANSIENT_ARENA_BLOCK_SIZE (64 * 1024)
+
 /*
  */
 static AMBER_INLINE float amber_floatMin(float a, float b);
@@ -228,21 +230,24 @@ static AMBER_INLINE Amber_Transform amber_mulTransform(Amber_Transform a, Amber_
 	};
 }
 
-static AMBER_INLINE float amber_fetchCurveValue(const Impl_SequenceCurve *curve, float time)
+static AMBER_INLINE float amber_fetchCurveValue(const Amber_SequenceKey *sequence_keys, const Impl_SequenceCurve *curve, float time)
 {
+	assert(sequence_keys);
 	assert(curve);
 	assert(curve->key_count > 0);
 
-	if (time <= curve->keys[0].time)
-		return curve->keys[0].value;
+	const Amber_SequenceKey *keys = sequence_keys + curve->first_key;
+
+	if (time <= keys[0].time)
+		return keys[0].value;
 
-	if (time >= curve->keys[curve->key_count - 1].time)
-		return curve->keys[curve->key_count - 1].value;
+	if (time >= keys[curve->key_count - 1].time)
+		return keys[curve->key_count - 1].value;
 
 	for (uint32_t i = 0; i < curve->key_count - 1; ++i)
 	{
-		const Amber_SequenceKey *key0 = &curve->keys[i];
-		const Amber_SequenceKey *key1 = &curve->keys[i + 1];
+		const Amber_SequenceKey *key0 = &keys[i];
+		const Amber_SequenceKey *key1 = &keys[i + 1];
 
 		if (key0->time <= time && time <= key1->time)
 		{
@@ -255,7 +260,7 @@ static AMBER_INLINE float amber_fetchCurveValue(const Impl_SequenceCurve *curve,
 	return 0.0f;
 }
 
-static AMBER_INLINE Amber_Transform amber_fetchJointTransform(const Impl_SequenceJointCurve *joint_curve, float time)
+static AMBER_INLINE Amber_Transform amber_fetchJointTransform(const Amber_SequenceKey *sequence_keys, const Impl_SequenceJointCurve *joint_curve, float time)
 {
 	assert(joint_curve);
 
@@ -304,7 +309,7 @@ static AMBER_INLINE Amber_Transform amber_fetchJointTransform(const Impl_Sequenc
 		if (curve->key_count == 0)
 			continue;
 
-		*dst_values[j] = amber_fetchCurveValue(curve, time);
+		*dst_values[j] = amber_fetchCurveValue(sequence_keys, curve, time);
 	}
 
 	return result;
@@ -312,327 +317,1291 @@ static AMBER_INLINE Amber_Transform amber_fetchJointTransform(const Impl_Sequenc
 
 /*
  */
-static void impl_destroyArmature(Impl_Instance *instance_ptr, Impl_Armature *armature_ptr)
+// Note: sequences that are still loading or failed to load write their fallback transforms, if any,
+//       and leave the rest untouched
+void impl_poseSampleFallback(const Impl_Sequence *sequence_ptr, uint32_t joint_count, Amber_Transform *dst_transforms)
 {
-	assert(instance_ptr);
-	assert(armature_ptr);
+	assert(sequence_ptr);
+	assert(dst_transforms);
 
-	AMBER_UNUSED(instance_ptr);
+	if (sequence_ptr->fallback_transforms == NULL)
+		return;
 
-	free(armature_ptr->joint_name_memory);
-	free(armature_ptr->joint_name_offsets);
-	free(armature_ptr->joint_parents);
+	uint32_t count = (joint_count < sequence_ptr->fallback_joint_count) ? joint_count : sequence_ptr->fallback_joint_count;
+	memcpy(dst_transforms, sequence_ptr->fallback_transforms, sizeof(Amber_Transform) * count);
 }
 
-static void impl_destroyPose(Impl_Instance *instance_ptr, Impl_Pose *pose_ptr)
+void impl_poseSample(const Impl_Sequence *sequence_ptr, float time, uint32_t joint_count, Amber_Transform *dst_transforms)
 {
-	assert(instance_ptr);
-	assert(pose_ptr);
+	assert(sequence_ptr);
+	assert(sequence_ptr->joint_count > 0);
+	assert(dst_transforms);
+
+	if (!impl_isSequenceReady(sequence_ptr))
+	{
+		impl_poseSampleFallback(sequence_ptr, joint_count, dst_transforms);
+		return;
+	}
+
+	if (sequence_ptr->stream)
+	{
+		impl_streamSample(sequence_ptr->stream, time, joint_count, dst_transforms);
+		return;
+	}
+
+	if (sequence_ptr->cache_entry)
+	{
+		impl_cacheSample(sequence_ptr, time, joint_count, dst_transforms);
+		return;
+	}
+
+	assert(sequence_ptr->joint_curves);
+	assert(sequence_ptr->joint_indices);
+
+	AMBER_UNUSED(joint_count);
 
-	AMBER_UNUSED(instance_ptr);
+	for (uint32_t i = 0; i < sequence_ptr->joint_count; ++i)
+	{
+		uint32_t index = sequence_ptr->joint_indices[i];
+		assert(index < joint_count);
+
+		const Impl_SequenceJointCurve *src_joint_curve = &sequence_ptr->joint_curves[i];
+		assert(src_joint_curve);
 
-	free(pose_ptr->transforms);
+		dst_transforms[index] = amber_fetchJointTransform(sequence_ptr->keys, src_joint_curve, time);
+	}
 }
 
-static void impl_destroySequence(Impl_Instance *instance_ptr, Impl_Sequence *sequence_ptr)
+void impl_poseAccumulate(uint32_t joint_count, const Amber_Transform *src_transforms, float weight, Amber_Transform *dst_transforms)
 {
-	assert(instance_ptr);
-	assert(sequence_ptr);
+	assert(src_transforms);
+	assert(dst_transforms);
 
-	AMBER_UNUSED(instance_ptr);
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		const Amber_Transform *src_transform = &src_transforms[i];
+		Amber_Transform *dst_transform = &dst_transforms[i];
 
-	for (uint32_t i = 0; i < sequence_ptr->joint_count; ++i)
+		Amber_Quat src_rotation = src_transform->rotation;
+		Amber_Quat dst_rotation = dst_transform->rotation;
+
+		if (amber_quatDot(src_rotation, dst_rotation) < 0.0f)
+			dst_rotation = (Amber_Quat){-dst_rotation.x, -dst_rotation.y, -dst_rotation.z, -dst_rotation.w};
+
+		dst_transform->position = amber_vec3Mad(src_transform->position, weight, dst_transform->position);
+		dst_transform->rotation = amber_quatMad(src_rotation, weight, dst_rotation);
+		dst_transform->scale = amber_vec3Mad(src_transform->scale, weight, dst_transform->scale);
+	}
+}
+
+void impl_poseNormalize(uint32_t joint_count, Amber_Transform *dst_transforms)
+{
+	assert(dst_transforms);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		Amber_Transform *dst_transform = &dst_transforms[i];
+		dst_transform->rotation = amber_quatNormalize(dst_transform->rotation);
+	}
+}
+
+void impl_poseApplyAdditive(uint32_t joint_count, const Amber_Transform *src_additive_transforms, float weight, Amber_Transform *dst_transforms)
+{
+	assert(src_additive_transforms);
+	assert(dst_transforms);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		const Amber_Transform *src_additive_transform = &src_additive_transforms[i];
+		Amber_Transform *dst_transform = &dst_transforms[i];
+
+		dst_transform->position = amber_vec3Mad(src_additive_transform->position, weight, dst_transform->position);
+		dst_transform->rotation = amber_quatLerp(dst_transform->rotation, amber_quatMul(dst_transform->rotation, src_additive_transform->rotation), weight);
+		dst_transform->scale = amber_vec3Lerp(dst_transform->scale, amber_vec3Mul(dst_transform->scale, src_additive_transform->scale), weight);
+	}
+}
+
+void impl_poseLerp(uint32_t joint_count, const Amber_Transform *src_transforms, const float *joint_weights, float weight, Amber_Transform *dst_transforms)
+{
+	assert(src_transforms);
+	assert(dst_transforms);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
 	{
-		Impl_SequenceJointCurve *curve = &sequence_ptr->joint_curves[i];
+		float t = (joint_weights) ? joint_weights[i] * weight : weight;
+
+		if (t == 0.0f)
+			continue;
+
+		const Amber_Transform *src_transform = &src_transforms[i];
+		Amber_Transform *dst_transform = &dst_transforms[i];
+
+		Amber_Quat src_rotation = src_transform->rotation;
+		Amber_Quat dst_rotation = dst_transform->rotation;
+
+		if (amber_quatDot(src_rotation, dst_rotation) < 0.0f)
+			src_rotation = (Amber_Quat){-src_rotation.x, -src_rotation.y, -src_rotation.z, -src_rotation.w};
+
+		dst_transform->position = amber_vec3Lerp(dst_transform->position, src_transform->position, t);
+		dst_transform->rotation = amber_quatLerp(dst_rotation, src_rotation, t);
+		dst_transform->scale = amber_vec3Lerp(dst_transform->scale, src_transform->scale, t);
+	}
+}
+
+void impl_poseComputeAdditive(uint32_t joint_count, const Amber_Transform *src_transforms, const Amber_Transform *src_reference_transforms, Amber_Transform *dst_transforms)
+{
+	assert(src_transforms);
+	assert(src_reference_transforms);
+	assert(dst_transforms);
 
-		for (uint32_t j = 0; j < 3; ++j)
-			free(curve->position_curves[j].keys);
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		const Amber_Transform *src_transform = &src_transforms[i];
+		const Amber_Transform *src_reference_transform = &src_reference_transforms[i];
 
-		for (uint32_t j = 0; j < 4; ++j)
-			free(curve->rotation_curves[j].keys);
+		Amber_Transform *dst_transform = &dst_transforms[i];
 
-		for (uint32_t j = 0; j < 3; ++j)
-			free(curve->scale_curves[j].keys);
+		dst_transform->position = amber_vec3Sub(src_transform->position, src_reference_transform->position);
+		dst_transform->rotation = amber_quatMul(amber_quatConjugate(src_reference_transform->rotation), src_transform->rotation);
+		dst_transform->scale = amber_vec3Div(src_transform->scale, src_reference_transform->scale);
 	}
+}
 
-	if (sequence_ptr->root_motion_curve)
+void impl_poseConvertToWorld(uint32_t joint_count, const int32_t *joint_parents, const Amber_Transform *src_transforms, Amber_Transform *dst_transforms)
+{
+	assert(joint_parents);
+	assert(src_transforms);
+	assert(dst_transforms);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
 	{
-		Impl_SequenceJointCurve *curve = sequence_ptr->root_motion_curve;
+		int32_t parent = joint_parents[i];
+		assert(parent < (int32_t)i);
+
+		if (parent == -1)
+			dst_transforms[i] = src_transforms[i];
+		else
+			dst_transforms[i] = amber_mulTransform(dst_transforms[parent], src_transforms[i]);
+	}
+}
 
-		for (uint32_t j = 0; j < 3; ++j)
-			free(curve->position_curves[j].keys);
+void impl_poseConvertToLocal(uint32_t joint_count, const int32_t *joint_parents, const Amber_Transform *src_transforms, Amber_Transform *dst_transforms)
+{
+	assert(joint_parents);
+	assert(src_transforms);
+	assert(dst_transforms);
 
-		for (uint32_t j = 0; j < 4; ++j)
-			free(curve->rotation_curves[j].keys);
+	for (int32_t i = (int32_t)joint_count - 1; i >= 0; --i)
+	{
+		int32_t parent = joint_parents[i];
+		assert(parent < i);
 
-		for (uint32_t j = 0; j < 3; ++j)
-			free(curve->scale_curves[j].keys);
+		if (parent == -1)
+			dst_transforms[i] = src_transforms[i];
+		else
+			dst_transforms[i] = amber_mulTransform(amber_invertTransform(src_transforms[parent]), src_transforms[i]);
 	}
+}
+
+float impl_sequenceFetchValue(const Impl_Sequence *sequence_ptr, const Impl_SequenceCurve *curve, float time)
+{
+	assert(sequence_ptr);
+	assert(sequence_ptr->keys);
 
-	free(sequence_ptr->joint_curves);
-	free(sequence_ptr->joint_indices);
+	return amber_fetchCurveValue(sequence_ptr->keys, curve, time);
 }
 
-/*
- */
-Amber_Result impl_instanceCreateArmature(Amber_Instance this, const Amber_ArmatureDesc *desc, Amber_Armature* armature)
+Amber_Transform impl_sequenceFetchRootMotion(const Impl_Sequence *sequence_ptr, float time)
 {
-	assert(this);
-	assert(desc);
-	assert(desc->joint_count > 0);
-	assert(desc->joint_parents);
-	assert(armature);
+	assert(sequence_ptr);
+	assert(sequence_ptr->keys);
+	assert(sequence_ptr->root_motion_curve);
 
-	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	return amber_fetchJointTransform(sequence_ptr->keys, sequence_ptr->root_motion_curve, time);
+}
 
-	for (uint32_t i = 0; i < desc->joint_count; ++i)
-		assert(desc->joint_parents[i] < (int32_t)i);
+// Note: 'first_transform' and 'last_transform' are only used if playback wrapped around, otherwise they may be NULL
+void impl_computeRootMotion(const Amber_Transform *prev_transform, const Amber_Transform *transform, const Amber_Transform *first_transform, const Amber_Transform *last_transform, Amber_Transform *dst_transform)
+{
+	assert(prev_transform);
+	assert(transform);
+	assert(dst_transform);
 
-	int32_t *parents = (int32_t*)malloc(sizeof(int32_t) * desc->joint_count);
-	memcpy(parents, desc->joint_parents, sizeof(int32_t) * desc->joint_count);
+	Amber_Transform result = {0};
 
-	char *name_memory = NULL;
-	uint32_t *name_offsets = NULL;
-	
-	if (desc->joint_names != NULL)
+	if (first_transform == NULL)
+	{
+		result.position = amber_vec3Sub(transform->position, prev_transform->position);
+		result.rotation = amber_quatMul(amber_quatConjugate(prev_transform->rotation), transform->rotation);
+		result.scale = amber_vec3Div(transform->scale, prev_transform->scale);
+	}
+	else
 	{
-		name_offsets = (uint32_t *)malloc(sizeof(uint32_t) * desc->joint_count);
+		assert(last_transform);
 
-		uint32_t total_length = 0;
-		for (uint32_t i = 0; i < desc->joint_count; ++i)
+		Amber_Transform temp_transform = {0};
+		temp_transform.position = amber_vec3Sub(last_transform->position, prev_transform->position);
+		temp_transform.rotation = amber_quatMul(amber_quatConjugate(prev_transform->rotation), last_transform->rotation);
+		temp_transform.scale = amber_vec3Div(last_transform->scale, prev_transform->scale);
+
+		result.position = amber_vec3Sub(transform->position, first_transform->position);
+		result.rotation = amber_quatMul(amber_quatConjugate(first_transform->rotation), transform->rotation);
+		result.scale = amber_vec3Div(transform->scale, first_transform->scale);
+
+		result.position = amber_vec3Add(result.position, temp_transform.position);
+		result.rotation = amber_quatMul(result.rotation, temp_transform.rotation);
+		result.scale = amber_vec3Mul(result.scale, temp_transform.scale);
+	}
+
+	*dst_transform = result;
+}
+
+void impl_sequenceSampleRootMotion(const Impl_Sequence *sequence_ptr, float prev_time, float time, Amber_Transform *dst_transform)
+{
+	assert(sequence_ptr);
+	assert(dst_transform);
+
+	if (sequence_ptr->stream)
+	{
+		impl_streamSampleRootMotion(sequence_ptr->stream, prev_time, time, dst_transform);
+		return;
+	}
+
+	if (sequence_ptr->cache_entry)
+	{
+		impl_cacheSampleRootMotion(sequence_ptr->cache_entry, prev_time, time, dst_transform);
+		return;
+	}
+
+	Amber_Transform result = (Amber_Transform)
+	{
+		0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f,
+		1.0f, 1.0f, 1.0f,
+	};
+
+	if (impl_isSequenceReady(sequence_ptr) && sequence_ptr->root_motion_curve)
+	{
+		const Impl_SequenceJointCurve *root_motion_curve = sequence_ptr->root_motion_curve;
+		const Amber_SequenceKey *keys = sequence_ptr->keys;
+
+		Amber_Transform transform = amber_fetchJointTransform(keys, root_motion_curve, time);
+		Amber_Transform prev_transform = amber_fetchJointTransform(keys, root_motion_curve, prev_time);
+
+		if (prev_time < time)
 		{
-			assert(desc->joint_names[i]);
-			name_offsets[i] = total_length;
-			total_length += (uint32_t)strlen(desc->joint_names[i]) + 1;
+			impl_computeRootMotion(&prev_transform, &transform, NULL, NULL, &result);
 		}
+		else
+		{
+			Amber_Transform first_transform = amber_fetchJointTransform(keys, root_motion_curve, root_motion_curve->min_time);
+			Amber_Transform last_transform = amber_fetchJointTransform(keys, root_motion_curve, root_motion_curve->max_time);
 
-		name_memory = (char *)malloc(sizeof(char) * total_length);
-		memset(name_memory, 0, sizeof(char) * total_length);
+			impl_computeRootMotion(&prev_transform, &transform, &first_transform, &last_transform, &result);
+		}
+	};
 
-		char *name_ptr = name_memory;
-		for (uint32_t i = 0; i < desc->joint_count; ++i)
-		{
-			uint32_t current = name_offsets[i];
-			uint32_t next = (i + 1 == desc->joint_count) ? total_length : name_offsets[i + 1];
+	*dst_transform = result;
+}
 
-			uint32_t length = next - current - 1;
-			assert(current < next);
+/*
+ */
+void *impl_allocateBlock(Impl_Instance *instance_ptr, uint64_t size, uint32_t ref_count, Amber_MemoryCategory category, Impl_Block **block)
+{
+	assert(instance_ptr);
+	assert(ref_count > 0);
+	assert(block);
 
-			memcpy(name_ptr, desc->joint_names[i], sizeof(char) * length);
-			name_ptr = &name_memory[next];
-		}
+	uint32_t header_size = alignUp(sizeof(Impl_Block), AMBER_SIMD_ALIGNMENT);
+
+	Impl_Block *result = (Impl_Block *)amber_allocatorAllocate(&instance_ptr->allocator, header_size + size, AMBER_SIMD_ALIGNMENT, category);
+	assert(result);
+
+	result->ref_count = ref_count;
+	result->category = category;
+	result->size = header_size + size;
+
+	*block = result;
+	return (uint8_t *)result + header_size;
+}
+
+void impl_releaseBlock(Impl_Instance *instance_ptr, Impl_Block *block)
+{
+	assert(instance_ptr);
+	assert(block);
+	assert(amber_atomicLoad32(&block->ref_count) > 0);
+
+	if (amber_atomicDecrement32(&block->ref_count) == 0)
+		amber_allocatorFree(&instance_ptr->allocator, block, block->size, block->category);
+}
+
+static void impl_destroyArmature(Impl_Instance *instance_ptr, Impl_Armature *armature_ptr)
+{
+	assert(instance_ptr);
+	assert(armature_ptr);
+
+	const Amber_Allocator *allocator = &instance_ptr->allocator;
+	uint32_t joint_count = armature_ptr->joint_count;
+
+	// Note: armatures loaded from a snapshot keep their joint data in the snapshot block or library
+	if (armature_ptr->library)
+	{
+		impl_releaseLibrary(armature_ptr->library);
+	}
+	else if (armature_ptr->block)
+	{
+		impl_releaseBlock(instance_ptr, armature_ptr->block);
+	}
+	else
+	{
+		amber_allocatorFree(allocator, armature_ptr->joint_name_memory, sizeof(char) * armature_ptr->joint_name_size, AMBER_MEMORY_CATEGORY_ARMATURE);
+		amber_allocatorFree(allocator, armature_ptr->joint_name_offsets, sizeof(uint32_t) * joint_count, AMBER_MEMORY_CATEGORY_ARMATURE);
+		amber_allocatorFree(allocator, armature_ptr->joint_parents, sizeof(int32_t) * joint_count, AMBER_MEMORY_CATEGORY_ARMATURE);
 	}
 
-	Impl_Armature result = {0};
-	result.joint_count = desc->joint_count;
-	result.joint_parents = parents;
-	result.joint_name_memory = name_memory;
-	result.joint_name_offsets = name_offsets;
+	if (armature_ptr->pose_slab_capacity > 0)
+		amber_slabShutdown(&armature_ptr->pose_slab);
+}
 
-	*armature = (Amber_Armature)amber_poolAddElement(&instance_ptr->armatures, &result);
-	return AMBER_SUCCESS;
+static AMBER_INLINE uint32_t impl_isArmatureAlive(const Impl_Armature *armature_ptr)
+{
+	return armature_ptr != NULL && amber_atomicLoad32(&armature_ptr->destroyed) == 0;
+}
+
+// Note: poses keep a pointer to their armature, so the armature (and its pool slot) is kept alive
+//       until the last pose referencing it is destroyed, even after amberDestroyArmature
+static AMBER_INLINE void impl_retainArmature(Impl_Armature *armature_ptr)
+{
+	assert(armature_ptr);
+	assert(amber_atomicLoad32(&armature_ptr->ref_count) > 0);
+	assert(!amber_atomicLoad32(&armature_ptr->destroyed));
+
+	amber_atomicIncrement32(&armature_ptr->ref_count);
+}
+
+static void impl_releaseArmature(Impl_Instance *instance_ptr, Impl_Armature *armature_ptr)
+{
+	assert(instance_ptr);
+	assert(armature_ptr);
+	assert(amber_atomicLoad32(&armature_ptr->ref_count) > 0);
+
+	if (amber_atomicDecrement32(&armature_ptr->ref_count) > 0)
+		return;
+
+	Amber_PoolHandle handle = armature_ptr->handle;
+
+	impl_destroyArmature(instance_ptr, armature_ptr);
+	amber_poolRemoveElement(&instance_ptr->armatures, handle);
+}
+
+static void impl_destroyPose(Impl_Instance *instance_ptr, Impl_Pose *pose_ptr)
+{
+	assert(instance_ptr);
+	assert(pose_ptr);
+
+	if (pose_ptr->block)
+	{
+		impl_releaseBlock(instance_ptr, pose_ptr->block);
+		return;
+	}
+
+	if (!pose_ptr->slab_allocated)
+	{
+		amber_allocatorFree(&instance_ptr->allocator, pose_ptr->transforms, sizeof(Amber_Transform) * pose_ptr->joint_count, AMBER_MEMORY_CATEGORY_POSE);
+		return;
+	}
+
+	Impl_Armature *armature_ptr = pose_ptr->armature_ptr;
+	assert(armature_ptr);
+	assert(armature_ptr->pose_slab_capacity > 0);
+
+	amber_slabFree(&armature_ptr->pose_slab, pose_ptr->transforms);
+}
+
+void impl_waitSequence(Impl_Instance *instance_ptr, const Impl_Sequence *sequence_ptr)
+{
+	assert(instance_ptr);
+	assert(sequence_ptr);
+
+	if (!impl_isSequenceReady(sequence_ptr))
+		amber_loaderWait(&instance_ptr->loader, sequence_ptr->fence);
+
+	assert(impl_isSequenceReady(sequence_ptr));
+}
+
+// Note: sequences created from memory have no block, the blob is owned by the application
+static void impl_destroySequence(Impl_Instance *instance_ptr, Impl_Sequence *sequence_ptr)
+{
+	assert(instance_ptr);
+	assert(sequence_ptr);
+
+	impl_waitSequence(instance_ptr, sequence_ptr);
+
+	if (sequence_ptr->stream)
+		impl_destroyStream(instance_ptr, sequence_ptr->stream);
+
+	if (sequence_ptr->cache_entry)
+		impl_destroyCacheEntry(instance_ptr, sequence_ptr->cache_entry);
+
+	if (sequence_ptr->block)
+		impl_releaseBlock(instance_ptr, sequence_ptr->block);
+
+	if (sequence_ptr->library)
+		impl_releaseLibrary(sequence_ptr->library);
+}
+
+/*
+ */
+static uint64_t impl_getSequenceJointCurveKeyCount(const Amber_SequenceJointCurve *curve)
+{
+	assert(curve);
+
+	uint64_t result = 0;
+
+	for (uint32_t i = 0; i < 3; ++i)
+		result += curve->position_curves[i].key_count;
+
+	for (uint32_t i = 0; i < 4; ++i)
+		result += curve->rotation_curves[i].key_count;
+
+	for (uint32_t i = 0; i < 3; ++i)
+		result += curve->scale_curves[i].key_count;
+
+	return result;
+}
+
+uint64_t impl_getSequenceMemorySize(const Amber_SequenceDesc *desc)
+{
+	assert(desc);
+
+	uint32_t curve_count = desc->joint_count + ((desc->root_motion_curve) ? 1 : 0);
+	uint64_t key_count = 0;
+
+	for (uint32_t i = 0; i < desc->joint_count; ++i)
+		key_count += impl_getSequenceJointCurveKeyCount(&desc->joint_curves[i]);
+
+	if (desc->root_motion_curve)
+		key_count += impl_getSequenceJointCurveKeyCount(desc->root_motion_curve);
+
+	uint64_t size = 0;
+	size += alignUpul(sizeof(Impl_SequenceBlobHeader), AMBER_DEFAULT_ALIGNMENT);
+	size += alignUpul(sizeof(Impl_SequenceJointCurve) * curve_count, AMBER_DEFAULT_ALIGNMENT);
+	size += alignUpul(sizeof(uint32_t) * desc->joint_count, AMBER_DEFAULT_ALIGNMENT);
+	size += alignUpul(sizeof(Amber_SequenceKey) * key_count, AMBER_SIMD_ALIGNMENT);
+
+	return size;
+}
+
+static void impl_copySequenceJointCurve(const Amber_SequenceJointCurve *src_joint_curve, Impl_SequenceJointCurve *dst_joint_curve, Amber_SequenceKey *keys, uint32_t *key_count, float *min_time, float *max_time)
+{
+	assert(src_joint_curve);
+	assert(dst_joint_curve);
+	assert(keys);
+	assert(key_count);
+	assert(min_time);
+	assert(max_time);
+
+	float curve_min_time = FLT_MAX;
+	float curve_max_time = -FLT_MAX;
+
+	const Amber_SequenceCurve *src_curves[10] =
+	{
+		&src_joint_curve->position_curves[0],
+		&src_joint_curve->position_curves[1],
+		&src_joint_curve->position_curves[2],
+
+		&src_joint_curve->rotation_curves[0],
+		&src_joint_curve->rotation_curves[1],
+		&src_joint_curve->rotation_curves[2],
+		&src_joint_curve->rotation_curves[3],
+
+		&src_joint_curve->scale_curves[0],
+		&src_joint_curve->scale_curves[1],
+		&src_joint_curve->scale_curves[2],
+	};
+
+	Impl_SequenceCurve *dst_curves[10] =
+	{
+		&dst_joint_curve->position_curves[0],
+		&dst_joint_curve->position_curves[1],
+		&dst_joint_curve->position_curves[2],
+
+		&dst_joint_curve->rotation_curves[0],
+		&dst_joint_curve->rotation_curves[1],
+		&dst_joint_curve->rotation_curves[2],
+		&dst_joint_curve->rotation_curves[3],
+
+		&dst_joint_curve->scale_curves[0],
+		&dst_joint_curve->scale_curves[1],
+		&dst_joint_curve->scale_curves[2],
+	};
+
+	memset(dst_joint_curve, 0, sizeof(Impl_SequenceJointCurve));
+
+	for (uint32_t j = 0; j < 10; ++j)
+	{
+		const Amber_SequenceCurve *src_curve = src_curves[j];
+		Impl_SequenceCurve *dst_curve = dst_curves[j];
+
+		if (src_curve->key_count == 0)
+			continue;
+
+		dst_curve->key_count = src_curve->key_count;
+		dst_curve->first_key = *key_count;
+		*key_count += src_curve->key_count;
+
+		for (uint32_t k = 0; k < src_curve->key_count; ++k)
+		{
+			keys[dst_curve->first_key + k] = src_curve->keys[k];
+
+			float time = src_curve->keys[k].time;
+			curve_min_time = amber_floatMin(curve_min_time, time);
+			curve_max_time = amber_floatMax(curve_max_time, time);
+		}
+	}
+
+	dst_joint_curve->min_time = curve_min_time;
+	dst_joint_curve->max_time = curve_max_time;
+
+	*min_time = amber_floatMin(*min_time, curve_min_time);
+	*max_time = amber_floatMax(*max_time, curve_max_time);
+}
+
+void impl_bindSequence(const Impl_SequenceBlobHeader *blob, Amber_Armature armature, Impl_Block *block, Impl_Sequence *sequence_ptr)
+{
+	assert(blob);
+	assert(blob->joint_count > 0);
+	assert(sequence_ptr);
+
+	const uint8_t *memory = (const uint8_t *)blob;
+	const Impl_SequenceJointCurve *joint_curves = (const Impl_SequenceJointCurve *)(memory + blob->joint_curves_offset);
+
+	memset(sequence_ptr, 0, sizeof(Impl_Sequence));
+	sequence_ptr->armature = armature;
+	sequence_ptr->joint_count = blob->joint_count;
+	sequence_ptr->joint_indices = (const uint32_t *)(memory + blob->joint_indices_offset);
+	sequence_ptr->joint_curves = joint_curves;
+	sequence_ptr->root_motion_curve = (blob->flags & IMPL_SEQUENCE_BLOB_FLAG_ROOT_MOTION) ? &joint_curves[blob->joint_count] : NULL;
+	sequence_ptr->keys = (const Amber_SequenceKey *)(memory + blob->keys_offset);
+	sequence_ptr->blob = blob;
+	sequence_ptr->min_time = blob->min_time;
+	sequence_ptr->max_time = blob->max_time;
+	sequence_ptr->block = block;
+}
+
+// Note: the header, joint indices and curve key ranges are checked, so the cost scales with the joint count
+//       and key pages are never touched. Key values are trusted, they can't address memory.
+Amber_Result impl_validateSequenceBlob(const void *data, uint64_t size, uint32_t armature_joint_count)
+{
+	if (data == NULL || ((uintptr_t)data & (AMBER_DEFAULT_ALIGNMENT - 1)) != 0)
+		return AMBER_INVALID_DATA;
+
+	if (size < sizeof(Impl_SequenceBlobHeader))
+		return AMBER_INVALID_DATA;
+
+	const Impl_SequenceBlobHeader *blob = (const Impl_SequenceBlobHeader *)data;
+
+	if (blob->magic != IMPL_SEQUENCE_BLOB_MAGIC || blob->version != IMPL_SEQUENCE_BLOB_VERSION)
+		return AMBER_INVALID_DATA;
+
+	if (blob->size > size || blob->joint_count == 0)
+		return AMBER_INVALID_DATA;
+
+	uint64_t curve_count = blob->joint_count + ((blob->flags & IMPL_SEQUENCE_BLOB_FLAG_ROOT_MOTION) ? 1 : 0);
+
+	uint64_t ranges[3][2] =
+	{
+		{blob->joint_curves_offset, sizeof(Impl_SequenceJointCurve) * curve_count},
+		{blob->joint_indices_offset, sizeof(uint32_t) * blob->joint_count},
+		{blob->keys_offset, sizeof(Amber_SequenceKey) * blob->key_count},
+	};
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		uint64_t offset = ranges[i][0];
+		uint64_t range_size = ranges[i][1];
+
+		if ((offset & (sizeof(uint32_t) - 1)) != 0)
+			return AMBER_INVALID_DATA;
+
+		if (offset < sizeof(Impl_SequenceBlobHeader) || offset > blob->size || range_size > blob->size - offset)
+			return AMBER_INVALID_DATA;
+	}
+
+	const uint8_t *memory = (const uint8_t *)data;
+	const uint32_t *joint_indices = (const uint32_t *)(memory + blob->joint_indices_offset);
+
+	for (uint32_t i = 0; i < blob->joint_count; ++i)
+		if (joint_indices[i] >= armature_joint_count)
+			return AMBER_INVALID_DATA;
+
+	const Impl_SequenceJointCurve *joint_curves = (const Impl_SequenceJointCurve *)(memory + blob->joint_curves_offset);
+
+	for (uint64_t i = 0; i < curve_count; ++i)
+	{
+		const Impl_SequenceCurve *curves = (const Impl_SequenceCurve *)&joint_curves[i];
+
+		for (uint32_t j = 0; j < 10; ++j)
+			if (curves[j].first_key > blob->key_count || curves[j].key_count > blob->key_count - curves[j].first_key)
+				return AMBER_INVALID_DATA;
+	}
+
+	return AMBER_SUCCESS;
+}
+
+// Note: all sequence data (header, curves, joint indices and keys) is laid out in one contiguous region,
+//       which is the same relocatable blob accepted by amberCreateSequenceFromMemory
+const Impl_SequenceBlobHeader *impl_writeSequenceBlob(const Amber_SequenceDesc *desc, uint8_t *memory)
+{
+	assert(desc);
+	assert(desc->joint_count > 0);
+	assert(desc->joint_indices);
+	assert(desc->joint_curves);
+	assert(memory);
+
+	uint32_t curve_count = desc->joint_count + ((desc->root_motion_curve) ? 1 : 0);
+
+	Impl_SequenceBlobHeader *blob = (Impl_SequenceBlobHeader *)memory;
+	uint64_t offset = alignUpul(sizeof(Impl_SequenceBlobHeader), AMBER_DEFAULT_ALIGNMENT);
+
+	uint64_t joint_curves_offset = offset;
+	offset += alignUpul(sizeof(Impl_SequenceJointCurve) * curve_count, AMBER_DEFAULT_ALIGNMENT);
+
+	uint64_t joint_indices_offset = offset;
+	offset += alignUpul(sizeof(uint32_t) * desc->joint_count, AMBER_DEFAULT_ALIGNMENT);
+
+	uint64_t keys_offset = offset;
+
+	Impl_SequenceJointCurve *joint_curves = (Impl_SequenceJointCurve *)(memory + joint_curves_offset);
+	uint32_t *joint_indices = (uint32_t *)(memory + joint_indices_offset);
+	Amber_SequenceKey *keys = (Amber_SequenceKey *)(memory + keys_offset);
+
+	memcpy(joint_indices, desc->joint_indices, sizeof(uint32_t) * desc->joint_count);
+
+	float sequence_min_time = FLT_MAX;
+	float sequence_max_time = -FLT_MAX;
+	uint32_t key_count = 0;
+
+	for (uint32_t i = 0; i < desc->joint_count; ++i)
+		impl_copySequenceJointCurve(&desc->joint_curves[i], &joint_curves[i], keys, &key_count, &sequence_min_time, &sequence_max_time);
+
+	if (desc->root_motion_curve)
+		impl_copySequenceJointCurve(desc->root_motion_curve, &joint_curves[desc->joint_count], keys, &key_count, &sequence_min_time, &sequence_max_time);
+
+	memset(blob, 0, sizeof(Impl_SequenceBlobHeader));
+	blob->magic = IMPL_SEQUENCE_BLOB_MAGIC;
+	blob->version = IMPL_SEQUENCE_BLOB_VERSION;
+	blob->size = keys_offset + alignUpul(sizeof(Amber_SequenceKey) * key_count, AMBER_SIMD_ALIGNMENT);
+	blob->joint_count = desc->joint_count;
+	blob->flags = (desc->root_motion_curve) ? IMPL_SEQUENCE_BLOB_FLAG_ROOT_MOTION : 0;
+	blob->key_count = key_count;
+	blob->min_time = sequence_min_time;
+	blob->max_time = sequence_max_time;
+	blob->joint_curves_offset = joint_curves_offset;
+	blob->joint_indices_offset = joint_indices_offset;
+	blob->keys_offset = keys_offset;
+
+	return blob;
+}
+
+static void impl_initializeSequence(const Amber_SequenceDesc *desc, uint8_t *memory, Impl_Block *block, Impl_Sequence *sequence_ptr)
+{
+	assert(desc);
+	assert(memory);
+	assert(block);
+	assert(sequence_ptr);
+
+	const Impl_SequenceBlobHeader *blob = impl_writeSequenceBlob(desc, memory);
+	impl_bindSequence(blob, desc->armature, block, sequence_ptr);
+}
+
+/*
+ */
+Amber_Result impl_instanceReserveCapacity(Amber_Instance this, const Amber_CapacityDesc *desc)
+{
+	assert(this);
+	assert(desc);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	amber_poolReserve(&instance_ptr->armatures, desc->armature_count);
+	amber_poolReserve(&instance_ptr->poses, desc->pose_count);
+	amber_poolReserve(&instance_ptr->sequences, desc->sequence_count);
+	amber_poolReserve(&instance_ptr->graphs, desc->graph_count);
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+Amber_Result impl_instanceCreateArmature(Amber_Instance this, const Amber_ArmatureDesc *desc, Amber_Armature* armature)
+{
+	assert(this);
+	assert(desc);
+	assert(desc->joint_count > 0);
+	assert(desc->joint_parents);
+	assert(armature);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	for (uint32_t i = 0; i < desc->joint_count; ++i)
+		assert(desc->joint_parents[i] < (int32_t)i);
+
+	const Amber_Allocator *allocator = &instance_ptr->allocator;
+
+	int32_t *parents = (int32_t*)amber_allocatorAllocate(allocator, sizeof(int32_t) * desc->joint_count, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_ARMATURE);
+	memcpy(parents, desc->joint_parents, sizeof(int32_t) * desc->joint_count);
+
+	char *name_memory = NULL;
+	uint32_t *name_offsets = NULL;
+	uint32_t name_size = 0;
+	
+	if (desc->joint_names != NULL)
+	{
+		name_offsets = (uint32_t *)amber_allocatorAllocate(allocator, sizeof(uint32_t) * desc->joint_count, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_ARMATURE);
+
+		uint32_t total_length = 0;
+		for (uint32_t i = 0; i < desc->joint_count; ++i)
+		{
+			assert(desc->joint_names[i]);
+			name_offsets[i] = total_length;
+			total_length += (uint32_t)strlen(desc->joint_names[i]) + 1;
+		}
+
+		name_size = total_length;
+		name_memory = (char *)amber_allocatorAllocate(allocator, sizeof(char) * total_length, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_ARMATURE);
+		memset(name_memory, 0, sizeof(char) * total_length);
+
+		char *name_ptr = name_memory;
+		for (uint32_t i = 0; i < desc->joint_count; ++i)
+		{
+			uint32_t current = name_offsets[i];
+			uint32_t next = (i + 1 == desc->joint_count) ? total_length : name_offsets[i + 1];
+
+			uint32_t length = next - current - 1;
+			assert(current < next);
+
+			memcpy(name_ptr, desc->joint_names[i], sizeof(char) * length);
+			name_ptr = &name_memory[next];
+		}
+	}
+
+	Impl_Armature result = {0};
+	result.joint_count = desc->joint_count;
+	result.joint_parents = parents;
+	result.joint_name_memory = name_memory;
+	result.joint_name_offsets = name_offsets;
+	result.joint_name_size = name_size;
+	result.pose_stride = alignUp(sizeof(Amber_Transform) * desc->joint_count, AMBER_SIMD_ALIGNMENT);
+	result.pose_slab_capacity = desc->pose_slab_capacity;
+
+	result.ref_count = 1;
+
+	Amber_PoolHandle handle = amber_poolAddElement(&instance_ptr->armatures, &result);
+
+	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, handle);
+	armature_ptr->handle = handle;
+
+	if (desc->pose_slab_capacity > 0)
+		amber_slabInitialize(&armature_ptr->pose_slab, allocator, armature_ptr->pose_stride, desc->pose_slab_capacity, AMBER_MEMORY_CATEGORY_POSE);
+
+	*armature = (Amber_Armature)handle;
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceCreatePose(Amber_Instance this, const Amber_PoseDesc *desc, Amber_Pose *pose)
+{
+	assert(this);
+	assert(desc);
+	assert(pose);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)desc->armature);
+
+	if (!impl_isArmatureAlive(armature_ptr))
+		return AMBER_INVALID_HANDLE;
+
+	assert(armature_ptr->joint_count > 0);
+	assert(armature_ptr->joint_parents);
+
+	uint32_t slab_allocated = (armature_ptr->pose_slab_capacity > 0);
+	Amber_Transform *transforms = NULL;
+
+	if (slab_allocated)
+		transforms = (Amber_Transform *)amber_slabAllocate(&armature_ptr->pose_slab);
+	else
+		transforms = (Amber_Transform *)amber_allocatorAllocate(&instance_ptr->allocator, sizeof(Amber_Transform) * armature_ptr->joint_count, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_POSE);
+
+	if (desc->joint_transforms)
+	{
+		assert(armature_ptr->joint_count == desc->joint_count);
+		memcpy(transforms, desc->joint_transforms, sizeof(Amber_Transform) * armature_ptr->joint_count);
+	}
+	else
+		memset(transforms, 0, sizeof(Amber_Transform) * armature_ptr->joint_count);
+
+	impl_retainArmature(armature_ptr);
+
+	Impl_Pose result = {0};
+	result.armature = desc->armature;
+	result.armature_ptr = armature_ptr;
+	result.joint_count = armature_ptr->joint_count;
+	result.slab_allocated = slab_allocated;
+	result.transforms = transforms;
+	
+	*pose = (Amber_Pose)amber_poolAddElement(&instance_ptr->poses, &result);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceCreatePoses(Amber_Instance this, uint32_t pose_count, const Amber_PoseDesc *descs, Amber_Pose *poses)
+{
+	assert(this);
+	assert(pose_count == 0 || descs);
+	assert(pose_count == 0 || poses);
+
+	if (pose_count == 0)
+		return AMBER_SUCCESS;
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	// Note: descs usually share one armature, so lookups are only repeated when it changes
+	Amber_Armature cached_armature = AMBER_NULL_HANDLE;
+	Impl_Armature *armature_ptr = NULL;
+
+	uint64_t total_size = 0;
+	uint32_t block_pose_count = 0;
+
+	for (uint32_t i = 0; i < pose_count; ++i)
+	{
+		if (descs[i].armature != cached_armature)
+		{
+			cached_armature = descs[i].armature;
+			armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)cached_armature);
+		}
+
+		// Note: every armature is checked before anything is allocated or retained
+		if (!impl_isArmatureAlive(armature_ptr))
+			return AMBER_INVALID_HANDLE;
+
+		assert(armature_ptr->joint_count > 0);
+
+		if (armature_ptr->pose_slab_capacity > 0)
+			continue;
+
+		total_size += armature_ptr->pose_stride;
+		block_pose_count++;
+	}
+
+	Impl_Block *block = NULL;
+	uint8_t *memory = NULL;
+
+	if (block_pose_count > 0)
+		memory = (uint8_t *)impl_allocateBlock(instance_ptr, total_size, block_pose_count, AMBER_MEMORY_CATEGORY_POSE, &block);
+
+	amber_poolReserve(&instance_ptr->poses, amber_poolGetSize(&instance_ptr->poses) + pose_count);
+
+	cached_armature = AMBER_NULL_HANDLE;
+	armature_ptr = NULL;
+
+	for (uint32_t i = 0; i < pose_count; ++i)
+	{
+		const Amber_PoseDesc *desc = &descs[i];
+
+		if (desc->armature != cached_armature)
+		{
+			cached_armature = desc->armature;
+			armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)cached_armature);
+		}
+
+		impl_retainArmature(armature_ptr);
+
+		Impl_Pose result = {0};
+		result.armature = desc->armature;
+		result.armature_ptr = armature_ptr;
+		result.joint_count = armature_ptr->joint_count;
+
+		if (armature_ptr->pose_slab_capacity > 0)
+		{
+			result.slab_allocated = 1;
+			result.transforms = (Amber_Transform *)amber_slabAllocate(&armature_ptr->pose_slab);
+		}
+		else
+		{
+			result.block = block;
+			result.transforms = (Amber_Transform *)memory;
+			memory += armature_ptr->pose_stride;
+		}
+
+		if (desc->joint_transforms)
+		{
+			assert(armature_ptr->joint_count == desc->joint_count);
+			memcpy(result.transforms, desc->joint_transforms, sizeof(Amber_Transform) * armature_ptr->joint_count);
+		}
+		else
+			memset(result.transforms, 0, sizeof(Amber_Transform) * armature_ptr->joint_count);
+
+		poses[i] = (Amber_Pose)amber_poolAddElement(&instance_ptr->poses, &result);
+	}
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceCreateTransientPose(Amber_Instance this, const Amber_PoseDesc *desc, Amber_Pose *pose)
+{
+	assert(this);
+	assert(desc);
+	assert(pose);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)desc->armature);
+	assert(armature_ptr);
+	assert(armature_ptr->joint_count > 0);
+	assert(armature_ptr->joint_parents);
+
+	// Note: records are claimed with a compare-exchange which never moves the count past the capacity,
+	//       the epoch already rejects handles of previous frames
+	uint32_t index = 0;
+
+	do
+	{
+		index = amber_atomicLoad32(&instance_ptr->transient_pose_count);
+
+		if (index >= IMPL_TRANSIENT_POSE_CAPACITY)
+			return AMBER_INTERNAL_ERROR;
+	}
+	while (!amber_atomicCompareExchange32(&instance_ptr->transient_pose_count, index, index + 1));
+
+	uint32_t page_index = index >> IMPL_TRANSIENT_PAGE_SHIFT;
+
+	// Note: transient poses don't retain their armature, so that reset doesn't have to visit them
+	uint32_t size = sizeof(Amber_Transform) * armature_ptr->joint_count;
+
+	amber_spinLockAcquire(&instance_ptr->transient_lock);
+
+	Amber_Transform *transforms = (Amber_Transform *)amber_arenaAllocate(&instance_ptr->transient_arena, size, AMBER_SIMD_ALIGNMENT);
+
+	if (instance_ptr->transient_pages[page_index] == NULL)
+	{
+		instance_ptr->transient_pages[page_index] = (Impl_Pose *)amber_allocatorAllocate(&instance_ptr->allocator, sizeof(Impl_Pose) * IMPL_TRANSIENT_PAGE_SIZE, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_TRANSIENT);
+		assert(instance_ptr->transient_pages[page_index]);
+
+		amber_atomicIncrement32(&instance_ptr->transient_page_count);
+	}
+
+	Impl_Pose *result = &instance_ptr->transient_pages[page_index][index & IMPL_TRANSIENT_PAGE_MASK];
+
+	amber_spinLockRelease(&instance_ptr->transient_lock);
+
+	if (desc->joint_transforms)
+	{
+		assert(armature_ptr->joint_count == desc->joint_count);
+		memcpy(transforms, desc->joint_transforms, size);
+	}
+	else
+		memset(transforms, 0, size);
+
+	memset(result, 0, sizeof(Impl_Pose));
+	result->armature = desc->armature;
+	result->armature_ptr = armature_ptr;
+	result->joint_count = armature_ptr->joint_count;
+	result->transforms = transforms;
+
+	*pose = impl_packTransientPose(instance_ptr->transient_epoch, index);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceCreateSequences(Amber_Instance this, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Sequence *sequences)
+{
+	assert(this);
+	assert(sequence_count == 0 || descs);
+	assert(sequence_count == 0 || sequences);
+
+	if (sequence_count == 0)
+		return AMBER_SUCCESS;
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberCreateSequences");
+
+	uint64_t total_size = 0;
+	for (uint32_t i = 0; i < sequence_count; ++i)
+		total_size += impl_getSequenceMemorySize(&descs[i]);
+
+	Impl_Block *block = NULL;
+	uint8_t *memory = (uint8_t *)impl_allocateBlock(instance_ptr, total_size, sequence_count, AMBER_MEMORY_CATEGORY_SEQUENCE, &block);
+
+	amber_poolReserve(&instance_ptr->sequences, amber_poolGetSize(&instance_ptr->sequences) + sequence_count);
+
+	for (uint32_t i = 0; i < sequence_count; ++i)
+	{
+		Impl_Sequence result;
+		impl_initializeSequence(&descs[i], memory, block, &result);
+		memory += impl_getSequenceMemorySize(&descs[i]);
+
+		sequences[i] = (Amber_Sequence)amber_poolAddElement(&instance_ptr->sequences, &result);
+	}
+
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberCreateSequences");
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceCreateSequence(Amber_Instance this, const Amber_SequenceDesc *desc, Amber_Sequence *sequence)
+{
+	assert(this);
+	assert(desc);
+	assert(sequence);
+
+	return impl_instanceCreateSequences(this, 1, desc, sequence);
+}
+
+Amber_Result impl_instanceCreateSequenceFromMemory(Amber_Instance this, const Amber_SequenceMemoryDesc *desc, Amber_Sequence *sequence)
+{
+	assert(this);
+	assert(desc);
+	assert(sequence);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Armature *armature_ptr = (const Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)desc->armature);
+	assert(armature_ptr);
+
+	Amber_Result result = impl_validateSequenceBlob(desc->data, desc->size, armature_ptr->joint_count);
+	if (result != AMBER_SUCCESS)
+		return result;
+
+	Impl_Sequence sequence_ptr;
+	impl_bindSequence((const Impl_SequenceBlobHeader *)desc->data, desc->armature, NULL, &sequence_ptr);
+
+	*sequence = (Amber_Sequence)amber_poolAddElement(&instance_ptr->sequences, &sequence_ptr);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceSerializeSequence(Amber_Instance this, Amber_Sequence sequence, uint64_t *size, void *data)
+{
+	assert(this);
+	assert(sequence);
+	assert(size);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Sequence *sequence_ptr = (const Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequence);
+	assert(sequence_ptr);
+
+	impl_waitSequence(instance_ptr, sequence_ptr);
+
+	if (sequence_ptr->stream)
+		return AMBER_NOT_IMPLEMENTED;
+
+	Impl_CacheEntry *cache_entry = sequence_ptr->cache_entry;
+
+	if (cache_entry)
+	{
+		if (data == NULL)
+		{
+			*size = cache_entry->size;
+			return AMBER_SUCCESS;
+		}
+
+		sequence_ptr = impl_cacheAcquire(cache_entry);
+		if (sequence_ptr == NULL)
+			return AMBER_INVALID_DATA;
+	}
+
+	assert(sequence_ptr->blob);
+
+	uint64_t blob_size = sequence_ptr->blob->size;
+	Amber_Result result = AMBER_SUCCESS;
+
+	if (data == NULL)
+	{
+		*size = blob_size;
+	}
+	else if (*size < blob_size)
+	{
+		result = AMBER_INVALID_OUTPUT_ARGUMENT;
+	}
+	else
+	{
+		memcpy(data, sequence_ptr->blob, blob_size);
+		*size = blob_size;
+	}
+
+	if (cache_entry)
+		impl_cacheRelease(cache_entry);
+
+	return result;
+}
+
+/*
+ */
+typedef struct Impl_SequenceLoad_t
+{
+	Amber_LoaderTask task;
+	Impl_Instance *instance_ptr;
+	uint32_t sequence_count;
+	const Amber_SequenceDesc *descs;
+	Amber_PoolHandle *handles;
+	uint8_t *memory;
+} Impl_SequenceLoad;
+
+static AMBER_INLINE uint64_t impl_getSequenceLoadSize(uint32_t sequence_count)
+{
+	return alignUpul(sizeof(Impl_SequenceLoad), AMBER_DEFAULT_ALIGNMENT) + sizeof(Amber_PoolHandle) * sequence_count;
 }
 
-Amber_Result impl_instanceCreatePose(Amber_Instance this, const Amber_PoseDesc *desc, Amber_Pose *pose)
+// Note: runs on the loader thread, placeholders are never destroyed before their fence completes
+static void impl_sequenceLoadTask(void *data)
 {
-	assert(this);
-	assert(desc);
-	assert(pose);
+	Impl_SequenceLoad *load = (Impl_SequenceLoad *)data;
+	assert(load);
 
-	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)desc->armature);
-	assert(armature_ptr);
-	assert(armature_ptr->joint_count > 0);
-	assert(armature_ptr->joint_parents);
+	Impl_Instance *instance_ptr = load->instance_ptr;
+	assert(instance_ptr);
 
-	Amber_Transform *transforms = (Amber_Transform *)malloc(sizeof(Amber_Transform) * armature_ptr->joint_count);
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberLoadSequences");
 
-	if (desc->joint_transforms)
+	uint8_t *memory = load->memory;
+
+	for (uint32_t i = 0; i < load->sequence_count; ++i)
 	{
-		assert(armature_ptr->joint_count == desc->joint_count);
-		memcpy(transforms, desc->joint_transforms, sizeof(Amber_Transform) * armature_ptr->joint_count);
+		const Amber_SequenceDesc *desc = &load->descs[i];
+
+		Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, load->handles[i]);
+		assert(sequence_ptr);
+		assert(!impl_isSequenceReady(sequence_ptr));
+
+		Impl_Sequence result;
+		impl_initializeSequence(desc, memory, sequence_ptr->block, &result);
+		memory += impl_getSequenceMemorySize(desc);
+
+		sequence_ptr->joint_indices = result.joint_indices;
+		sequence_ptr->joint_curves = result.joint_curves;
+		sequence_ptr->root_motion_curve = result.root_motion_curve;
+		sequence_ptr->keys = result.keys;
+		sequence_ptr->blob = result.blob;
+		sequence_ptr->min_time = result.min_time;
+		sequence_ptr->max_time = result.max_time;
+
+		amber_atomicStore32(&sequence_ptr->state, IMPL_SEQUENCE_STATE_READY);
 	}
-	else
-		memset(transforms, 0, sizeof(Amber_Transform) * armature_ptr->joint_count);
 
-	Impl_Pose result = {0};
-	result.armature = desc->armature;
-	result.transforms = transforms;
-	
-	*pose = (Amber_Pose)amber_poolAddElement(&instance_ptr->poses, &result);
-	return AMBER_SUCCESS;
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberLoadSequences");
+
+	amber_allocatorFree(&instance_ptr->allocator, load, impl_getSequenceLoadSize(load->sequence_count), AMBER_MEMORY_CATEGORY_SEQUENCE);
 }
 
-Amber_Result impl_instanceCreateSequence(Amber_Instance this, const Amber_SequenceDesc *desc, Amber_Sequence *sequence)
+// Note: only sizes are computed and memory is reserved here, keys are copied and scanned on the loader thread
+Amber_Result impl_instanceCreateSequencesAsync(Amber_Instance this, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Pose fallback_pose, Amber_Sequence *sequences, uint64_t *fence)
 {
 	assert(this);
-	assert(desc);
-	assert(desc->joint_count > 0);
-	assert(desc->joint_indices);
-	assert(desc->joint_curves);
-	assert(sequence);
+	assert(sequence_count == 0 || descs);
+	assert(sequence_count == 0 || sequences);
+	assert(fence);
 
-	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	*fence = 0;
 
-	uint32_t *joint_indices = (uint32_t *)malloc(sizeof(uint32_t) * desc->joint_count);
-	memcpy(joint_indices, desc->joint_indices, sizeof(uint32_t) * desc->joint_count);
+	if (sequence_count == 0)
+		return AMBER_SUCCESS;
 
-	Impl_SequenceJointCurve *joint_curves = (Impl_SequenceJointCurve *)malloc(sizeof(Impl_SequenceJointCurve) * desc->joint_count);
-	memset(joint_curves, 0, sizeof(Impl_SequenceJointCurve) * desc->joint_count);
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
 
-	Impl_SequenceJointCurve *root_motion_curve = NULL;
-	
-	float sequence_min_time = FLT_MAX;
-	float sequence_max_time = -FLT_MAX;
+	const Impl_Pose *fallback_pose_ptr = NULL;
+	uint32_t fallback_joint_count = 0;
 
-	for (uint32_t i = 0; i < desc->joint_count; ++i)
+	if (fallback_pose != AMBER_NULL_HANDLE)
 	{
-		float curve_min_time = FLT_MAX;
-		float curve_max_time = -FLT_MAX;
+		fallback_pose_ptr = impl_getPose(instance_ptr, fallback_pose);
+		assert(fallback_pose_ptr);
+		assert(fallback_pose_ptr->transforms);
 
-		const Amber_SequenceJointCurve *src_joint_curve = &desc->joint_curves[i];
-		Impl_SequenceJointCurve *dst_joint_curve = &joint_curves[i];
+		fallback_joint_count = fallback_pose_ptr->joint_count;
+	}
 
-		const Amber_SequenceCurve *src_curves[10] =
-		{
-			&src_joint_curve->position_curves[0],
-			&src_joint_curve->position_curves[1],
-			&src_joint_curve->position_curves[2],
+	uint64_t fallback_size = alignUpul(sizeof(Amber_Transform) * fallback_joint_count, AMBER_SIMD_ALIGNMENT);
+	uint64_t total_size = fallback_size;
 
-			&src_joint_curve->rotation_curves[0],
-			&src_joint_curve->rotation_curves[1],
-			&src_joint_curve->rotation_curves[2],
-			&src_joint_curve->rotation_curves[3],
+	for (uint32_t i = 0; i < sequence_count; ++i)
+		total_size += impl_getSequenceMemorySize(&descs[i]);
 
-			&src_joint_curve->scale_curves[0],
-			&src_joint_curve->scale_curves[1],
-			&src_joint_curve->scale_curves[2],
-		};
+	Impl_Block *block = NULL;
+	uint8_t *memory = (uint8_t *)impl_allocateBlock(instance_ptr, total_size, sequence_count, AMBER_MEMORY_CATEGORY_SEQUENCE, &block);
 
-		Impl_SequenceCurve *dst_curves[10] =
-		{
-			&dst_joint_curve->position_curves[0],
-			&dst_joint_curve->position_curves[1],
-			&dst_joint_curve->position_curves[2],
+	// Note: fallback transforms are a copy shared by all sequences of the call, so the fallback pose
+	//       itself may be modified or destroyed right away
+	Amber_Transform *fallback_transforms = NULL;
 
-			&dst_joint_curve->rotation_curves[0],
-			&dst_joint_curve->rotation_curves[1],
-			&dst_joint_curve->rotation_curves[2],
-			&dst_joint_curve->rotation_curves[3],
+	if (fallback_pose_ptr)
+	{
+		fallback_transforms = (Amber_Transform *)memory;
+		memcpy(fallback_transforms, fallback_pose_ptr->transforms, sizeof(Amber_Transform) * fallback_joint_count);
+	}
 
-			&dst_joint_curve->scale_curves[0],
-			&dst_joint_curve->scale_curves[1],
-			&dst_joint_curve->scale_curves[2],
-		};
+	Impl_SequenceLoad *load = (Impl_SequenceLoad *)amber_allocatorAllocate(&instance_ptr->allocator, impl_getSequenceLoadSize(sequence_count), AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	assert(load);
 
-		for (uint32_t j = 0; j < 10; ++j)
-		{
-			const Amber_SequenceCurve *src_curve = src_curves[j];
-			Impl_SequenceCurve *dst_curve = dst_curves[j];
-
-			if (src_curve->key_count == 0)
-				continue;
-			
-			dst_curve->key_count = src_curve->key_count;
-			dst_curve->keys = (Amber_SequenceKey *)malloc(sizeof(Amber_SequenceKey) * src_curve->key_count);
-
-			for (uint32_t k = 0; k < src_curve->key_count; ++k)
-			{
-				dst_curve->keys[k] = src_curve->keys[k];
-
-				float time = src_curve->keys[k].time;
-				sequence_min_time = amber_floatMin(sequence_min_time, time);
-				sequence_max_time = amber_floatMax(sequence_max_time, time);
-
-				curve_min_time = amber_floatMin(curve_min_time, time);
-				curve_max_time = amber_floatMax(curve_max_time, time);
-			}
-		}
+	memset(load, 0, sizeof(Impl_SequenceLoad));
+	load->task.function = impl_sequenceLoadTask;
+	load->task.data = load;
+	load->instance_ptr = instance_ptr;
+	load->sequence_count = sequence_count;
+	load->descs = descs;
+	load->handles = (Amber_PoolHandle *)((uint8_t *)load + alignUpul(sizeof(Impl_SequenceLoad), AMBER_DEFAULT_ALIGNMENT));
+	load->memory = memory + fallback_size;
 
-		dst_joint_curve->min_time = curve_min_time;
-		dst_joint_curve->max_time = curve_max_time;
-	}
+	amber_poolReserve(&instance_ptr->sequences, amber_poolGetSize(&instance_ptr->sequences) + sequence_count);
 
-	if (desc->root_motion_curve)
+	for (uint32_t i = 0; i < sequence_count; ++i)
 	{
-		float curve_min_time = FLT_MAX;
-		float curve_max_time = -FLT_MAX;
-
-		root_motion_curve = (Impl_SequenceJointCurve *)malloc(sizeof(Impl_SequenceJointCurve));
-		memset(root_motion_curve, 0, sizeof(Impl_SequenceJointCurve));
+		assert(descs[i].joint_count > 0);
+
+		Impl_Sequence placeholder;
+		memset(&placeholder, 0, sizeof(Impl_Sequence));
+		placeholder.armature = descs[i].armature;
+		placeholder.joint_count = descs[i].joint_count;
+		placeholder.block = block;
+		placeholder.state = IMPL_SEQUENCE_STATE_LOADING;
+		placeholder.fallback_joint_count = fallback_joint_count;
+		placeholder.fallback_transforms = fallback_transforms;
+
+		load->handles[i] = amber_poolAddElement(&instance_ptr->sequences, &placeholder);
+		sequences[i] = (Amber_Sequence)load->handles[i];
+	}
 
-		const Amber_SequenceJointCurve *src_root_motion_curve = desc->root_motion_curve;
+	// Note: the loader never reads 'fence', and handles are not handed out before it is set
+	uint64_t load_fence = amber_loaderSubmit(&instance_ptr->loader, &load->task);
 
-		const Amber_SequenceCurve *src_curves[10] =
-		{
-			&src_root_motion_curve->position_curves[0],
-			&src_root_motion_curve->position_curves[1],
-			&src_root_motion_curve->position_curves[2],
+	for (uint32_t i = 0; i < sequence_count; ++i)
+	{
+		Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequences[i]);
+		assert(sequence_ptr);
 
-			&src_root_motion_curve->rotation_curves[0],
-			&src_root_motion_curve->rotation_curves[1],
-			&src_root_motion_curve->rotation_curves[2],
-			&src_root_motion_curve->rotation_curves[3],
+		sequence_ptr->fence = load_fence;
+	}
 
-			&src_root_motion_curve->scale_curves[0],
-			&src_root_motion_curve->scale_curves[1],
-			&src_root_motion_curve->scale_curves[2],
-		};
+	*fence = load_fence;
+	return AMBER_SUCCESS;
+}
 
-		Impl_SequenceCurve *dst_curves[10] =
-		{
-			&root_motion_curve->position_curves[0],
-			&root_motion_curve->position_curves[1],
-			&root_motion_curve->position_curves[2],
+Amber_Result impl_instanceGetFenceStatus(Amber_Instance this, uint64_t fence, uint32_t *complete)
+{
+	assert(this);
+	assert(complete);
 
-			&root_motion_curve->rotation_curves[0],
-			&root_motion_curve->rotation_curves[1],
-			&root_motion_curve->rotation_curves[2],
-			&root_motion_curve->rotation_curves[3],
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	*complete = amber_loaderIsComplete(&instance_ptr->loader, fence);
 
-			&root_motion_curve->scale_curves[0],
-			&root_motion_curve->scale_curves[1],
-			&root_motion_curve->scale_curves[2],
-		};
+	return AMBER_SUCCESS;
+}
 
-		for (uint32_t j = 0; j < 10; ++j)
-		{
-			const Amber_SequenceCurve *src_curve = src_curves[j];
-			Impl_SequenceCurve *dst_curve = dst_curves[j];
-
-			if (src_curve->key_count == 0)
-				continue;
-			
-			dst_curve->key_count = src_curve->key_count;
-			dst_curve->keys = (Amber_SequenceKey *)malloc(sizeof(Amber_SequenceKey) * src_curve->key_count);
-
-			for (uint32_t k = 0; k < src_curve->key_count; ++k)
-			{
-				dst_curve->keys[k] = src_curve->keys[k];
-
-				float time = src_curve->keys[k].time;
-				sequence_min_time = amber_floatMin(sequence_min_time, time);
-				sequence_max_time = amber_floatMax(sequence_max_time, time);
-
-				curve_min_time = amber_floatMin(curve_min_time, time);
-				curve_max_time = amber_floatMax(curve_max_time, time);
-			}
-		}
+Amber_Result impl_instanceWaitFence(Amber_Instance this, uint64_t fence)
+{
+	assert(this);
 
-		root_motion_curve->min_time = curve_min_time;
-		root_motion_curve->max_time = curve_max_time;
-	}
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
 
-	Impl_Sequence result = {0};
-	result.armature = desc->armature;
-	result.joint_count = desc->joint_count;
-	result.joint_indices = joint_indices;
-	result.joint_curves = joint_curves;
-	result.root_motion_curve = root_motion_curve;
-	result.min_time = sequence_min_time;
-	result.max_time = sequence_max_time;
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberWaitFence");
+	amber_loaderWait(&instance_ptr->loader, fence);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberWaitFence");
 
-	*sequence = (Amber_Sequence)amber_poolAddElement(&instance_ptr->sequences, &result);
 	return AMBER_SUCCESS;
 }
 
@@ -642,17 +1611,19 @@ Amber_Result impl_instanceDestroyArmature(Amber_Instance this, Amber_Armature ar
 	assert(armature);
 
 	Amber_PoolHandle handle = (Amber_PoolHandle)armature;
-	assert(handle != AMBER_POOL_HANDLE_NULL);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
 	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, handle);
-	assert(armature_ptr);
+
+	// Note: the slot outlives amberDestroyArmature while poses reference it, so the flag tells a second
+	//       destroy apart from the first one, and only one of two racing calls releases the reference
+	if (armature_ptr == NULL || !amber_atomicCompareExchange32(&armature_ptr->destroyed, 0, 1))
+		return AMBER_INVALID_HANDLE;
+
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
 
-	amber_poolRemoveElement(&instance_ptr->armatures, handle);
-
-	impl_destroyArmature(instance_ptr, armature_ptr);
+	impl_releaseArmature(instance_ptr, armature_ptr);
 	return AMBER_SUCCESS;
 }
 
@@ -661,6 +1632,10 @@ Amber_Result impl_instanceDestroyPose(Amber_Instance this, Amber_Pose pose)
 	assert(this);
 	assert(pose);
 
+	// Note: transient poses are owned by the transient arena and released all at once on reset
+	if (impl_isTransientPose(pose))
+		return AMBER_SUCCESS;
+
 	Amber_PoolHandle handle = (Amber_PoolHandle)pose;
 	assert(handle != AMBER_POOL_HANDLE_NULL);
 
@@ -668,9 +1643,57 @@ Amber_Result impl_instanceDestroyPose(Amber_Instance this, Amber_Pose pose)
 	Impl_Pose *pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, handle);
 	assert(pose_ptr);
 
-	amber_poolRemoveElement(&instance_ptr->poses, handle);
+	Impl_Armature *armature_ptr = pose_ptr->armature_ptr;
 
 	impl_destroyPose(instance_ptr, pose_ptr);
+	amber_poolRemoveElement(&instance_ptr->poses, handle);
+	impl_releaseArmature(instance_ptr, armature_ptr);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceDestroyPoses(Amber_Instance this, uint32_t pose_count, const Amber_Pose *poses)
+{
+	assert(this);
+	assert(pose_count == 0 || poses);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	for (uint32_t i = 0; i < pose_count; ++i)
+	{
+		// Note: transient poses are owned by the transient arena and released all at once on reset
+		if (impl_isTransientPose(poses[i]))
+			continue;
+
+		Amber_PoolHandle handle = (Amber_PoolHandle)poses[i];
+		assert(handle != AMBER_POOL_HANDLE_NULL);
+
+		Impl_Pose *pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, handle);
+		assert(pose_ptr);
+
+		Impl_Armature *armature_ptr = pose_ptr->armature_ptr;
+
+		impl_destroyPose(instance_ptr, pose_ptr);
+		amber_poolRemoveElement(&instance_ptr->poses, handle);
+		impl_releaseArmature(instance_ptr, armature_ptr);
+	}
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceResetTransientPoses(Amber_Instance this)
+{
+	assert(this);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	amber_arenaReset(&instance_ptr->transient_arena);
+	instance_ptr->transient_pose_count = 0;
+
+	// Note: bumping the epoch invalidates all transient handles given out before the reset
+	instance_ptr->transient_epoch++;
+	if (instance_ptr->transient_epoch == 0)
+		instance_ptr->transient_epoch = 1;
+
 	return AMBER_SUCCESS;
 }
 
@@ -686,9 +1709,30 @@ Amber_Result impl_instanceDestroySequence(Amber_Instance this, Amber_Sequence se
 	Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, handle);
 	assert(sequence_ptr);
 
+	impl_destroySequence(instance_ptr, sequence_ptr);
 	amber_poolRemoveElement(&instance_ptr->sequences, handle);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceDestroySequences(Amber_Instance this, uint32_t sequence_count, const Amber_Sequence *sequences)
+{
+	assert(this);
+	assert(sequence_count == 0 || sequences);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	for (uint32_t i = 0; i < sequence_count; ++i)
+	{
+		Amber_PoolHandle handle = (Amber_PoolHandle)sequences[i];
+		assert(handle != AMBER_POOL_HANDLE_NULL);
+
+		Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, handle);
+		assert(sequence_ptr);
+
+		impl_destroySequence(instance_ptr, sequence_ptr);
+		amber_poolRemoveElement(&instance_ptr->sequences, handle);
+	}
 
-	impl_destroySequence(instance_ptr, sequence_ptr);
 	return AMBER_SUCCESS;
 }
 
@@ -698,46 +1742,70 @@ Amber_Result impl_instanceDestroy(Amber_Instance this)
 
 	Impl_Instance *ptr = (Impl_Instance *)this;
 
+	// Note: pending loads are finished first, they write into sequences and allocate memory
+	amber_loaderShutdown(&ptr->loader);
+	amber_jobSystemShutdown(&ptr->jobs);
+
 	{
-		uint32_t head = amber_poolGetHeadIndex(&ptr->sequences);
-		while (head != AMBER_POOL_HANDLE_NULL)
+		uint32_t size = amber_poolGetSize(&ptr->graphs);
+		for (uint32_t i = 0; i < size; ++i)
 		{
-			Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElementByIndex(&ptr->sequences, head);
-			impl_destroySequence(ptr, sequence_ptr);
+			Impl_Graph *graph_ptr = (Impl_Graph *)amber_poolGetDenseElement(&ptr->graphs, i);
+			impl_destroyGraph(ptr, graph_ptr);
+		}
 
-			head = amber_poolGetNextIndex(&ptr->sequences, head);
+		amber_poolShutdown(&ptr->graphs);
+	}
+
+	{
+		uint32_t size = amber_poolGetSize(&ptr->sequences);
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetDenseElement(&ptr->sequences, i);
+			impl_destroySequence(ptr, sequence_ptr);
 		}
 
 		amber_poolShutdown(&ptr->sequences);
 	}
 
 	{
-		uint32_t head = amber_poolGetHeadIndex(&ptr->poses);
-		while (head != AMBER_POOL_HANDLE_NULL)
+		uint32_t size = amber_poolGetSize(&ptr->poses);
+		for (uint32_t i = 0; i < size; ++i)
 		{
-			Impl_Pose *pose_ptr = (Impl_Pose *)amber_poolGetElementByIndex(&ptr->poses, head);
+			Impl_Pose *pose_ptr = (Impl_Pose *)amber_poolGetDenseElement(&ptr->poses, i);
 			impl_destroyPose(ptr, pose_ptr);
-
-			head = amber_poolGetNextIndex(&ptr->poses, head);
 		}
 
 		amber_poolShutdown(&ptr->poses);
 	}
 
 	{
-		uint32_t head = amber_poolGetHeadIndex(&ptr->armatures);
-		while (head != AMBER_POOL_HANDLE_NULL)
+		uint32_t size = amber_poolGetSize(&ptr->armatures);
+		for (uint32_t i = 0; i < size; ++i)
 		{
-			Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElementByIndex(&ptr->armatures, head);
+			Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetDenseElement(&ptr->armatures, i);
 			impl_destroyArmature(ptr, armature_ptr);
-
-			head = amber_poolGetNextIndex(&ptr->armatures, head);
 		}
 
 		amber_poolShutdown(&ptr->armatures);
 	}
 
-	free(ptr);
+	// Note: pages are allocated by whichever pose claims them first, so they may have gaps
+	for (uint32_t i = 0; i < IMPL_TRANSIENT_MAX_PAGES; ++i)
+		if (ptr->transient_pages[i])
+			amber_allocatorFree(&ptr->allocator, ptr->transient_pages[i], sizeof(Impl_Pose) * IMPL_TRANSIENT_PAGE_SIZE, AMBER_MEMORY_CATEGORY_TRANSIENT);
+
+	amber_arenaShutdown(&ptr->transient_arena);
+
+	Amber_Capture *capture = amber_profilerEndCapture(&ptr->profiler);
+	if (capture)
+		impl_destroyCapture(ptr, capture);
+
+	amber_profilerShutdown(&ptr->profiler);
+
+	// Note: the instance memory is released through a copy, the allocator is part of it
+	Amber_Allocator allocator = ptr->allocator;
+	amber_allocatorFree(&allocator, ptr, sizeof(Impl_Instance), AMBER_MEMORY_CATEGORY_INSTANCE);
 	return AMBER_SUCCESS;
 }
 
@@ -748,17 +1816,17 @@ Amber_Result impl_instanceCopyPose(Amber_Instance this, Amber_Pose src_pose, Amb
 	assert(dst_pose);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Pose *src_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_pose);
+	Impl_Pose *src_pose_ptr = impl_getPose(instance_ptr, src_pose);
 	assert(src_pose_ptr);
 	assert(src_pose_ptr->transforms);
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
 	assert(src_pose_ptr->armature == dst_pose_ptr->armature);
 
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)src_pose_ptr->armature);
+	const Impl_Armature *armature_ptr = src_pose_ptr->armature_ptr;
 	assert(armature_ptr);
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
@@ -776,22 +1844,22 @@ Amber_Result impl_instanceMultiplyPose(Amber_Instance this, Amber_Pose src_pose_
 	assert(dst_pose);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Pose *src_pose_a_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_pose_a);
+	Impl_Pose *src_pose_a_ptr = impl_getPose(instance_ptr, src_pose_a);
 	assert(src_pose_a_ptr);
 	assert(src_pose_a_ptr->transforms);
 
-	Impl_Pose *src_pose_b_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_pose_b);
+	Impl_Pose *src_pose_b_ptr = impl_getPose(instance_ptr, src_pose_b);
 	assert(src_pose_b_ptr);
 	assert(src_pose_b_ptr->transforms);
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
 	assert(src_pose_a_ptr->armature == dst_pose_ptr->armature);
 	assert(src_pose_b_ptr->armature == dst_pose_ptr->armature);
 
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)dst_pose_ptr->armature);
+	const Impl_Armature *armature_ptr = dst_pose_ptr->armature_ptr;
 	assert(armature_ptr);
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
@@ -809,17 +1877,17 @@ Amber_Result impl_instanceInvertPose(Amber_Instance this, Amber_Pose src_pose, A
 	assert(dst_pose);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Pose *src_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_pose);
+	Impl_Pose *src_pose_ptr = impl_getPose(instance_ptr, src_pose);
 	assert(src_pose_ptr);
 	assert(src_pose_ptr->transforms);
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
 	assert(src_pose_ptr->armature == dst_pose_ptr->armature);
 
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)src_pose_ptr->armature);
+	const Impl_Armature *armature_ptr = src_pose_ptr->armature_ptr;
 	assert(armature_ptr);
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
@@ -837,7 +1905,7 @@ Amber_Result impl_instanceMapPose(Amber_Instance this, Amber_Pose pose, Amber_Tr
 	assert(transforms);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Pose *pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)pose);
+	Impl_Pose *pose_ptr = impl_getPose(instance_ptr, pose);
 	assert(pose_ptr);
 	assert(pose_ptr->transforms);
 
@@ -851,7 +1919,7 @@ Amber_Result impl_instanceUnmapPose(Amber_Instance this, Amber_Pose pose)
 	assert(pose);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Pose *pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)pose);
+	Impl_Pose *pose_ptr = impl_getPose(instance_ptr, pose);
 	assert(pose_ptr);
 	assert(pose_ptr->transforms);
 
@@ -860,60 +1928,72 @@ Amber_Result impl_instanceUnmapPose(Amber_Instance this, Amber_Pose pose)
 	return AMBER_SUCCESS;
 }
 
-Amber_Result impl_instanceSampleRootMotion(Amber_Instance this, Amber_Sequence sequence, float prev_time, float time, Amber_Transform *dst_transform)
+Amber_Result impl_instanceEnumeratePoses(Amber_Instance this, Amber_Armature armature, uint32_t *pose_count, Amber_Pose *poses)
 {
 	assert(this);
-	assert(sequence);
-	assert(dst_transform);
+	assert(armature);
+	assert(pose_count);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequence);
-	assert(sequence_ptr);
-	assert(sequence_ptr->joint_count > 0);
-	assert(sequence_ptr->joint_curves);
-	assert(sequence_ptr->joint_indices);
+	Amber_Pool *pool = &instance_ptr->poses;
 
-	Amber_Transform result = (Amber_Transform)
-	{
-		0.0f, 0.0f, 0.0f,
-		0.0f, 0.0f, 0.0f, 1.0f,
-		1.0f, 1.0f, 1.0f,
-	};
+	uint32_t max_count = (poses) ? *pose_count : 0;
+	uint32_t count = 0;
 
-	if (sequence_ptr->root_motion_curve)
+	// Note: walks the dense handle array, which is kept in swap-remove order, so poses are visited in no
+	//       particular order. Everything is counted even if 'poses' is full, so the caller learns the size it needs.
+	amber_poolLock(pool);
+
+	uint32_t size = amber_poolGetSize(pool);
+	for (uint32_t i = 0; i < size; ++i)
 	{
-		const Impl_SequenceJointCurve *root_motion_curve = sequence_ptr->root_motion_curve;
+		const Impl_Pose *pose_ptr = (const Impl_Pose *)amber_poolGetDenseElement(pool, i);
+		if (pose_ptr->armature != armature)
+			continue;
 
-		Amber_Transform transform = amber_fetchJointTransform(root_motion_curve, time);
-		Amber_Transform prev_transform = amber_fetchJointTransform(root_motion_curve, prev_time);
+		if (count < max_count)
+			poses[count] = (Amber_Pose)amber_poolGetDenseHandle(pool, i);
 
-		if (prev_time < time)
-		{
-			result.position = amber_vec3Sub(transform.position, prev_transform.position);
-			result.rotation = amber_quatMul(amber_quatConjugate(prev_transform.rotation), transform.rotation);
-			result.scale = amber_vec3Div(transform.scale, prev_transform.scale);
-		}
-		else
-		{
-			Amber_Transform first_transform = amber_fetchJointTransform(root_motion_curve, root_motion_curve->min_time);
-			Amber_Transform last_transform = amber_fetchJointTransform(root_motion_curve, root_motion_curve->max_time);
+		count++;
+	}
 
-			Amber_Transform temp_transform = {0};
-			temp_transform.position = amber_vec3Sub(last_transform.position, prev_transform.position);
-			temp_transform.rotation = amber_quatMul(amber_quatConjugate(prev_transform.rotation), last_transform.rotation);
-			temp_transform.scale = amber_vec3Div(last_transform.scale, prev_transform.scale);
+	amber_poolUnlock(pool);
 
-			result.position = amber_vec3Sub(transform.position, first_transform.position);
-			result.rotation = amber_quatMul(amber_quatConjugate(first_transform.rotation), transform.rotation);
-			result.scale = amber_vec3Div(transform.scale, first_transform.scale);
+	*pose_count = count;
 
-			result.position = amber_vec3Add(result.position, temp_transform.position);
-			result.rotation = amber_quatMul(result.rotation, temp_transform.rotation);
-			result.scale = amber_vec3Mul(result.scale, temp_transform.scale);
-		}
-	};
+	if (poses && count > max_count)
+		return AMBER_INVALID_OUTPUT_ARGUMENT;
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceGetPoseJointCount(Amber_Instance this, Amber_Pose pose, uint32_t *joint_count)
+{
+	assert(this);
+	assert(pose);
+	assert(joint_count);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Pose *pose_ptr = impl_getPose(instance_ptr, pose);
+	assert(pose_ptr);
+
+	*joint_count = pose_ptr->joint_count;
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceSampleRootMotion(Amber_Instance this, Amber_Sequence sequence, float prev_time, float time, Amber_Transform *dst_transform)
+{
+	assert(this);
+	assert(sequence);
+	assert(dst_transform);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequence);
+	assert(sequence_ptr);
+	assert(sequence_ptr->joint_count > 0);
+
+	impl_sequenceSampleRootMotion(sequence_ptr, prev_time, time, dst_transform);
 
-	*dst_transform = result;
 	return AMBER_SUCCESS;
 }
 
@@ -927,28 +2007,19 @@ Amber_Result impl_instanceSamplePose(Amber_Instance this, Amber_Sequence sequenc
 	Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequence);
 	assert(sequence_ptr);
 	assert(sequence_ptr->joint_count > 0);
-	assert(sequence_ptr->joint_curves);
-	assert(sequence_ptr->joint_indices);
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
-	Impl_Armature *dst_armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)dst_pose_ptr->armature);
+	const Impl_Armature *dst_armature_ptr = dst_pose_ptr->armature_ptr;
 	assert(dst_armature_ptr);
 	assert(dst_armature_ptr->joint_count > 0);
 	assert(dst_armature_ptr->joint_parents);
 
-	for (uint32_t i = 0; i < sequence_ptr->joint_count; ++i)
-	{
-		uint32_t index = sequence_ptr->joint_indices[i];
-		assert(index < dst_armature_ptr->joint_count);
-
-		const Impl_SequenceJointCurve *src_joint_curve = &sequence_ptr->joint_curves[i];
-		assert(src_joint_curve);
-
-		dst_pose_ptr->transforms[index] = amber_fetchJointTransform(src_joint_curve, time);
-	}
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberSamplePose");
+	impl_poseSample(sequence_ptr, time, dst_armature_ptr->joint_count, dst_pose_ptr->transforms);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberSamplePose");
 
 	return AMBER_SUCCESS;
 }
@@ -963,19 +2034,21 @@ Amber_Result impl_instanceBlendPoses(Amber_Instance this, uint32_t src_pose_coun
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)dst_pose_ptr->armature);
+	const Impl_Armature *armature_ptr = dst_pose_ptr->armature_ptr;
 	assert(armature_ptr);
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
 
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberBlendPoses");
+
 	memset(dst_pose_ptr->transforms, 0, sizeof(Amber_Transform) * armature_ptr->joint_count);
 	for (uint32_t i = 0; i < src_pose_count; ++i)
 	{
-		Impl_Pose *src_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_poses[i]);
+		Impl_Pose *src_pose_ptr = impl_getPose(instance_ptr, src_poses[i]);
 		assert(src_pose_ptr);
 		assert(src_pose_ptr->transforms);
 		assert(src_pose_ptr->armature == dst_pose_ptr->armature);
@@ -985,28 +2058,12 @@ Amber_Result impl_instanceBlendPoses(Amber_Instance this, uint32_t src_pose_coun
 		if (src_weight == 0.0f)
 			continue;
 
-		for (uint32_t j = 0; j < armature_ptr->joint_count; ++j)
-		{
-			const Amber_Transform *src_transform = &src_pose_ptr->transforms[j];
-			Amber_Transform *dst_transform = &dst_pose_ptr->transforms[j];
-
-			Amber_Quat src_rotation = src_transform->rotation;
-			Amber_Quat dst_rotation = dst_transform->rotation;
-
-			if (amber_quatDot(src_rotation, dst_rotation) < 0.0f)
-				dst_rotation = (Amber_Quat){-dst_rotation.x, -dst_rotation.y, -dst_rotation.z, -dst_rotation.w};
-
-			dst_transform->position = amber_vec3Mad(src_transform->position, src_weight, dst_transform->position);
-			dst_transform->rotation = amber_quatMad(src_rotation, src_weight, dst_rotation);
-			dst_transform->scale = amber_vec3Mad(src_transform->scale, src_weight, dst_transform->scale);
-		}
+		impl_poseAccumulate(armature_ptr->joint_count, src_pose_ptr->transforms, src_weight, dst_pose_ptr->transforms);
 	}
 
-	for (uint32_t j = 0; j < armature_ptr->joint_count; ++j)
-	{
-		Amber_Transform *dst_transform = &dst_pose_ptr->transforms[j];
-		dst_transform->rotation = amber_quatNormalize(dst_transform->rotation);
-	}
+	impl_poseNormalize(armature_ptr->joint_count, dst_pose_ptr->transforms);
+
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberBlendPoses");
 
 	return AMBER_SUCCESS;
 }
@@ -1018,37 +2075,29 @@ Amber_Result impl_instanceComputeAdditivePose(Amber_Instance this, Amber_Pose sr
 	assert(dst_pose);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Pose *src_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_pose);
+	Impl_Pose *src_pose_ptr = impl_getPose(instance_ptr, src_pose);
 	assert(src_pose_ptr);
 	assert(src_pose_ptr->transforms);
 
-	Impl_Pose *src_reference_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_reference_pose);
+	Impl_Pose *src_reference_pose_ptr = impl_getPose(instance_ptr, src_reference_pose);
 	assert(src_reference_pose_ptr);
 	assert(src_reference_pose_ptr->transforms);
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
 	assert(src_pose_ptr->armature == dst_pose_ptr->armature);
 	assert(src_reference_pose_ptr->armature == dst_pose_ptr->armature);
 
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)src_pose_ptr->armature);
+	const Impl_Armature *armature_ptr = src_pose_ptr->armature_ptr;
 	assert(armature_ptr);
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
 
-	for (uint32_t i = 0; i < armature_ptr->joint_count; ++i)
-	{
-		const Amber_Transform *src_transform = &src_pose_ptr->transforms[i];
-		const Amber_Transform *src_reference_transform = &src_reference_pose_ptr->transforms[i];
-
-		Amber_Transform *dst_transform = &dst_pose_ptr->transforms[i];
-
-		dst_transform->position = amber_vec3Sub(src_transform->position, src_reference_transform->position);
-		dst_transform->rotation = amber_quatMul(amber_quatConjugate(src_reference_transform->rotation), src_transform->rotation);
-		dst_transform->scale = amber_vec3Div(src_transform->scale, src_reference_transform->scale);
-	}
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberComputeAdditivePose");
+	impl_poseComputeAdditive(armature_ptr->joint_count, src_pose_ptr->transforms, src_reference_pose_ptr->transforms, dst_pose_ptr->transforms);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberComputeAdditivePose");
 
 	return AMBER_SUCCESS;
 }
@@ -1064,25 +2113,27 @@ Amber_Result impl_instanceApplyAdditivePoses(Amber_Instance this, Amber_Pose src
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
 
-	Impl_Pose *src_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_pose);
+	Impl_Pose *src_pose_ptr = impl_getPose(instance_ptr, src_pose);
 	assert(src_pose_ptr);
 	assert(src_pose_ptr->transforms);
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)dst_pose_ptr->armature);
+	const Impl_Armature *armature_ptr = dst_pose_ptr->armature_ptr;
 	assert(armature_ptr);
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
 
 	assert(src_pose_ptr->armature == dst_pose_ptr->armature);
+
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberApplyAdditivePoses");
 	memcpy(dst_pose_ptr->transforms, src_pose_ptr->transforms, sizeof(Amber_Transform) * armature_ptr->joint_count);
 
 	for (uint32_t i = 0; i < src_additive_pose_count; ++i)
 	{
-		Impl_Pose *src_additive_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_additive_poses[i]);
+		Impl_Pose *src_additive_pose_ptr = impl_getPose(instance_ptr, src_additive_poses[i]);
 		assert(src_additive_pose_ptr);
 		assert(src_additive_pose_ptr->transforms);
 		assert(src_additive_pose_ptr->armature == dst_pose_ptr->armature);
@@ -1092,17 +2143,11 @@ Amber_Result impl_instanceApplyAdditivePoses(Amber_Instance this, Amber_Pose src
 		if (src_weight == 0.0f)
 			continue;
 
-		for (uint32_t j = 0; j < armature_ptr->joint_count; ++j)
-		{
-			const Amber_Transform *src_additive_transform = &src_additive_pose_ptr->transforms[j];
-			Amber_Transform *dst_transform = &dst_pose_ptr->transforms[j];
-
-			dst_transform->position = amber_vec3Mad(src_additive_transform->position, src_weight, dst_transform->position);
-			dst_transform->rotation = amber_quatLerp(dst_transform->rotation, amber_quatMul(dst_transform->rotation, src_additive_transform->rotation), src_weight);
-			dst_transform->scale = amber_vec3Lerp(dst_transform->scale, amber_vec3Mul(dst_transform->scale, src_additive_transform->scale), src_weight);
-		}
+		impl_poseApplyAdditive(armature_ptr->joint_count, src_additive_pose_ptr->transforms, src_weight, dst_pose_ptr->transforms);
 	}
 
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberApplyAdditivePoses");
+
 	return AMBER_SUCCESS;
 }
 
@@ -1113,31 +2158,24 @@ Amber_Result impl_instanceConvertToWorldPose(Amber_Instance this, Amber_Pose src
 	assert(dst_pose);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Pose *src_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_pose);
+	Impl_Pose *src_pose_ptr = impl_getPose(instance_ptr, src_pose);
 	assert(src_pose_ptr);
 	assert(src_pose_ptr->transforms);
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
 	assert(src_pose_ptr->armature == dst_pose_ptr->armature);
 
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)src_pose_ptr->armature);
+	const Impl_Armature *armature_ptr = src_pose_ptr->armature_ptr;
 	assert(armature_ptr);
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
 
-	for (uint32_t i = 0; i < armature_ptr->joint_count; ++i)
-	{
-		int32_t parent = armature_ptr->joint_parents[i];
-		assert(parent < (int32_t)i);
-
-		if (parent == -1)
-			dst_pose_ptr->transforms[i] = src_pose_ptr->transforms[i];
-		else
-			dst_pose_ptr->transforms[i] = amber_mulTransform(dst_pose_ptr->transforms[parent], src_pose_ptr->transforms[i]);
-	}
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberConvertToWorldPose");
+	impl_poseConvertToWorld(armature_ptr->joint_count, armature_ptr->joint_parents, src_pose_ptr->transforms, dst_pose_ptr->transforms);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberConvertToWorldPose");
 
 	return AMBER_SUCCESS;
 }
@@ -1149,31 +2187,24 @@ Amber_Result impl_instanceConvertToLocalPose(Amber_Instance this, Amber_Pose src
 	assert(dst_pose);
 
 	Impl_Instance *instance_ptr = (Impl_Instance *)this;
-	Impl_Pose *src_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)src_pose);
+	Impl_Pose *src_pose_ptr = impl_getPose(instance_ptr, src_pose);
 	assert(src_pose_ptr);
 	assert(src_pose_ptr->transforms);
 
-	Impl_Pose *dst_pose_ptr = (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)dst_pose);
+	Impl_Pose *dst_pose_ptr = impl_getPose(instance_ptr, dst_pose);
 	assert(dst_pose_ptr);
 	assert(dst_pose_ptr->transforms);
 
 	assert(src_pose_ptr->armature == dst_pose_ptr->armature);
 
-	Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)src_pose_ptr->armature);
+	const Impl_Armature *armature_ptr = src_pose_ptr->armature_ptr;
 	assert(armature_ptr);
 	assert(armature_ptr->joint_count > 0);
 	assert(armature_ptr->joint_parents);
 
-	for (int32_t i = armature_ptr->joint_count - 1; i >= 0; --i)
-	{
-		int32_t parent = armature_ptr->joint_parents[i];
-		assert(parent < i);
-
-		if (parent == -1)
-			dst_pose_ptr->transforms[i] = src_pose_ptr->transforms[i];
-		else
-			dst_pose_ptr->transforms[i] = amber_mulTransform(amber_invertTransform(src_pose_ptr->transforms[parent]), src_pose_ptr->transforms[i]);
-	}
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberConvertToLocalPose");
+	impl_poseConvertToLocal(armature_ptr->joint_count, armature_ptr->joint_parents, src_pose_ptr->transforms, dst_pose_ptr->transforms);
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberConvertToLocalPose");
 
 	return AMBER_SUCCESS;
 }
@@ -1206,6 +2237,58 @@ static Amber_InstanceTable instance_vtbl =
 
 	impl_instanceConvertToWorldPose,
 	impl_instanceConvertToLocalPose,
+
+	impl_instanceCreateGraph,
+	impl_instanceDestroyGraph,
+	impl_instanceEvaluateGraph,
+
+	impl_instanceCreateTransientPose,
+	impl_instanceResetTransientPoses,
+
+	impl_instanceReserveCapacity,
+
+	impl_instanceEnumeratePoses,
+
+	impl_instanceCreatePoses,
+	impl_instanceCreateSequences,
+	impl_instanceDestroyPoses,
+	impl_instanceDestroySequences,
+
+	impl_instanceResolvePose,
+	impl_instanceResolveSequence,
+	impl_instanceGetUncheckedTable,
+
+	impl_instanceSamplePoseBatch,
+	impl_instanceBlendPoseBatch,
+	impl_instanceConvertToWorldPoseBatch,
+	impl_instanceConvertToLocalPoseBatch,
+
+	impl_instanceGetPoseJointCount,
+
+	impl_instanceBeginCapture,
+	impl_instanceEndCapture,
+
+	impl_instanceGetInstanceStats,
+	impl_instanceGetSequenceStats,
+
+	impl_instanceCreateSequenceFromMemory,
+	impl_instanceSerializeSequence,
+
+	impl_instanceCreateSequencesAsync,
+	impl_instanceGetFenceStatus,
+	impl_instanceWaitFence,
+
+	impl_instanceCreateStreamingSequence,
+	impl_instanceSerializeStreamingSequence,
+	impl_instancePrefetchStreamingSequence,
+
+	impl_instanceCreateCachedSequence,
+	impl_instanceSetSequenceCacheBudget,
+
+	impl_instanceLoadSnapshot,
+	impl_instanceSerializeSnapshot,
+
+	impl_instanceAttachLibrary,
 };
 
 /*
@@ -1215,20 +2298,44 @@ Amber_Result impl_createInstance(const Amber_InstanceDesc *desc, Amber_Instance
 	assert(desc);
 	assert(instance);
 
-	AMBER_UNUSED(desc);
+	Amber_Allocator allocator;
+	amber_allocatorInitialize(&allocator, desc->allocation_callbacks);
 
-	Impl_Instance *ptr = (Impl_Instance *)malloc(sizeof(Impl_Instance));
+	Impl_Instance *ptr = (Impl_Instance *)amber_allocatorAllocate(&allocator, sizeof(Impl_Instance), AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_INSTANCE);
 	assert(ptr);
 
 	// vtable
 	ptr->vtbl = &instance_vtbl;
 
 	// data
+	ptr->allocator = allocator;
+
+	// jobs
+	amber_jobSystemInitialize(&ptr->jobs, &ptr->allocator, desc->job_callbacks, desc->thread_count);
+
+	// profiler
+	amber_profilerInitialize(&ptr->profiler, desc->profiler_callbacks);
+
+	// loader
+	amber_loaderInitialize(&ptr->loader);
 
 	// pools
-	amber_poolInitialize(&ptr->armatures, sizeof(Impl_Armature), 32);
-	amber_poolInitialize(&ptr->poses, sizeof(Impl_Pose), 32);
-	amber_poolInitialize(&ptr->sequences, sizeof(Impl_Sequence), 32);
+	amber_poolInitialize(&ptr->armatures, &ptr->allocator, &ptr->profiler, sizeof(Impl_Armature), 32);
+	amber_poolInitialize(&ptr->poses, &ptr->allocator, &ptr->profiler, sizeof(Impl_Pose), 32);
+	amber_poolInitialize(&ptr->sequences, &ptr->allocator, &ptr->profiler, sizeof(Impl_Sequence), 32);
+	amber_poolInitialize(&ptr->graphs, &ptr->allocator, &ptr->profiler, sizeof(Impl_Graph), 8);
+
+	// transient poses
+	amber_arenaInitialize(&ptr->transient_arena, &ptr->allocator, IMPL_TRANSIENT_ARENA_BLOCK_SIZE);
+	ptr->transient_lock = 0;
+	ptr->transient_epoch = 1;
+	ptr->transient_pose_count = 0;
+	ptr->transient_page_count = 0;
+	memset(ptr->transient_pages, 0, sizeof(ptr->transient_pages));
+
+	// sequence cache
+	memset(&ptr->sequence_cache, 0, sizeof(Impl_SequenceCache));
+	ptr->sequence_cache.budget = desc->sequence_cache_budget;
 
 	*instance = (Amber_Instance)ptr;
 	return AMBER_SUCCESS;
@@ -2,34 +2,120 @@
 
 #include "amber_internal.h"
 
+#include "common/allocator.h"
+#include "common/arena.h"
+#include "common/jobs.h"
+#include "common/loader.h"
 #include "common/pool.h"
+#include "common/profiler.h"
+#include "common/slab.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+typedef struct Impl_Pose_t Impl_Pose;
+typedef struct Impl_Stream_t Impl_Stream;
+typedef struct Impl_CacheEntry_t Impl_CacheEntry;
+typedef struct Impl_Library_t Impl_Library;
+
+// Note: entries holding memory (loading, resident or failed) are linked in a ring swept by 'hand' on trim,
+//       entries sampled since the last sweep get a second chance. 'resident_bytes' and 'resident_count'
+//       include entries that are still loading, 'hit_count' only those of destroyed entries.
+typedef struct Impl_SequenceCache_t
+{
+	Amber_SpinLock lock;
+	uint64_t budget;
+	uint64_t resident_bytes;
+	uint32_t sequence_count;
+	uint32_t resident_count;
+	uint64_t hit_count;
+	uint64_t miss_count;
+	uint64_t eviction_count;
+	Impl_CacheEntry *head;
+	Impl_CacheEntry *hand;
+} Impl_SequenceCache;
+
+// Note: transient pose records are stored in fixed size pages which are kept across resets,
+//       so records never move and the steady state allocates nothing
+#define IMPL_TRANSIENT_PAGE_SHIFT 8
+#define IMPL_TRANSIENT_PAGE_SIZE (1 << IMPL_TRANSIENT_PAGE_SHIFT)
+#define IMPL_TRANSIENT_PAGE_MASK (IMPL_TRANSIENT_PAGE_SIZE - 1)
+#define IMPL_TRANSIENT_MAX_PAGES 1024
+#define IMPL_TRANSIENT_POSE_CAPACITY (IMPL_TRANSIENT_PAGE_SIZE * IMPL_TRANSIENT_MAX_PAGES)
 
 typedef struct Impl_Instance_t
 {
 	Amber_InstanceTable *vtbl;
+	Amber_Allocator allocator;
+	Amber_JobSystem jobs;
+	Amber_Profiler profiler;
+	Amber_Loader loader;
+
 	Amber_Pool armatures;
 	Amber_Pool poses;
 	Amber_Pool sequences;
+	Amber_Pool graphs;
+
+	Amber_Arena transient_arena;
+	Amber_SpinLock transient_lock;
+	uint32_t transient_epoch;
+	uint32_t transient_pose_count;
+	uint32_t transient_page_count;
+	Impl_Pose *transient_pages[IMPL_TRANSIENT_MAX_PAGES];
+
+	Impl_SequenceCache sequence_cache;
 } Impl_Instance;
 
+// Note: one allocation shared by several objects, released when the last owner is destroyed
+typedef struct Impl_Block_t
+{
+	uint32_t ref_count;
+	Amber_MemoryCategory category;
+	uint64_t size;
+} Impl_Block;
+
 typedef struct Impl_Armature_t
 {
 	uint32_t joint_count;
 	int32_t *joint_parents;
 	uint32_t *joint_name_offsets;
 	char *joint_name_memory;
+	uint32_t joint_name_size;
+	uint32_t pose_stride;
+	uint32_t pose_slab_capacity;
+	Amber_Slab pose_slab;
+	Amber_PoolHandle handle;
+	uint32_t ref_count;
+	uint32_t destroyed;
+	Impl_Block *block;
+	Impl_Library *library;
 } Impl_Armature;
 
-typedef struct Impl_Pose_t
+struct Impl_Pose_t
 {
 	Amber_Armature armature;
+	Impl_Armature *armature_ptr;
+	uint32_t joint_count;
+	uint32_t slab_allocated;
+	Impl_Block *block;
 	Amber_Transform *transforms;
-} Impl_Pose;
+};
+
+// Note: sequences are stored as a relocatable blob, curves address keys by index into the sequence key array
+//       and every other reference is an offset from the blob header, so a blob can be used in place
+//       from any address. Blobs are little-endian and 16 byte aligned.
+#define IMPL_SEQUENCE_BLOB_MAGIC 0x53424D41 // 'AMBS'
+#define IMPL_SEQUENCE_BLOB_VERSION 1
+
+typedef enum Impl_SequenceBlobFlags_t
+{
+	IMPL_SEQUENCE_BLOB_FLAG_ROOT_MOTION = 0x00000001,
+} Impl_SequenceBlobFlags;
 
 typedef struct Impl_SequenceCurve_t
 {
 	uint32_t key_count;
-	Amber_SequenceKey *keys;
+	uint32_t first_key;
 } Impl_SequenceCurve;
 
 typedef struct Impl_SequenceJointCurve_t
@@ -41,13 +127,368 @@ typedef struct Impl_SequenceJointCurve_t
 	float max_time;
 } Impl_SequenceJointCurve;
 
+// Note: root motion curve, if present, directly follows the joint curves
+typedef struct Impl_SequenceBlobHeader_t
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+	uint32_t joint_count;
+	uint32_t flags;
+	uint64_t key_count;
+	float min_time;
+	float max_time;
+	uint64_t joint_curves_offset;
+	uint64_t joint_indices_offset;
+	uint64_t keys_offset;
+} Impl_SequenceBlobHeader;
+
+// Note: sequences created asynchronously stay in the loading state until the loader publishes their data,
+//       the state is stored last with release semantics. Until then only 'armature', 'joint_count', 'block',
+//       fallback transforms and 'fence' may be read.
+#define IMPL_SEQUENCE_STATE_READY 0
+#define IMPL_SEQUENCE_STATE_LOADING 1
+
 typedef struct Impl_Sequence_t
 {
 	Amber_Armature armature;
 	uint32_t joint_count;
-	uint32_t *joint_indices;
-	Impl_SequenceJointCurve *joint_curves;
-	Impl_SequenceJointCurve *root_motion_curve;
+	const uint32_t *joint_indices;
+	const Impl_SequenceJointCurve *joint_curves;
+	const Impl_SequenceJointCurve *root_motion_curve;
+	const Amber_SequenceKey *keys;
+	const Impl_SequenceBlobHeader *blob;
 	float min_time;
 	float max_time;
+	Impl_Block *block;
+	Impl_Library *library;
+
+	uint32_t state;
+	uint32_t fallback_joint_count;
+	const Amber_Transform *fallback_transforms;
+	uint64_t fence;
+
+	Impl_Stream *stream;
+	Impl_CacheEntry *cache_entry;
 } Impl_Sequence;
+
+static AMBER_INLINE uint32_t impl_isSequenceReady(const Impl_Sequence *sequence_ptr)
+{
+	return amber_atomicLoad32(&sequence_ptr->state) == IMPL_SEQUENCE_STATE_READY;
+}
+
+// Note: streams are split into chunks of 'chunk_duration' seconds starting at 'min_time', every chunk is
+//       a self-contained sequence blob holding the keys of its time range plus interpolated keys at both ends.
+//       The chunk table directly follows the header, chunk blobs follow the table.
+#define IMPL_STREAM_MAGIC 0x53544D41 // 'AMTS'
+#define IMPL_STREAM_VERSION 1
+
+typedef struct Impl_StreamHeader_t
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+	uint32_t joint_count;
+	uint32_t chunk_count;
+	uint32_t flags;
+	float chunk_duration;
+	float min_time;
+	float max_time;
+	float root_motion_min_time;
+	float root_motion_max_time;
+	uint64_t max_chunk_size;
+	uint64_t chunks_offset;
+} Impl_StreamHeader;
+
+typedef struct Impl_StreamChunk_t
+{
+	uint64_t offset;
+	uint64_t size;
+} Impl_StreamChunk;
+
+// Note: slots are claimed and pinned under the stream lock, the loader only writes slots in the loading state
+//       and publishes them with a release store of 'state'. Ready slots are never evicted while pinned.
+#define IMPL_STREAM_SLOT_EMPTY 0
+#define IMPL_STREAM_SLOT_LOADING 1
+#define IMPL_STREAM_SLOT_READY 2
+#define IMPL_STREAM_SLOT_FAILED 3
+
+typedef struct Impl_StreamSlot_t
+{
+	Amber_LoaderTask task;
+	Impl_Stream *stream;
+	uint8_t *memory;
+	uint32_t chunk;
+	uint32_t state;
+	uint32_t pin_count;
+	uint64_t fence;
+	Impl_Sequence sequence;
+} Impl_StreamSlot;
+
+struct Impl_Stream_t
+{
+	Impl_Instance *instance_ptr;
+	Amber_Armature armature;
+	uint32_t armature_joint_count;
+	Amber_StreamCallbacks callbacks;
+	Impl_StreamHeader header;
+	const Impl_StreamChunk *chunks;
+	Impl_StreamSlot *slots;
+	uint32_t slot_count;
+	uint32_t prefetch_count;
+	uint64_t size;
+	Amber_SpinLock lock;
+};
+
+// Note: entries are claimed and evicted under the cache lock, the loader only writes entries in the
+//       loading state and publishes them with a release store of 'state'. Resident entries are pinned without
+//       the lock, eviction sets IMPL_CACHE_PIN_EVICTING only if 'pin_count' is zero, so pins racing with it
+//       see the bit and back off. Pinned entries are never evicted.
+#define IMPL_CACHE_PIN_EVICTING 0x80000000
+
+#define IMPL_CACHE_ENTRY_EVICTED 0
+#define IMPL_CACHE_ENTRY_LOADING 1
+#define IMPL_CACHE_ENTRY_RESIDENT 2
+#define IMPL_CACHE_ENTRY_FAILED 3
+
+struct Impl_CacheEntry_t
+{
+	Amber_LoaderTask task;
+	Impl_Instance *instance_ptr;
+	Amber_Armature armature;
+	uint32_t armature_joint_count;
+	Amber_StreamCallbacks callbacks;
+	const char *path;
+	uint64_t offset;
+	uint64_t size;
+	uint64_t allocation_size;
+	uint32_t joint_count;
+	uint32_t state;
+	uint32_t pin_count;
+	uint32_t referenced;
+	uint64_t hit_count;
+	uint64_t fence;
+	uint8_t *memory;
+	Impl_CacheEntry *prev;
+	Impl_CacheEntry *next;
+	Impl_Sequence sequence;
+};
+
+// Note: snapshots hold tables of armatures and sequences followed by a data region which is copied into
+//       a single block on load. Table offsets are relative to the data region, which is 64 byte aligned,
+//       sequences are stored as blobs written by amberSerializeSequence.
+#define IMPL_SNAPSHOT_MAGIC 0x53534D41 // 'AMSS'
+#define IMPL_SNAPSHOT_VERSION 1
+
+typedef struct Impl_SnapshotHeader_t
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+	uint32_t armature_count;
+	uint32_t sequence_count;
+	uint64_t armatures_offset;
+	uint64_t sequences_offset;
+	uint64_t data_offset;
+	uint64_t data_size;
+} Impl_SnapshotHeader;
+
+// Note: armatures without joint names have a 'joint_name_size' of zero
+typedef struct Impl_SnapshotArmature_t
+{
+	uint32_t handle;
+	uint32_t joint_count;
+	uint32_t joint_name_size;
+	uint32_t pose_slab_capacity;
+	uint64_t joint_parents_offset;
+	uint64_t joint_name_offsets_offset;
+	uint64_t joint_name_memory_offset;
+} Impl_SnapshotArmature;
+
+typedef struct Impl_SnapshotSequence_t
+{
+	uint32_t handle;
+	uint32_t padding;
+	Amber_Armature armature;
+	uint64_t blob_offset;
+	uint64_t blob_size;
+} Impl_SnapshotSequence;
+
+// Note: libraries are a snapshot kept in memory owned by the library itself, objects attached to instances
+//       reference it in place and hold one reference each, the creator holds another one
+struct Impl_Library_t
+{
+	Amber_Allocator allocator;
+	uint32_t ref_count;
+	Impl_SnapshotHeader header;
+	const Impl_SnapshotArmature *armatures;
+	const Impl_SnapshotSequence *sequences;
+	uint8_t *data;
+	uint64_t size;
+};
+
+typedef struct Impl_GraphNode_t
+{
+	Amber_GraphNodeType type;
+	uint32_t input_count;
+	uint32_t *inputs;
+	uint32_t *weight_parameters;
+	Amber_Sequence sequence;
+	uint32_t time_parameter;
+	float *joint_weights;
+	uint32_t cache_index;
+	uint32_t stack_depth;
+} Impl_GraphNode;
+
+typedef struct Impl_Graph_t
+{
+	Amber_Armature armature;
+	uint32_t joint_count;
+	uint32_t parameter_count;
+	uint32_t node_count;
+	Impl_GraphNode *nodes;
+	uint32_t *input_memory;
+	uint32_t input_memory_count;
+	float *joint_weight_memory;
+	uint32_t joint_weight_count;
+	Amber_Transform *reference_transforms;
+	uint32_t scratch_count;
+	uint32_t cache_count;
+} Impl_Graph;
+
+/*
+ */
+// Note: transient pose handles store the transient epoch in the upper 32 bits, regular pose handles
+//       are plain pool handles, so their upper bits are always zero.
+static AMBER_INLINE Amber_Pose impl_packTransientPose(uint32_t epoch, uint32_t index)
+{
+	assert(epoch != 0);
+	return ((Amber_Pose)epoch << 32) | (Amber_Pose)index;
+}
+
+static AMBER_INLINE uint32_t impl_isTransientPose(Amber_Pose pose)
+{
+	return (uint32_t)(pose >> 32) != 0;
+}
+
+static AMBER_INLINE Impl_Pose *impl_getPose(const Impl_Instance *instance_ptr, Amber_Pose pose)
+{
+	assert(instance_ptr);
+
+	if (!impl_isTransientPose(pose))
+		return (Impl_Pose *)amber_poolGetElement(&instance_ptr->poses, (Amber_PoolHandle)pose);
+
+	uint32_t epoch = (uint32_t)(pose >> 32);
+
+	uint32_t index = (uint32_t)(pose & 0xFFFFFFFF);
+
+	if (epoch != instance_ptr->transient_epoch)
+		return NULL;
+
+	if (index >= amber_atomicLoad32(&instance_ptr->transient_pose_count) || index >= IMPL_TRANSIENT_POSE_CAPACITY)
+		return NULL;
+
+	return &instance_ptr->transient_pages[index >> IMPL_TRANSIENT_PAGE_SHIFT][index & IMPL_TRANSIENT_PAGE_MASK];
+}
+
+/*
+ */
+void impl_poseSample(const Impl_Sequence *sequence_ptr, float time, uint32_t joint_count, Amber_Transform *dst_transforms);
+void impl_poseSampleFallback(const Impl_Sequence *sequence_ptr, uint32_t joint_count, Amber_Transform *dst_transforms);
+void impl_poseAccumulate(uint32_t joint_count, const Amber_Transform *src_transforms, float weight, Amber_Transform *dst_transforms);
+void impl_poseNormalize(uint32_t joint_count, Amber_Transform *dst_transforms);
+void impl_poseApplyAdditive(uint32_t joint_count, const Amber_Transform *src_additive_transforms, float weight, Amber_Transform *dst_transforms);
+void impl_poseLerp(uint32_t joint_count, const Amber_Transform *src_transforms, const float *joint_weights, float weight, Amber_Transform *dst_transforms);
+void impl_poseComputeAdditive(uint32_t joint_count, const Amber_Transform *src_transforms, const Amber_Transform *src_reference_transforms, Amber_Transform *dst_transforms);
+void impl_poseConvertToWorld(uint32_t joint_count, const int32_t *joint_parents, const Amber_Transform *src_transforms, Amber_Transform *dst_transforms);
+void impl_poseConvertToLocal(uint32_t joint_count, const int32_t *joint_parents, const Amber_Transform *src_transforms, Amber_Transform *dst_transforms);
+void impl_sequenceSampleRootMotion(const Impl_Sequence *sequence_ptr, float prev_time, float time, Amber_Transform *dst_transform);
+void impl_waitSequence(Impl_Instance *instance_ptr, const Impl_Sequence *sequence_ptr);
+
+float impl_sequenceFetchValue(const Impl_Sequence *sequence_ptr, const Impl_SequenceCurve *curve, float time);
+Amber_Transform impl_sequenceFetchRootMotion(const Impl_Sequence *sequence_ptr, float time);
+void impl_computeRootMotion(const Amber_Transform *prev_transform, const Amber_Transform *transform, const Amber_Transform *first_transform, const Amber_Transform *last_transform, Amber_Transform *dst_transform);
+
+uint64_t impl_getSequenceMemorySize(const Amber_SequenceDesc *desc);
+const Impl_SequenceBlobHeader *impl_writeSequenceBlob(const Amber_SequenceDesc *desc, uint8_t *memory);
+void impl_bindSequence(const Impl_SequenceBlobHeader *blob, Amber_Armature armature, Impl_Block *block, Impl_Sequence *sequence_ptr);
+Amber_Result impl_validateSequenceBlob(const void *data, uint64_t size, uint32_t armature_joint_count);
+
+void *impl_allocateBlock(Impl_Instance *instance_ptr, uint64_t size, uint32_t ref_count, Amber_MemoryCategory category, Impl_Block **block);
+void impl_releaseBlock(Impl_Instance *instance_ptr, Impl_Block *block);
+
+/*
+ */
+void impl_streamSample(Impl_Stream *stream, float time, uint32_t joint_count, Amber_Transform *dst_transforms);
+void impl_streamSampleRootMotion(Impl_Stream *stream, float prev_time, float time, Amber_Transform *dst_transform);
+void impl_destroyStream(Impl_Instance *instance_ptr, Impl_Stream *stream);
+
+Amber_Result impl_fileRead(void *user_data, uint64_t offset, uint64_t size, void *data);
+void impl_fileClose(void *user_data);
+
+Amber_Result impl_instanceCreateStreamingSequence(Amber_Instance this, const Amber_StreamingSequenceDesc *desc, Amber_Sequence *sequence);
+Amber_Result impl_instanceSerializeStreamingSequence(Amber_Instance this, Amber_Sequence sequence, float chunk_duration, uint64_t *size, void *data);
+Amber_Result impl_instancePrefetchStreamingSequence(Amber_Instance this, Amber_Sequence sequence, float time, uint64_t *fence);
+
+/*
+ */
+const Impl_Sequence *impl_cacheAcquire(Impl_CacheEntry *entry);
+void impl_cacheRelease(Impl_CacheEntry *entry);
+void impl_cacheSample(const Impl_Sequence *sequence_ptr, float time, uint32_t joint_count, Amber_Transform *dst_transforms);
+void impl_cacheSampleRootMotion(Impl_CacheEntry *entry, float prev_time, float time, Amber_Transform *dst_transform);
+uint64_t impl_cachePrefetch(Impl_CacheEntry *entry);
+void impl_destroyCacheEntry(Impl_Instance *instance_ptr, Impl_CacheEntry *entry);
+
+Amber_Result impl_instanceCreateCachedSequence(Amber_Instance this, const Amber_CachedSequenceDesc *desc, Amber_Sequence *sequence);
+Amber_Result impl_instanceSetSequenceCacheBudget(Amber_Instance this, uint64_t budget);
+
+Amber_Result impl_instanceSerializeSnapshot(Amber_Instance this, uint64_t *size, void *data);
+Amber_Result impl_instanceLoadSnapshot(Amber_Instance this, const Amber_SnapshotDesc *desc);
+
+/*
+ */
+Amber_Result impl_validateSnapshotHeader(const Impl_SnapshotHeader *header, uint64_t size);
+Amber_Result impl_validateSnapshot(const Impl_SnapshotHeader *header, const Impl_SnapshotArmature *armatures, const Impl_SnapshotSequence *sequences, const uint8_t *data);
+Amber_Result impl_insertSnapshot(Impl_Instance *instance_ptr, const Impl_SnapshotHeader *header, const Impl_SnapshotArmature *armatures, const Impl_SnapshotSequence *sequences, const uint8_t *data, Impl_Block *block, Impl_Library *library);
+
+void impl_releaseLibrary(Impl_Library *library);
+
+Amber_Result impl_instanceAttachLibrary(Amber_Instance this, Amber_Library library);
+
+/*
+ */
+void impl_destroyGraph(Impl_Instance *instance_ptr, Impl_Graph *graph_ptr);
+
+Amber_Result impl_instanceCreateGraph(Amber_Instance this, const Amber_GraphDesc *desc, Amber_Graph *graph);
+Amber_Result impl_instanceDestroyGraph(Amber_Instance this, Amber_Graph graph);
+Amber_Result impl_instanceEvaluateGraph(Amber_Instance this, Amber_Graph graph, uint32_t parameter_count, const float *parameters, Amber_Pose dst_pose);
+
+/*
+ */
+Amber_Result impl_instanceSamplePose(Amber_Instance this, Amber_Sequence sequence, float time, Amber_Pose dst_pose);
+Amber_Result impl_instanceBlendPoses(Amber_Instance this, uint32_t src_pose_count, const Amber_Pose *src_poses, const float *src_weights, Amber_Pose dst_pose);
+Amber_Result impl_instanceConvertToWorldPose(Amber_Instance this, Amber_Pose src_pose, Amber_Pose dst_pose);
+Amber_Result impl_instanceConvertToLocalPose(Amber_Instance this, Amber_Pose src_pose, Amber_Pose dst_pose);
+
+Amber_Result impl_instanceSamplePoseBatch(Amber_Instance this, uint32_t count, const Amber_Sequence *sequences, const float *times, const Amber_Pose *dst_poses);
+Amber_Result impl_instanceBlendPoseBatch(Amber_Instance this, uint32_t count, const Amber_BlendDesc *descs);
+Amber_Result impl_instanceConvertToWorldPoseBatch(Amber_Instance this, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses);
+Amber_Result impl_instanceConvertToLocalPoseBatch(Amber_Instance this, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses);
+
+/*
+ */
+Amber_Result impl_instanceResolvePose(Amber_Instance this, Amber_Pose pose, Amber_ResolvedPose *resolved_pose);
+Amber_Result impl_instanceResolveSequence(Amber_Instance this, Amber_Sequence sequence, Amber_ResolvedSequence *resolved_sequence);
+Amber_Result impl_instanceGetUncheckedTable(Amber_Instance this, Amber_UncheckedTable *unchecked_table);
+
+/*
+ */
+Amber_Result impl_instanceGetInstanceStats(Amber_Instance this, Amber_InstanceStats *stats);
+Amber_Result impl_instanceGetSequenceStats(Amber_Instance this, Amber_Sequence sequence, Amber_SequenceStats *stats);
+
+/*
+ */
+void impl_destroyCapture(Impl_Instance *instance_ptr, Amber_Capture *capture);
+
+Amber_Result impl_instanceBeginCapture(Amber_Instance this, const Amber_CaptureDesc *desc);
+Amber_Result impl_instanceEndCapture(Amber_Instance this, const char *path);
@@ -0,0 +1,118 @@
+#include "impl_internal.h"
+#include "common/atomics.h"
+#include "common/intrinsics.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+void impl_releaseLibrary(Impl_Library *library)
+{
+	assert(library);
+	assert(amber_atomicLoad32(&library->ref_count) > 0);
+
+	if (amber_atomicDecrement32(&library->ref_count) > 0)
+		return;
+
+	// Note: the allocator lives inside the allocation it frees
+	Amber_Allocator allocator = library->allocator;
+	amber_allocatorFree(&allocator, library, library->size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+}
+
+/*
+ */
+Amber_Result impl_createLibrary(const Amber_LibraryDesc *desc, Amber_Library *library)
+{
+	assert(desc);
+	assert(library);
+
+	if (desc->data == NULL || desc->size < sizeof(Impl_SnapshotHeader))
+		return AMBER_INVALID_DATA;
+
+	// Note: the snapshot itself may be at any alignment, everything is read from the copy
+	const uint8_t *src = (const uint8_t *)desc->data;
+
+	Impl_SnapshotHeader header;
+	memcpy(&header, src, sizeof(Impl_SnapshotHeader));
+
+	if (impl_validateSnapshotHeader(&header, desc->size) != AMBER_SUCCESS)
+		return AMBER_INVALID_DATA;
+
+	Amber_Allocator allocator;
+	amber_allocatorInitialize(&allocator, desc->allocation_callbacks);
+
+	uint64_t library_size = alignUpul(sizeof(Impl_Library), AMBER_SIMD_ALIGNMENT);
+	uint64_t armatures_size = alignUpul(sizeof(Impl_SnapshotArmature) * header.armature_count, AMBER_DEFAULT_ALIGNMENT);
+	uint64_t sequences_size = alignUpul(sizeof(Impl_SnapshotSequence) * header.sequence_count, AMBER_SIMD_ALIGNMENT);
+	uint64_t size = library_size + armatures_size + sequences_size + header.data_size;
+
+	uint8_t *memory = (uint8_t *)amber_allocatorAllocate(&allocator, size, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	assert(memory);
+
+	Impl_SnapshotArmature *armatures = (Impl_SnapshotArmature *)(memory + library_size);
+	Impl_SnapshotSequence *sequences = (Impl_SnapshotSequence *)(memory + library_size + armatures_size);
+	uint8_t *data = memory + library_size + armatures_size + sequences_size;
+
+	memcpy(armatures, src + header.armatures_offset, sizeof(Impl_SnapshotArmature) * header.armature_count);
+	memcpy(sequences, src + header.sequences_offset, sizeof(Impl_SnapshotSequence) * header.sequence_count);
+	memcpy(data, src + header.data_offset, header.data_size);
+
+	if (impl_validateSnapshot(&header, armatures, sequences, data) != AMBER_SUCCESS)
+	{
+		amber_allocatorFree(&allocator, memory, size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+		return AMBER_INVALID_DATA;
+	}
+
+	Impl_Library *ptr = (Impl_Library *)memory;
+	ptr->allocator = allocator;
+	ptr->ref_count = 1;
+	ptr->header = header;
+	ptr->armatures = armatures;
+	ptr->sequences = sequences;
+	ptr->data = data;
+	ptr->size = size;
+
+	*library = (Amber_Library)ptr;
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_destroyLibrary(Amber_Library library)
+{
+	assert(library);
+
+	impl_releaseLibrary((Impl_Library *)library);
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+Amber_Result impl_instanceAttachLibrary(Amber_Instance this, Amber_Library library)
+{
+	assert(this);
+	assert(library);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_Library *library_ptr = (Impl_Library *)library;
+
+	const Impl_SnapshotHeader *header = &library_ptr->header;
+
+	uint32_t object_count = header->armature_count + header->sequence_count;
+	if (object_count == 0)
+		return AMBER_SUCCESS;
+
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberAttachLibrary");
+
+	// Note: references are taken up front, objects of a previous attach may already be releasing theirs
+	amber_atomicAdd32(&library_ptr->ref_count, object_count);
+
+	Amber_Result result = impl_insertSnapshot(instance_ptr, header, library_ptr->armatures, library_ptr->sequences, library_ptr->data, NULL, library_ptr);
+
+	// Note: the caller still holds a reference, so this never frees the library
+	if (result != AMBER_SUCCESS)
+		amber_atomicSubtract32(&library_ptr->ref_count, object_count);
+
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberAttachLibrary");
+
+	return result;
+}
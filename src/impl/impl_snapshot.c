@@ -0,0 +1,461 @@
+#include "impl_internal.h"
+#include "common/intrinsics.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+static AMBER_INLINE uint32_t impl_isSequenceSnapshotted(const Impl_Sequence *sequence_ptr)
+{
+	return sequence_ptr->stream == NULL && sequence_ptr->cache_entry == NULL;
+}
+
+// Note: returns 1 if a sequence that goes into the snapshot is still loading, its fence is 0 while the load
+//       is being submitted. Must be called with the sequence pool locked.
+static uint32_t impl_findLoadingSequence(const Impl_Instance *instance_ptr, uint64_t *fence)
+{
+	assert(instance_ptr);
+	assert(fence);
+
+	const Amber_Pool *sequences = &instance_ptr->sequences;
+
+	for (uint32_t i = 0; i < amber_poolGetSize(sequences); ++i)
+	{
+		const Impl_Sequence *sequence_ptr = (const Impl_Sequence *)amber_poolGetDenseElement(sequences, i);
+
+		if (!impl_isSequenceSnapshotted(sequence_ptr) || impl_isSequenceReady(sequence_ptr))
+			continue;
+
+		*fence = sequence_ptr->fence;
+		return 1;
+	}
+
+	return 0;
+}
+
+// Note: walks armatures and sequences in dense order, with 'dst' NULL only the header is filled in,
+//       otherwise tables and the data region are written at the offsets of that header.
+//       Must be called with both pools locked and no sequence loading, so that both walks see the same objects.
+static void impl_walkSnapshot(Impl_Instance *instance_ptr, Impl_SnapshotHeader *header, uint8_t *dst)
+{
+	assert(instance_ptr);
+	assert(header);
+
+	uint8_t *data = (dst) ? dst + header->data_offset : NULL;
+	uint64_t data_size = 0;
+
+	const Amber_Pool *armatures = &instance_ptr->armatures;
+	uint32_t armature_count = 0;
+
+	for (uint32_t i = 0; i < amber_poolGetSize(armatures); ++i)
+	{
+		const Impl_Armature *armature_ptr = (const Impl_Armature *)amber_poolGetDenseElement(armatures, i);
+
+		// Note: destroyed armatures are only kept alive by their poses
+		if (armature_ptr->destroyed)
+			continue;
+
+		uint32_t joint_count = armature_ptr->joint_count;
+
+		Impl_SnapshotArmature entry;
+		memset(&entry, 0, sizeof(Impl_SnapshotArmature));
+
+		entry.handle = amber_poolGetDenseHandle(armatures, i);
+		entry.joint_count = joint_count;
+		entry.pose_slab_capacity = armature_ptr->pose_slab_capacity;
+
+		entry.joint_parents_offset = data_size;
+		data_size += alignUpul(sizeof(int32_t) * joint_count, AMBER_DEFAULT_ALIGNMENT);
+
+		if (armature_ptr->joint_name_memory)
+		{
+			entry.joint_name_size = armature_ptr->joint_name_size;
+
+			entry.joint_name_offsets_offset = data_size;
+			data_size += alignUpul(sizeof(uint32_t) * joint_count, AMBER_DEFAULT_ALIGNMENT);
+
+			entry.joint_name_memory_offset = data_size;
+			data_size += alignUpul(armature_ptr->joint_name_size, AMBER_DEFAULT_ALIGNMENT);
+		}
+
+		if (dst)
+		{
+			memcpy(dst + header->armatures_offset + sizeof(Impl_SnapshotArmature) * armature_count, &entry, sizeof(Impl_SnapshotArmature));
+			memcpy(data + entry.joint_parents_offset, armature_ptr->joint_parents, sizeof(int32_t) * joint_count);
+
+			if (armature_ptr->joint_name_memory)
+			{
+				memcpy(data + entry.joint_name_offsets_offset, armature_ptr->joint_name_offsets, sizeof(uint32_t) * joint_count);
+				memcpy(data + entry.joint_name_memory_offset, armature_ptr->joint_name_memory, armature_ptr->joint_name_size);
+			}
+		}
+
+		armature_count++;
+	}
+
+	const Amber_Pool *sequences = &instance_ptr->sequences;
+	uint32_t sequence_count = 0;
+
+	for (uint32_t i = 0; i < amber_poolGetSize(sequences); ++i)
+	{
+		const Impl_Sequence *sequence_ptr = (const Impl_Sequence *)amber_poolGetDenseElement(sequences, i);
+
+		if (!impl_isSequenceSnapshotted(sequence_ptr))
+			continue;
+
+		// Note: sequences of destroyed armatures can't be loaded, their armature is not in the snapshot
+		const Impl_Armature *armature_ptr = (const Impl_Armature *)amber_poolGetElement(armatures, (Amber_PoolHandle)sequence_ptr->armature);
+		if (armature_ptr == NULL || armature_ptr->destroyed)
+			continue;
+
+		assert(impl_isSequenceReady(sequence_ptr));
+		assert(sequence_ptr->blob);
+
+		Impl_SnapshotSequence entry;
+		memset(&entry, 0, sizeof(Impl_SnapshotSequence));
+
+		entry.handle = amber_poolGetDenseHandle(sequences, i);
+		entry.armature = sequence_ptr->armature;
+		entry.blob_offset = data_size;
+		entry.blob_size = sequence_ptr->blob->size;
+
+		data_size += alignUpul(entry.blob_size, AMBER_DEFAULT_ALIGNMENT);
+
+		if (dst)
+		{
+			memcpy(dst + header->sequences_offset + sizeof(Impl_SnapshotSequence) * sequence_count, &entry, sizeof(Impl_SnapshotSequence));
+			memcpy(data + entry.blob_offset, sequence_ptr->blob, entry.blob_size);
+		}
+
+		sequence_count++;
+	}
+
+	if (dst)
+	{
+		assert(armature_count == header->armature_count);
+		assert(sequence_count == header->sequence_count);
+		assert(data_size == header->data_size);
+		return;
+	}
+
+	memset(header, 0, sizeof(Impl_SnapshotHeader));
+
+	header->magic = IMPL_SNAPSHOT_MAGIC;
+	header->version = IMPL_SNAPSHOT_VERSION;
+	header->armature_count = armature_count;
+	header->sequence_count = sequence_count;
+	header->armatures_offset = alignUpul(sizeof(Impl_SnapshotHeader), AMBER_DEFAULT_ALIGNMENT);
+	header->sequences_offset = header->armatures_offset + alignUpul(sizeof(Impl_SnapshotArmature) * armature_count, AMBER_DEFAULT_ALIGNMENT);
+	header->data_offset = alignUpul(header->sequences_offset + sizeof(Impl_SnapshotSequence) * sequence_count, AMBER_SIMD_ALIGNMENT);
+	header->data_size = data_size;
+	header->size = header->data_offset + data_size;
+}
+
+Amber_Result impl_instanceSerializeSnapshot(Amber_Instance this, uint64_t *size, void *data)
+{
+	assert(this);
+	assert(size);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberSerializeSnapshot");
+
+	// Note: loads are waited for with both pools unlocked, other threads would spin on them for the whole load
+	for (;;)
+	{
+		amber_poolLock(&instance_ptr->armatures);
+		amber_poolLock(&instance_ptr->sequences);
+
+		uint64_t fence = 0;
+		if (!impl_findLoadingSequence(instance_ptr, &fence))
+			break;
+
+		amber_poolUnlock(&instance_ptr->sequences);
+		amber_poolUnlock(&instance_ptr->armatures);
+
+		if (fence != 0)
+			amber_loaderWait(&instance_ptr->loader, fence);
+		else
+			amber_atomicPause();
+	}
+
+	Impl_SnapshotHeader header;
+	impl_walkSnapshot(instance_ptr, &header, NULL);
+
+	Amber_Result result = AMBER_SUCCESS;
+
+	if (data == NULL)
+	{
+		*size = header.size;
+	}
+	else if (*size < header.size)
+	{
+		result = AMBER_INVALID_OUTPUT_ARGUMENT;
+	}
+	else
+	{
+		uint8_t *dst = (uint8_t *)data;
+		memset(dst, 0, header.data_offset);
+		memcpy(dst, &header, sizeof(Impl_SnapshotHeader));
+
+		impl_walkSnapshot(instance_ptr, &header, dst);
+		*size = header.size;
+	}
+
+	amber_poolUnlock(&instance_ptr->sequences);
+	amber_poolUnlock(&instance_ptr->armatures);
+
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberSerializeSnapshot");
+
+	return result;
+}
+
+/*
+ */
+static AMBER_INLINE uint32_t impl_isRangeValid(uint64_t offset, uint64_t range_size, uint64_t size)
+{
+	return offset <= size && range_size <= size - offset && (offset & (AMBER_DEFAULT_ALIGNMENT - 1)) == 0;
+}
+
+Amber_Result impl_validateSnapshotHeader(const Impl_SnapshotHeader *header, uint64_t size)
+{
+	assert(header);
+
+	if (header->magic != IMPL_SNAPSHOT_MAGIC || header->version != IMPL_SNAPSHOT_VERSION || header->size > size)
+		return AMBER_INVALID_DATA;
+
+	if (!impl_isRangeValid(header->armatures_offset, sizeof(Impl_SnapshotArmature) * (uint64_t)header->armature_count, header->size))
+		return AMBER_INVALID_DATA;
+
+	if (!impl_isRangeValid(header->sequences_offset, sizeof(Impl_SnapshotSequence) * (uint64_t)header->sequence_count, header->size))
+		return AMBER_INVALID_DATA;
+
+	if (!impl_isRangeValid(header->data_offset, header->data_size, header->size))
+		return AMBER_INVALID_DATA;
+
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_validateSnapshotArmature(const Impl_SnapshotArmature *entry, const uint8_t *data, uint64_t data_size)
+{
+	assert(entry);
+	assert(data);
+
+	uint32_t joint_count = entry->joint_count;
+
+	if (joint_count == 0 || !impl_isRangeValid(entry->joint_parents_offset, sizeof(int32_t) * (uint64_t)joint_count, data_size))
+		return AMBER_INVALID_DATA;
+
+	const int32_t *parents = (const int32_t *)(data + entry->joint_parents_offset);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+		if (parents[i] >= (int32_t)i)
+			return AMBER_INVALID_DATA;
+
+	if (entry->joint_name_size == 0)
+		return AMBER_SUCCESS;
+
+	if (!impl_isRangeValid(entry->joint_name_offsets_offset, sizeof(uint32_t) * (uint64_t)joint_count, data_size))
+		return AMBER_INVALID_DATA;
+
+	if (!impl_isRangeValid(entry->joint_name_memory_offset, entry->joint_name_size, data_size))
+		return AMBER_INVALID_DATA;
+
+	const uint32_t *name_offsets = (const uint32_t *)(data + entry->joint_name_offsets_offset);
+	const char *name_memory = (const char *)(data + entry->joint_name_memory_offset);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+		if (name_offsets[i] >= entry->joint_name_size)
+			return AMBER_INVALID_DATA;
+
+	if (name_memory[entry->joint_name_size - 1] != '\0')
+		return AMBER_INVALID_DATA;
+
+	return AMBER_SUCCESS;
+}
+
+static const Impl_SnapshotArmature *impl_findSnapshotArmature(const Impl_SnapshotArmature *armatures, uint32_t armature_count, Amber_Armature armature)
+{
+	for (uint32_t i = 0; i < armature_count; ++i)
+		if (armatures[i].handle == armature)
+			return &armatures[i];
+
+	return NULL;
+}
+
+// Note: 'data' is a copy of the data region, so the copy is what gets checked
+Amber_Result impl_validateSnapshot(const Impl_SnapshotHeader *header, const Impl_SnapshotArmature *armatures, const Impl_SnapshotSequence *sequences, const uint8_t *data)
+{
+	assert(header);
+	assert(header->armature_count == 0 || armatures);
+	assert(header->sequence_count == 0 || sequences);
+	assert(data);
+
+	for (uint32_t i = 0; i < header->armature_count; ++i)
+		if (impl_validateSnapshotArmature(&armatures[i], data, header->data_size) != AMBER_SUCCESS)
+			return AMBER_INVALID_DATA;
+
+	for (uint32_t i = 0; i < header->sequence_count; ++i)
+	{
+		const Impl_SnapshotSequence *entry = &sequences[i];
+
+		if (!impl_isRangeValid(entry->blob_offset, entry->blob_size, header->data_size))
+			return AMBER_INVALID_DATA;
+
+		// Note: sequences may only reference armatures of the same snapshot
+		const Impl_SnapshotArmature *armature = impl_findSnapshotArmature(armatures, header->armature_count, entry->armature);
+		if (armature == NULL)
+			return AMBER_INVALID_DATA;
+
+		if (impl_validateSequenceBlob(data + entry->blob_offset, entry->blob_size, armature->joint_count) != AMBER_SUCCESS)
+			return AMBER_INVALID_DATA;
+	}
+
+	return AMBER_SUCCESS;
+}
+
+static void impl_unloadSnapshot(Impl_Instance *instance_ptr, const Impl_SnapshotArmature *armatures, uint32_t armature_count, const Impl_SnapshotSequence *sequences, uint32_t sequence_count)
+{
+	assert(instance_ptr);
+
+	for (uint32_t i = 0; i < sequence_count; ++i)
+		amber_poolRemoveElement(&instance_ptr->sequences, sequences[i].handle);
+
+	for (uint32_t i = 0; i < armature_count; ++i)
+	{
+		Impl_Armature *armature_ptr = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, armatures[i].handle);
+		assert(armature_ptr);
+
+		if (armature_ptr->pose_slab_capacity > 0)
+			amber_slabShutdown(&armature_ptr->pose_slab);
+
+		amber_poolRemoveElement(&instance_ptr->armatures, armatures[i].handle);
+	}
+}
+
+// Note: objects reference 'data' in place and are owned by either 'block' or 'library', which must hold one
+//       reference per object. Handles are claimed one by one, if one of them is in use everything claimed
+//       so far is given back and the owner references are left untouched.
+Amber_Result impl_insertSnapshot(Impl_Instance *instance_ptr, const Impl_SnapshotHeader *header, const Impl_SnapshotArmature *armatures, const Impl_SnapshotSequence *sequences, const uint8_t *data, Impl_Block *block, Impl_Library *library)
+{
+	assert(instance_ptr);
+	assert(header);
+	assert(data);
+	assert((block == NULL) != (library == NULL));
+
+	uint32_t armature_count = 0;
+	uint32_t sequence_count = 0;
+
+	for (; armature_count < header->armature_count; ++armature_count)
+	{
+		const Impl_SnapshotArmature *entry = &armatures[armature_count];
+
+		Impl_Armature armature_ptr;
+		memset(&armature_ptr, 0, sizeof(Impl_Armature));
+
+		armature_ptr.joint_count = entry->joint_count;
+		armature_ptr.joint_parents = (int32_t *)(data + entry->joint_parents_offset);
+		armature_ptr.pose_stride = alignUp(sizeof(Amber_Transform) * entry->joint_count, AMBER_SIMD_ALIGNMENT);
+		armature_ptr.pose_slab_capacity = entry->pose_slab_capacity;
+		armature_ptr.handle = entry->handle;
+		armature_ptr.ref_count = 1;
+		armature_ptr.block = block;
+		armature_ptr.library = library;
+
+		if (entry->joint_name_size > 0)
+		{
+			armature_ptr.joint_name_offsets = (uint32_t *)(data + entry->joint_name_offsets_offset);
+			armature_ptr.joint_name_memory = (char *)(data + entry->joint_name_memory_offset);
+			armature_ptr.joint_name_size = entry->joint_name_size;
+		}
+
+		if (amber_poolInsertElement(&instance_ptr->armatures, entry->handle, &armature_ptr) != AMBER_SUCCESS)
+		{
+			impl_unloadSnapshot(instance_ptr, armatures, armature_count, sequences, sequence_count);
+			return AMBER_INVALID_DATA;
+		}
+
+		if (entry->pose_slab_capacity > 0)
+		{
+			Impl_Armature *inserted = (Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, entry->handle);
+			amber_slabInitialize(&inserted->pose_slab, &instance_ptr->allocator, inserted->pose_stride, entry->pose_slab_capacity, AMBER_MEMORY_CATEGORY_POSE);
+		}
+	}
+
+	for (; sequence_count < header->sequence_count; ++sequence_count)
+	{
+		const Impl_SnapshotSequence *entry = &sequences[sequence_count];
+
+		Impl_Sequence sequence_ptr;
+		impl_bindSequence((const Impl_SequenceBlobHeader *)(data + entry->blob_offset), entry->armature, block, &sequence_ptr);
+		sequence_ptr.library = library;
+
+		if (amber_poolInsertElement(&instance_ptr->sequences, entry->handle, &sequence_ptr) != AMBER_SUCCESS)
+		{
+			impl_unloadSnapshot(instance_ptr, armatures, armature_count, sequences, sequence_count);
+			return AMBER_INVALID_DATA;
+		}
+	}
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceLoadSnapshot(Amber_Instance this, const Amber_SnapshotDesc *desc)
+{
+	assert(this);
+	assert(desc);
+	assert(desc->data);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	if (desc->size < sizeof(Impl_SnapshotHeader))
+		return AMBER_INVALID_DATA;
+
+	// Note: the snapshot itself may be at any alignment, the header and tables are read through copies
+	const uint8_t *src = (const uint8_t *)desc->data;
+
+	Impl_SnapshotHeader header;
+	memcpy(&header, src, sizeof(Impl_SnapshotHeader));
+
+	if (impl_validateSnapshotHeader(&header, desc->size) != AMBER_SUCCESS)
+		return AMBER_INVALID_DATA;
+
+	uint32_t object_count = header.armature_count + header.sequence_count;
+	if (object_count == 0)
+		return AMBER_SUCCESS;
+
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberLoadSnapshot");
+
+	uint64_t armatures_size = alignUpul(sizeof(Impl_SnapshotArmature) * header.armature_count, AMBER_DEFAULT_ALIGNMENT);
+	uint64_t sequences_size = sizeof(Impl_SnapshotSequence) * header.sequence_count;
+	uint64_t tables_size = armatures_size + sequences_size;
+
+	uint8_t *tables = (uint8_t *)amber_allocatorAllocate(&instance_ptr->allocator, tables_size, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	assert(tables);
+
+	Impl_SnapshotArmature *armatures = (Impl_SnapshotArmature *)tables;
+	Impl_SnapshotSequence *sequences = (Impl_SnapshotSequence *)(tables + armatures_size);
+
+	memcpy(armatures, src + header.armatures_offset, sizeof(Impl_SnapshotArmature) * header.armature_count);
+	memcpy(sequences, src + header.sequences_offset, sequences_size);
+
+	Impl_Block *block = NULL;
+	uint8_t *data = (uint8_t *)impl_allocateBlock(instance_ptr, header.data_size, object_count, AMBER_MEMORY_CATEGORY_SEQUENCE, &block);
+
+	memcpy(data, src + header.data_offset, header.data_size);
+
+	Amber_Result result = impl_validateSnapshot(&header, armatures, sequences, data);
+
+	if (result == AMBER_SUCCESS)
+		result = impl_insertSnapshot(instance_ptr, &header, armatures, sequences, data, block, NULL);
+
+	if (result != AMBER_SUCCESS)
+		amber_allocatorFree(&instance_ptr->allocator, block, block->size, block->category);
+
+	amber_allocatorFree(&instance_ptr->allocator, tables, tables_size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberLoadSnapshot");
+
+	return result;
+}
@@ -0,0 +1,195 @@
+#include "impl_internal.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*
+ */
+static AMBER_INLINE void impl_getPoolStats(const Amber_Pool *pool, Amber_PoolStats *stats)
+{
+	assert(pool);
+	assert(stats);
+
+	stats->size = amber_poolGetSize(pool);
+	stats->capacity = amber_atomicLoad32(&pool->capacity);
+}
+
+static void impl_addCurveStats(const Impl_SequenceCurve *curves, uint32_t curve_count, Amber_SequenceStats *stats)
+{
+	assert(curves);
+	assert(stats);
+
+	for (uint32_t i = 0; i < curve_count; ++i)
+	{
+		uint32_t key_count = curves[i].key_count;
+		if (key_count == 0)
+			continue;
+
+		stats->track_count++;
+		stats->key_count += key_count;
+
+		if (key_count == 1)
+			stats->constant_track_count++;
+	}
+}
+
+static void impl_addJointCurveStats(const Impl_SequenceJointCurve *joint_curve, Amber_SequenceStats *stats)
+{
+	assert(joint_curve);
+	assert(stats);
+
+	impl_addCurveStats(joint_curve->position_curves, 3, stats);
+	impl_addCurveStats(joint_curve->rotation_curves, 4, stats);
+	impl_addCurveStats(joint_curve->scale_curves, 3, stats);
+}
+
+static void impl_getSequenceStats(const Impl_Sequence *sequence_ptr, Amber_SequenceStats *stats)
+{
+	assert(sequence_ptr);
+	assert(stats);
+
+	memset(stats, 0, sizeof(Amber_SequenceStats));
+
+	stats->joint_count = sequence_ptr->joint_count;
+	stats->min_time = sequence_ptr->min_time;
+	stats->max_time = sequence_ptr->max_time;
+
+	// Note: curves of streaming sequences live in their chunks, only resident memory is reported
+	if (sequence_ptr->stream)
+	{
+		stats->memory_bytes = sequence_ptr->stream->size;
+		return;
+	}
+
+	// Note: cached sequences may be evicted at any time, only the size of their blob is reported
+	if (sequence_ptr->cache_entry)
+	{
+		stats->memory_bytes = sequence_ptr->cache_entry->size;
+		return;
+	}
+
+	for (uint32_t i = 0; i < sequence_ptr->joint_count; ++i)
+		impl_addJointCurveStats(&sequence_ptr->joint_curves[i], stats);
+
+	if (sequence_ptr->root_motion_curve)
+		impl_addJointCurveStats(sequence_ptr->root_motion_curve, stats);
+
+	stats->key_bytes = sizeof(Amber_SequenceKey) * stats->key_count;
+	stats->memory_bytes = sequence_ptr->blob->size;
+}
+
+/*
+ */
+Amber_Result impl_instanceGetInstanceStats(Amber_Instance this, Amber_InstanceStats *stats)
+{
+	assert(this);
+	assert(stats);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+
+	memset(stats, 0, sizeof(Amber_InstanceStats));
+
+	Amber_AllocatorStats allocator_stats;
+	amber_allocatorGetStats(&instance_ptr->allocator, &allocator_stats);
+
+	memcpy(stats->allocated_bytes, allocator_stats.allocated_bytes, sizeof(stats->allocated_bytes));
+	stats->allocation_count = allocator_stats.allocation_count;
+	stats->total_allocation_count = allocator_stats.total_allocation_count;
+
+	// Note: pools are walked one at a time under their own lock, objects created or destroyed
+	//       on other threads in the meantime may or may not be accounted
+	Amber_Pool *armatures = &instance_ptr->armatures;
+	amber_poolLock(armatures);
+
+	impl_getPoolStats(armatures, &stats->armatures);
+
+	for (uint32_t i = 0; i < stats->armatures.size; ++i)
+	{
+		const Impl_Armature *armature_ptr = (const Impl_Armature *)amber_poolGetDenseElement(armatures, i);
+
+		if (armature_ptr->joint_name_memory)
+			stats->joint_name_bytes += armature_ptr->joint_name_size + sizeof(uint32_t) * armature_ptr->joint_count;
+	}
+
+	amber_poolUnlock(armatures);
+
+	Amber_Pool *poses = &instance_ptr->poses;
+	amber_poolLock(poses);
+
+	impl_getPoolStats(poses, &stats->poses);
+
+	for (uint32_t i = 0; i < stats->poses.size; ++i)
+	{
+		const Impl_Pose *pose_ptr = (const Impl_Pose *)amber_poolGetDenseElement(poses, i);
+		stats->pose_transform_bytes += sizeof(Amber_Transform) * pose_ptr->joint_count;
+	}
+
+	amber_poolUnlock(poses);
+
+	Amber_Pool *sequences = &instance_ptr->sequences;
+	amber_poolLock(sequences);
+
+	impl_getPoolStats(sequences, &stats->sequences);
+
+	// Note: cache hits are counted per entry so they never touch the cache lock
+	uint64_t cache_hit_count = 0;
+
+	for (uint32_t i = 0; i < stats->sequences.size; ++i)
+	{
+		const Impl_Sequence *sequence_ptr = (const Impl_Sequence *)amber_poolGetDenseElement(sequences, i);
+
+		if (sequence_ptr->cache_entry)
+			cache_hit_count += amber_atomicLoad64(&sequence_ptr->cache_entry->hit_count);
+
+		// Note: sequences that are still loading are counted by the pool but have no curves yet
+		if (!impl_isSequenceReady(sequence_ptr))
+			continue;
+
+		Amber_SequenceStats sequence_stats;
+		impl_getSequenceStats(sequence_ptr, &sequence_stats);
+
+		stats->sequence_track_count += sequence_stats.track_count;
+		stats->sequence_key_count += sequence_stats.key_count;
+		stats->sequence_key_bytes += sequence_stats.key_bytes;
+	}
+
+	amber_poolUnlock(sequences);
+
+	amber_poolLock(&instance_ptr->graphs);
+	impl_getPoolStats(&instance_ptr->graphs, &stats->graphs);
+	amber_poolUnlock(&instance_ptr->graphs);
+
+	stats->transient_poses.size = amber_atomicLoad32(&instance_ptr->transient_pose_count);
+	stats->transient_poses.capacity = amber_atomicLoad32(&instance_ptr->transient_page_count) * IMPL_TRANSIENT_PAGE_SIZE;
+
+	Impl_SequenceCache *cache = &instance_ptr->sequence_cache;
+	amber_spinLockAcquire(&cache->lock);
+
+	stats->sequence_cache.budget_bytes = cache->budget;
+	stats->sequence_cache.resident_bytes = cache->resident_bytes;
+	stats->sequence_cache.sequence_count = cache->sequence_count;
+	stats->sequence_cache.resident_count = cache->resident_count;
+	stats->sequence_cache.hit_count = cache->hit_count + cache_hit_count;
+	stats->sequence_cache.miss_count = cache->miss_count;
+	stats->sequence_cache.eviction_count = cache->eviction_count;
+
+	amber_spinLockRelease(&cache->lock);
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceGetSequenceStats(Amber_Instance this, Amber_Sequence sequence, Amber_SequenceStats *stats)
+{
+	assert(this);
+	assert(sequence);
+	assert(stats);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Sequence *sequence_ptr = (const Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequence);
+	assert(sequence_ptr);
+
+	impl_waitSequence(instance_ptr, sequence_ptr);
+	impl_getSequenceStats(sequence_ptr, stats);
+
+	return AMBER_SUCCESS;
+}
@@ -0,0 +1,798 @@
+#include "impl_internal.h"
+#include "common/intrinsics.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#define IMPL_STREAM_CHUNK_NONE 0xFFFFFFFF
+#define IMPL_STREAM_DEFAULT_RESIDENT_CHUNK_COUNT 4
+#define IMPL_STREAM_MIN_RESIDENT_CHUNK_COUNT 2
+
+/*
+ */
+Amber_Result impl_fileRead(void *user_data, uint64_t offset, uint64_t size, void *data)
+{
+	FILE *file = (FILE *)user_data;
+	assert(file);
+	assert(data);
+
+#if defined(AMBER_PLATFORM_WIN32)
+	if (_fseeki64(file, (__int64)offset, SEEK_SET) != 0)
+		return AMBER_INVALID_DATA;
+#else
+	if (fseeko(file, (off_t)offset, SEEK_SET) != 0)
+		return AMBER_INVALID_DATA;
+#endif
+
+	if (fread(data, 1, (size_t)size, file) != size)
+		return AMBER_INVALID_DATA;
+
+	return AMBER_SUCCESS;
+}
+
+void impl_fileClose(void *user_data)
+{
+	FILE *file = (FILE *)user_data;
+	assert(file);
+
+	fclose(file);
+}
+
+/*
+ */
+static AMBER_INLINE uint32_t impl_streamGetChunk(const Impl_Stream *stream, float time)
+{
+	assert(stream);
+
+	const Impl_StreamHeader *header = &stream->header;
+	float chunk = (time - header->min_time) / header->chunk_duration;
+
+	if (!(chunk > 0.0f))
+		return 0;
+
+	if (chunk >= (float)(header->chunk_count - 1))
+		return header->chunk_count - 1;
+
+	return (uint32_t)chunk;
+}
+
+static AMBER_INLINE uint32_t impl_streamGetChunkDistance(uint32_t chunk, uint32_t first_chunk, uint32_t last_chunk)
+{
+	// Note: chunks behind the playhead weigh more, they are only needed again on rewind or loop
+	if (chunk < first_chunk)
+		return (first_chunk - chunk) * 2 + 1;
+
+	if (chunk > last_chunk)
+		return (chunk - last_chunk) * 2;
+
+	return 0;
+}
+
+static void impl_streamLoadTask(void *data)
+{
+	Impl_StreamSlot *slot = (Impl_StreamSlot *)data;
+	assert(slot);
+	assert(amber_atomicLoad32(&slot->state) == IMPL_STREAM_SLOT_LOADING);
+
+	Impl_Stream *stream = slot->stream;
+	assert(stream);
+	assert(slot->chunk < stream->header.chunk_count);
+
+	Impl_Instance *instance_ptr = stream->instance_ptr;
+	assert(instance_ptr);
+
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberLoadStreamChunk");
+
+	const Impl_StreamChunk *chunk = &stream->chunks[slot->chunk];
+	uint32_t state = IMPL_STREAM_SLOT_FAILED;
+
+	Amber_Result result = stream->callbacks.read(stream->callbacks.user_data, chunk->offset, chunk->size, slot->memory);
+
+	if (result == AMBER_SUCCESS)
+		result = impl_validateSequenceBlob(slot->memory, chunk->size, stream->armature_joint_count);
+
+	if (result == AMBER_SUCCESS)
+	{
+		const Impl_SequenceBlobHeader *blob = (const Impl_SequenceBlobHeader *)slot->memory;
+
+		if (blob->joint_count == stream->header.joint_count)
+		{
+			impl_bindSequence(blob, stream->armature, NULL, &slot->sequence);
+			state = IMPL_STREAM_SLOT_READY;
+		}
+	}
+
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberLoadStreamChunk");
+
+	amber_atomicStore32(&slot->state, state);
+}
+
+/*
+ */
+// Note: the functions below must be called with the stream lock held
+static Impl_StreamSlot *impl_streamFindSlot(Impl_Stream *stream, uint32_t chunk)
+{
+	assert(stream);
+
+	for (uint32_t i = 0; i < stream->slot_count; ++i)
+	{
+		Impl_StreamSlot *slot = &stream->slots[i];
+		uint32_t state = amber_atomicLoad32(&slot->state);
+
+		if (slot->chunk == chunk && (state == IMPL_STREAM_SLOT_LOADING || state == IMPL_STREAM_SLOT_READY))
+			return slot;
+	}
+
+	return NULL;
+}
+
+static Impl_StreamSlot *impl_streamEvictSlot(Impl_Stream *stream, uint32_t first_chunk, uint32_t last_chunk)
+{
+	assert(stream);
+
+	Impl_StreamSlot *result = NULL;
+	uint32_t result_distance = 0;
+
+	for (uint32_t i = 0; i < stream->slot_count; ++i)
+	{
+		Impl_StreamSlot *slot = &stream->slots[i];
+		uint32_t state = amber_atomicLoad32(&slot->state);
+
+		if (state == IMPL_STREAM_SLOT_EMPTY || state == IMPL_STREAM_SLOT_FAILED)
+			return slot;
+
+		if (state == IMPL_STREAM_SLOT_LOADING || amber_atomicLoad32(&slot->pin_count) > 0)
+			continue;
+
+		uint32_t distance = impl_streamGetChunkDistance(slot->chunk, first_chunk, last_chunk);
+
+		if (distance > result_distance)
+		{
+			result = slot;
+			result_distance = distance;
+		}
+	}
+
+	return result;
+}
+
+static uint64_t impl_streamRequest(Impl_Stream *stream, uint32_t chunk)
+{
+	assert(stream);
+	assert(chunk < stream->header.chunk_count);
+
+	uint32_t last_chunk = chunk + stream->prefetch_count;
+	if (last_chunk >= stream->header.chunk_count)
+		last_chunk = stream->header.chunk_count - 1;
+
+	uint64_t result = 0;
+
+	for (uint32_t i = chunk; i <= last_chunk; ++i)
+	{
+		Impl_StreamSlot *slot = impl_streamFindSlot(stream, i);
+
+		if (slot == NULL)
+		{
+			slot = impl_streamEvictSlot(stream, chunk, last_chunk);
+
+			// Note: every other slot is pinned or loading, the rest of the window is requested on a later call
+			if (slot == NULL)
+				break;
+
+			slot->chunk = i;
+			amber_atomicStore32(&slot->state, IMPL_STREAM_SLOT_LOADING);
+
+			slot->fence = amber_loaderSubmit(&stream->instance_ptr->loader, &slot->task);
+		}
+
+		if (amber_atomicLoad32(&slot->state) == IMPL_STREAM_SLOT_LOADING && slot->fence > result)
+			result = slot->fence;
+	}
+
+	return result;
+}
+
+static Impl_StreamSlot *impl_streamPinSlot(Impl_Stream *stream, uint32_t chunk, uint32_t closest)
+{
+	assert(stream);
+
+	Impl_StreamSlot *result = NULL;
+	uint32_t result_distance = UINT32_MAX;
+
+	for (uint32_t i = 0; i < stream->slot_count; ++i)
+	{
+		Impl_StreamSlot *slot = &stream->slots[i];
+
+		if (amber_atomicLoad32(&slot->state) != IMPL_STREAM_SLOT_READY)
+			continue;
+
+		uint32_t distance = (slot->chunk > chunk) ? slot->chunk - chunk : chunk - slot->chunk;
+
+		if (distance < result_distance && (closest || distance == 0))
+		{
+			result = slot;
+			result_distance = distance;
+		}
+	}
+
+	if (result)
+		amber_atomicIncrement32(&result->pin_count);
+
+	return result;
+}
+
+static AMBER_INLINE void impl_streamUnpinSlot(Impl_StreamSlot *slot)
+{
+	assert(slot);
+	assert(amber_atomicLoad32(&slot->pin_count) > 0);
+
+	amber_atomicDecrement32(&slot->pin_count);
+}
+
+/*
+ */
+void impl_streamSample(Impl_Stream *stream, float time, uint32_t joint_count, Amber_Transform *dst_transforms)
+{
+	assert(stream);
+	assert(dst_transforms);
+
+	uint32_t chunk = impl_streamGetChunk(stream, time);
+
+	amber_spinLockAcquire(&stream->lock);
+
+	impl_streamRequest(stream, chunk);
+	Impl_StreamSlot *slot = impl_streamPinSlot(stream, chunk, 1);
+
+	amber_spinLockRelease(&stream->lock);
+
+	if (slot == NULL)
+		return;
+
+	impl_poseSample(&slot->sequence, time, joint_count, dst_transforms);
+	impl_streamUnpinSlot(slot);
+}
+
+void impl_streamSampleRootMotion(Impl_Stream *stream, float prev_time, float time, Amber_Transform *dst_transform)
+{
+	assert(stream);
+	assert(dst_transform);
+
+	Amber_Transform result = (Amber_Transform)
+	{
+		0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f,
+		1.0f, 1.0f, 1.0f,
+	};
+
+	const Impl_StreamHeader *header = &stream->header;
+
+	if ((header->flags & IMPL_SEQUENCE_BLOB_FLAG_ROOT_MOTION) == 0)
+	{
+		*dst_transform = result;
+		return;
+	}
+
+	float times[4] = { prev_time, time, header->root_motion_min_time, header->root_motion_max_time };
+	uint32_t count = (prev_time < time) ? 2 : 4;
+
+	Impl_StreamSlot *slots[4] = { NULL, NULL, NULL, NULL };
+	uint32_t resident = 1;
+
+	amber_spinLockAcquire(&stream->lock);
+
+	impl_streamRequest(stream, impl_streamGetChunk(stream, time));
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		slots[i] = impl_streamPinSlot(stream, impl_streamGetChunk(stream, times[i]), 0);
+		resident = resident && slots[i];
+	}
+
+	amber_spinLockRelease(&stream->lock);
+
+	if (resident)
+	{
+		Amber_Transform transforms[4];
+
+		for (uint32_t i = 0; i < count; ++i)
+			transforms[i] = impl_sequenceFetchRootMotion(&slots[i]->sequence, times[i]);
+
+		if (count == 2)
+			impl_computeRootMotion(&transforms[0], &transforms[1], NULL, NULL, &result);
+		else
+			impl_computeRootMotion(&transforms[0], &transforms[1], &transforms[2], &transforms[3], &result);
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+		if (slots[i])
+			impl_streamUnpinSlot(slots[i]);
+
+	*dst_transform = result;
+}
+
+void impl_destroyStream(Impl_Instance *instance_ptr, Impl_Stream *stream)
+{
+	assert(instance_ptr);
+	assert(stream);
+
+	// Note: the loader may already be shut down when the instance is destroyed, all loads are finished then
+	for (uint32_t i = 0; i < stream->slot_count; ++i)
+	{
+		Impl_StreamSlot *slot = &stream->slots[i];
+		assert(amber_atomicLoad32(&slot->pin_count) == 0);
+
+		if (amber_atomicLoad32(&slot->state) == IMPL_STREAM_SLOT_LOADING)
+			amber_loaderWait(&instance_ptr->loader, slot->fence);
+	}
+
+	if (stream->callbacks.close)
+		stream->callbacks.close(stream->callbacks.user_data);
+
+	amber_allocatorFree(&instance_ptr->allocator, stream, stream->size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+}
+
+/*
+ */
+static Amber_Result impl_validateStreamHeader(const Impl_StreamHeader *header)
+{
+	assert(header);
+
+	if (header->magic != IMPL_STREAM_MAGIC || header->version != IMPL_STREAM_VERSION)
+		return AMBER_INVALID_DATA;
+
+	if (header->joint_count == 0 || header->chunk_count == 0 || !(header->chunk_duration > 0.0f))
+		return AMBER_INVALID_DATA;
+
+	if (header->max_chunk_size < sizeof(Impl_SequenceBlobHeader) || header->max_chunk_size > header->size)
+		return AMBER_INVALID_DATA;
+
+	if (header->chunks_offset < sizeof(Impl_StreamHeader) || header->chunks_offset > header->size)
+		return AMBER_INVALID_DATA;
+
+	if (sizeof(Impl_StreamChunk) * (uint64_t)header->chunk_count > header->size - header->chunks_offset)
+		return AMBER_INVALID_DATA;
+
+	return AMBER_SUCCESS;
+}
+
+// Note: chunk blobs are validated when they are loaded, here only their range is checked against the slot size
+static Amber_Result impl_validateStreamChunks(const Impl_StreamHeader *header, const Impl_StreamChunk *chunks)
+{
+	assert(header);
+	assert(chunks);
+
+	for (uint32_t i = 0; i < header->chunk_count; ++i)
+	{
+		const Impl_StreamChunk *chunk = &chunks[i];
+
+		if (chunk->size > header->max_chunk_size || chunk->offset > header->size || chunk->size > header->size - chunk->offset)
+			return AMBER_INVALID_DATA;
+	}
+
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceCreateStreamingSequence(Amber_Instance this, const Amber_StreamingSequenceDesc *desc, Amber_Sequence *sequence)
+{
+	assert(this);
+	assert(desc);
+	assert(sequence);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Armature *armature_ptr = (const Impl_Armature *)amber_poolGetElement(&instance_ptr->armatures, (Amber_PoolHandle)desc->armature);
+	assert(armature_ptr);
+
+	Amber_StreamCallbacks callbacks = desc->callbacks;
+
+	if (callbacks.read == NULL)
+	{
+		assert(desc->path);
+
+		FILE *file = fopen(desc->path, "rb");
+		if (file == NULL)
+			return AMBER_INVALID_DATA;
+
+		callbacks.user_data = file;
+		callbacks.read = impl_fileRead;
+		callbacks.close = impl_fileClose;
+	}
+
+	Impl_StreamHeader header;
+	Amber_Result result = callbacks.read(callbacks.user_data, 0, sizeof(Impl_StreamHeader), &header);
+
+	if (result == AMBER_SUCCESS)
+		result = impl_validateStreamHeader(&header);
+
+	if (result != AMBER_SUCCESS)
+	{
+		if (callbacks.close)
+			callbacks.close(callbacks.user_data);
+
+		return AMBER_INVALID_DATA;
+	}
+
+	uint32_t slot_count = (desc->resident_chunk_count > 0) ? desc->resident_chunk_count : IMPL_STREAM_DEFAULT_RESIDENT_CHUNK_COUNT;
+	if (slot_count < IMPL_STREAM_MIN_RESIDENT_CHUNK_COUNT)
+		slot_count = IMPL_STREAM_MIN_RESIDENT_CHUNK_COUNT;
+
+	// Note: one slot is always left for the chunk behind the playhead
+	uint32_t prefetch_count = desc->prefetch_chunk_count;
+	if (prefetch_count > slot_count - 2)
+		prefetch_count = slot_count - 2;
+
+	uint64_t slot_stride = alignUpul(header.max_chunk_size, AMBER_SIMD_ALIGNMENT);
+
+	uint64_t chunks_offset = alignUpul(sizeof(Impl_Stream), AMBER_DEFAULT_ALIGNMENT);
+	uint64_t slots_offset = chunks_offset + alignUpul(sizeof(Impl_StreamChunk) * header.chunk_count, AMBER_DEFAULT_ALIGNMENT);
+	uint64_t memory_offset = alignUpul(slots_offset + sizeof(Impl_StreamSlot) * slot_count, AMBER_SIMD_ALIGNMENT);
+	uint64_t size = memory_offset + slot_stride * slot_count;
+
+	uint8_t *memory = (uint8_t *)amber_allocatorAllocate(&instance_ptr->allocator, size, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	assert(memory);
+
+	Impl_StreamChunk *chunks = (Impl_StreamChunk *)(memory + chunks_offset);
+	result = callbacks.read(callbacks.user_data, header.chunks_offset, sizeof(Impl_StreamChunk) * header.chunk_count, chunks);
+
+	if (result == AMBER_SUCCESS)
+		result = impl_validateStreamChunks(&header, chunks);
+
+	if (result != AMBER_SUCCESS)
+	{
+		amber_allocatorFree(&instance_ptr->allocator, memory, size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+
+		if (callbacks.close)
+			callbacks.close(callbacks.user_data);
+
+		return AMBER_INVALID_DATA;
+	}
+
+	Impl_Stream *stream = (Impl_Stream *)memory;
+	memset(stream, 0, sizeof(Impl_Stream));
+
+	stream->instance_ptr = instance_ptr;
+	stream->armature = desc->armature;
+	stream->armature_joint_count = armature_ptr->joint_count;
+	stream->callbacks = callbacks;
+	stream->header = header;
+	stream->chunks = chunks;
+	stream->slots = (Impl_StreamSlot *)(memory + slots_offset);
+	stream->slot_count = slot_count;
+	stream->prefetch_count = prefetch_count;
+	stream->size = size;
+
+	for (uint32_t i = 0; i < slot_count; ++i)
+	{
+		Impl_StreamSlot *slot = &stream->slots[i];
+		memset(slot, 0, sizeof(Impl_StreamSlot));
+
+		slot->task.function = impl_streamLoadTask;
+		slot->task.data = slot;
+		slot->stream = stream;
+		slot->memory = memory + memory_offset + slot_stride * i;
+		slot->chunk = IMPL_STREAM_CHUNK_NONE;
+		slot->state = IMPL_STREAM_SLOT_EMPTY;
+	}
+
+	Impl_Sequence sequence_ptr;
+	memset(&sequence_ptr, 0, sizeof(Impl_Sequence));
+	sequence_ptr.armature = desc->armature;
+	sequence_ptr.joint_count = header.joint_count;
+	sequence_ptr.min_time = header.min_time;
+	sequence_ptr.max_time = header.max_time;
+	sequence_ptr.state = IMPL_SEQUENCE_STATE_READY;
+	sequence_ptr.stream = stream;
+
+	*sequence = (Amber_Sequence)amber_poolAddElement(&instance_ptr->sequences, &sequence_ptr);
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instancePrefetchStreamingSequence(Amber_Instance this, Amber_Sequence sequence, float time, uint64_t *fence)
+{
+	assert(this);
+	assert(sequence);
+	assert(fence);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Sequence *sequence_ptr = (const Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequence);
+	assert(sequence_ptr);
+
+	*fence = 0;
+
+	if (sequence_ptr->cache_entry)
+	{
+		*fence = impl_cachePrefetch(sequence_ptr->cache_entry);
+		return AMBER_SUCCESS;
+	}
+
+	Impl_Stream *stream = sequence_ptr->stream;
+	if (stream == NULL)
+		return AMBER_SUCCESS;
+
+	amber_spinLockAcquire(&stream->lock);
+	*fence = impl_streamRequest(stream, impl_streamGetChunk(stream, time));
+	amber_spinLockRelease(&stream->lock);
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+// Note: every animated curve gets interpolated keys at both ends of the chunk, so sampling anywhere
+//       inside the chunk matches the source sequence. Constant curves are copied as-is.
+static uint32_t impl_sliceCurve(const Impl_Sequence *sequence_ptr, const Impl_SequenceCurve *src_curve, float start_time, float end_time, Amber_SequenceKey *dst_keys)
+{
+	assert(sequence_ptr);
+	assert(src_curve);
+	assert(dst_keys);
+
+	if (src_curve->key_count == 0)
+		return 0;
+
+	const Amber_SequenceKey *src_keys = sequence_ptr->keys + src_curve->first_key;
+
+	if (src_curve->key_count == 1)
+	{
+		dst_keys[0] = src_keys[0];
+		return 1;
+	}
+
+	uint32_t result = 0;
+
+	memset(&dst_keys[result], 0, sizeof(Amber_SequenceKey));
+	dst_keys[result].time = start_time;
+	dst_keys[result].value = impl_sequenceFetchValue(sequence_ptr, src_curve, start_time);
+	result++;
+
+	for (uint32_t i = 0; i < src_curve->key_count; ++i)
+		if (src_keys[i].time > start_time && src_keys[i].time < end_time)
+			dst_keys[result++] = src_keys[i];
+
+	if (end_time > start_time)
+	{
+		memset(&dst_keys[result], 0, sizeof(Amber_SequenceKey));
+		dst_keys[result].time = end_time;
+		dst_keys[result].value = impl_sequenceFetchValue(sequence_ptr, src_curve, end_time);
+		result++;
+	}
+
+	return result;
+}
+
+static void impl_sliceJointCurve(const Impl_Sequence *sequence_ptr, const Impl_SequenceJointCurve *src_joint_curve, float start_time, float end_time, Amber_SequenceJointCurve *dst_joint_curve, Amber_SequenceKey *keys, uint64_t *key_count)
+{
+	assert(src_joint_curve);
+	assert(dst_joint_curve);
+	assert(key_count);
+
+	const Impl_SequenceCurve *src_curves[10] =
+	{
+		&src_joint_curve->position_curves[0],
+		&src_joint_curve->position_curves[1],
+		&src_joint_curve->position_curves[2],
+
+		&src_joint_curve->rotation_curves[0],
+		&src_joint_curve->rotation_curves[1],
+		&src_joint_curve->rotation_curves[2],
+		&src_joint_curve->rotation_curves[3],
+
+		&src_joint_curve->scale_curves[0],
+		&src_joint_curve->scale_curves[1],
+		&src_joint_curve->scale_curves[2],
+	};
+
+	Amber_SequenceCurve *dst_curves[10] =
+	{
+		&dst_joint_curve->position_curves[0],
+		&dst_joint_curve->position_curves[1],
+		&dst_joint_curve->position_curves[2],
+
+		&dst_joint_curve->rotation_curves[0],
+		&dst_joint_curve->rotation_curves[1],
+		&dst_joint_curve->rotation_curves[2],
+		&dst_joint_curve->rotation_curves[3],
+
+		&dst_joint_curve->scale_curves[0],
+		&dst_joint_curve->scale_curves[1],
+		&dst_joint_curve->scale_curves[2],
+	};
+
+	for (uint32_t j = 0; j < 10; ++j)
+	{
+		Amber_SequenceKey *dst_keys = keys + *key_count;
+
+		dst_curves[j]->key_count = impl_sliceCurve(sequence_ptr, src_curves[j], start_time, end_time, dst_keys);
+		dst_curves[j]->keys = dst_keys;
+
+		*key_count += dst_curves[j]->key_count;
+	}
+}
+
+static void impl_sliceSequence(const Impl_Sequence *sequence_ptr, float start_time, float end_time, Amber_SequenceJointCurve *joint_curves, Amber_SequenceKey *keys, Amber_SequenceDesc *desc)
+{
+	assert(sequence_ptr);
+	assert(joint_curves);
+	assert(keys);
+	assert(desc);
+
+	uint64_t key_count = 0;
+
+	for (uint32_t i = 0; i < sequence_ptr->joint_count; ++i)
+		impl_sliceJointCurve(sequence_ptr, &sequence_ptr->joint_curves[i], start_time, end_time, &joint_curves[i], keys, &key_count);
+
+	if (sequence_ptr->root_motion_curve)
+		impl_sliceJointCurve(sequence_ptr, sequence_ptr->root_motion_curve, start_time, end_time, &joint_curves[sequence_ptr->joint_count], keys, &key_count);
+
+	memset(desc, 0, sizeof(Amber_SequenceDesc));
+	desc->armature = sequence_ptr->armature;
+	desc->joint_count = sequence_ptr->joint_count;
+	desc->joint_indices = sequence_ptr->joint_indices;
+	desc->joint_curves = joint_curves;
+	desc->root_motion_curve = (sequence_ptr->root_motion_curve) ? &joint_curves[sequence_ptr->joint_count] : NULL;
+}
+
+static AMBER_INLINE void impl_getChunkTimeRange(const Impl_StreamHeader *header, uint32_t chunk, float *start_time, float *end_time)
+{
+	assert(header);
+	assert(chunk < header->chunk_count);
+	assert(start_time);
+	assert(end_time);
+
+	*start_time = header->min_time + header->chunk_duration * (float)chunk;
+	*end_time = (chunk + 1 == header->chunk_count) ? header->max_time : header->min_time + header->chunk_duration * (float)(chunk + 1);
+}
+
+// Note: chunks are sliced twice, once to size them and once to write them through a scratch blob,
+//       so that 'data' needs no particular alignment
+Amber_Result impl_instanceSerializeStreamingSequence(Amber_Instance this, Amber_Sequence sequence, float chunk_duration, uint64_t *size, void *data)
+{
+	assert(this);
+	assert(sequence);
+	assert(chunk_duration > 0.0f);
+	assert(size);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	const Impl_Sequence *sequence_ptr = (const Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequence);
+	assert(sequence_ptr);
+
+	impl_waitSequence(instance_ptr, sequence_ptr);
+
+	if (sequence_ptr->stream)
+		return AMBER_NOT_IMPLEMENTED;
+
+	Impl_CacheEntry *cache_entry = sequence_ptr->cache_entry;
+
+	if (cache_entry)
+	{
+		sequence_ptr = impl_cacheAcquire(cache_entry);
+		if (sequence_ptr == NULL)
+			return AMBER_INVALID_DATA;
+	}
+
+	assert(sequence_ptr->blob);
+
+	const Impl_SequenceBlobHeader *blob = sequence_ptr->blob;
+
+	Impl_StreamHeader header;
+	memset(&header, 0, sizeof(Impl_StreamHeader));
+
+	header.magic = IMPL_STREAM_MAGIC;
+	header.version = IMPL_STREAM_VERSION;
+	header.joint_count = sequence_ptr->joint_count;
+	header.flags = blob->flags & IMPL_SEQUENCE_BLOB_FLAG_ROOT_MOTION;
+	header.chunk_duration = chunk_duration;
+	header.min_time = sequence_ptr->min_time;
+	header.max_time = sequence_ptr->max_time;
+
+	// Note: sequences without any key have an empty time range, they are written as a single chunk
+	if (!(header.max_time >= header.min_time))
+		header.max_time = header.min_time = 0.0f;
+
+	double chunk_count = ceil(((double)header.max_time - (double)header.min_time) / (double)chunk_duration);
+	assert(chunk_count < (double)UINT32_MAX);
+
+	header.chunk_count = (chunk_count > 1.0) ? (uint32_t)chunk_count : 1;
+
+	if (sequence_ptr->root_motion_curve)
+	{
+		header.root_motion_min_time = sequence_ptr->root_motion_curve->min_time;
+		header.root_motion_max_time = sequence_ptr->root_motion_curve->max_time;
+	}
+
+	uint32_t curve_count = sequence_ptr->joint_count + ((sequence_ptr->root_motion_curve) ? 1 : 0);
+	uint64_t key_capacity = blob->key_count + 2 * 10 * (uint64_t)curve_count;
+
+	uint64_t joint_curves_size = sizeof(Amber_SequenceJointCurve) * curve_count;
+	uint64_t scratch_size = alignUpul(joint_curves_size, AMBER_DEFAULT_ALIGNMENT) + sizeof(Amber_SequenceKey) * key_capacity;
+
+	uint8_t *scratch = (uint8_t *)amber_allocatorAllocate(&instance_ptr->allocator, scratch_size, AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	assert(scratch);
+
+	Amber_SequenceJointCurve *joint_curves = (Amber_SequenceJointCurve *)scratch;
+	Amber_SequenceKey *keys = (Amber_SequenceKey *)(scratch + alignUpul(joint_curves_size, AMBER_DEFAULT_ALIGNMENT));
+
+	AMBER_PROFILER_ZONE_BEGIN(&instance_ptr->profiler, "amberSerializeStreamingSequence");
+
+	header.chunks_offset = alignUpul(sizeof(Impl_StreamHeader), AMBER_DEFAULT_ALIGNMENT);
+
+	uint64_t offset = header.chunks_offset + alignUpul(sizeof(Impl_StreamChunk) * header.chunk_count, AMBER_DEFAULT_ALIGNMENT);
+
+	for (uint32_t i = 0; i < header.chunk_count; ++i)
+	{
+		float start_time = 0.0f;
+		float end_time = 0.0f;
+		impl_getChunkTimeRange(&header, i, &start_time, &end_time);
+
+		Amber_SequenceDesc desc;
+		impl_sliceSequence(sequence_ptr, start_time, end_time, joint_curves, keys, &desc);
+
+		uint64_t chunk_size = impl_getSequenceMemorySize(&desc);
+
+		if (chunk_size > header.max_chunk_size)
+			header.max_chunk_size = chunk_size;
+
+		offset += alignUpul(chunk_size, AMBER_DEFAULT_ALIGNMENT);
+	}
+
+	header.size = offset;
+
+	Amber_Result result = AMBER_SUCCESS;
+
+	if (data == NULL)
+	{
+		*size = header.size;
+	}
+	else if (*size < header.size)
+	{
+		result = AMBER_INVALID_OUTPUT_ARGUMENT;
+	}
+	else
+	{
+		uint8_t *chunk_memory = (uint8_t *)amber_allocatorAllocate(&instance_ptr->allocator, header.max_chunk_size, AMBER_SIMD_ALIGNMENT, AMBER_MEMORY_CATEGORY_SEQUENCE);
+		assert(chunk_memory);
+
+		uint8_t *dst = (uint8_t *)data;
+		memset(dst, 0, header.size);
+		memcpy(dst, &header, sizeof(Impl_StreamHeader));
+
+		offset = header.chunks_offset + alignUpul(sizeof(Impl_StreamChunk) * header.chunk_count, AMBER_DEFAULT_ALIGNMENT);
+
+		for (uint32_t i = 0; i < header.chunk_count; ++i)
+		{
+			float start_time = 0.0f;
+			float end_time = 0.0f;
+			impl_getChunkTimeRange(&header, i, &start_time, &end_time);
+
+			Amber_SequenceDesc desc;
+			impl_sliceSequence(sequence_ptr, start_time, end_time, joint_curves, keys, &desc);
+
+			const Impl_SequenceBlobHeader *chunk_blob = impl_writeSequenceBlob(&desc, chunk_memory);
+			assert(chunk_blob->size <= header.max_chunk_size);
+
+			Impl_StreamChunk chunk;
+			chunk.offset = offset;
+			chunk.size = chunk_blob->size;
+
+			memcpy(dst + header.chunks_offset + sizeof(Impl_StreamChunk) * i, &chunk, sizeof(Impl_StreamChunk));
+			memcpy(dst + offset, chunk_blob, chunk_blob->size);
+
+			offset += alignUpul(chunk_blob->size, AMBER_DEFAULT_ALIGNMENT);
+		}
+
+		assert(offset == header.size);
+		*size = header.size;
+
+		amber_allocatorFree(&instance_ptr->allocator, chunk_memory, header.max_chunk_size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+	}
+
+	AMBER_PROFILER_ZONE_END(&instance_ptr->profiler, "amberSerializeStreamingSequence");
+
+	amber_allocatorFree(&instance_ptr->allocator, scratch, scratch_size, AMBER_MEMORY_CATEGORY_SEQUENCE);
+
+	if (cache_entry)
+		impl_cacheRelease(cache_entry);
+
+	return result;
+}
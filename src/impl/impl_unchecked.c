@@ -0,0 +1,244 @@
+#include "impl_internal.h"
+
+#include <assert.h>
+#include <string.h>
+
+/*
+ */
+static AMBER_INLINE Impl_Pose *impl_resolvedPose(Amber_ResolvedPose pose)
+{
+	return (Impl_Pose *)(uintptr_t)pose;
+}
+
+static AMBER_INLINE const Impl_Sequence *impl_resolvedSequence(Amber_ResolvedSequence sequence)
+{
+	return (const Impl_Sequence *)(uintptr_t)sequence;
+}
+
+/*
+ */
+static Amber_Result impl_uncheckedCopyPose(Amber_Instance this, Amber_ResolvedPose src_pose, Amber_ResolvedPose dst_pose)
+{
+	AMBER_UNUSED(this);
+
+	const Impl_Pose *src_pose_ptr = impl_resolvedPose(src_pose);
+	Impl_Pose *dst_pose_ptr = impl_resolvedPose(dst_pose);
+	assert(src_pose_ptr);
+	assert(dst_pose_ptr);
+	assert(src_pose_ptr->joint_count == dst_pose_ptr->joint_count);
+
+	memcpy(dst_pose_ptr->transforms, src_pose_ptr->transforms, sizeof(Amber_Transform) * dst_pose_ptr->joint_count);
+
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_uncheckedMapPose(Amber_Instance this, Amber_ResolvedPose pose, Amber_Transform **transforms)
+{
+	AMBER_UNUSED(this);
+
+	const Impl_Pose *pose_ptr = impl_resolvedPose(pose);
+	assert(pose_ptr);
+	assert(transforms);
+
+	*transforms = pose_ptr->transforms;
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_uncheckedSampleRootMotion(Amber_Instance this, Amber_ResolvedSequence sequence, float prev_time, float time, Amber_Transform *dst_transform)
+{
+	AMBER_UNUSED(this);
+
+	const Impl_Sequence *sequence_ptr = impl_resolvedSequence(sequence);
+	assert(sequence_ptr);
+	assert(dst_transform);
+
+	impl_sequenceSampleRootMotion(sequence_ptr, prev_time, time, dst_transform);
+
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_uncheckedSamplePose(Amber_Instance this, Amber_ResolvedSequence sequence, float time, Amber_ResolvedPose dst_pose)
+{
+	AMBER_UNUSED(this);
+
+	const Impl_Sequence *sequence_ptr = impl_resolvedSequence(sequence);
+	Impl_Pose *dst_pose_ptr = impl_resolvedPose(dst_pose);
+	assert(sequence_ptr);
+	assert(dst_pose_ptr);
+
+	impl_poseSample(sequence_ptr, time, dst_pose_ptr->joint_count, dst_pose_ptr->transforms);
+
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_uncheckedBlendPoses(Amber_Instance this, uint32_t src_pose_count, const Amber_ResolvedPose *src_poses, const float *src_weights, Amber_ResolvedPose dst_pose)
+{
+	AMBER_UNUSED(this);
+
+	assert(src_pose_count > 0);
+	assert(src_poses);
+	assert(src_weights);
+
+	Impl_Pose *dst_pose_ptr = impl_resolvedPose(dst_pose);
+	assert(dst_pose_ptr);
+
+	memset(dst_pose_ptr->transforms, 0, sizeof(Amber_Transform) * dst_pose_ptr->joint_count);
+	for (uint32_t i = 0; i < src_pose_count; ++i)
+	{
+		const Impl_Pose *src_pose_ptr = impl_resolvedPose(src_poses[i]);
+		assert(src_pose_ptr);
+		assert(src_pose_ptr->joint_count == dst_pose_ptr->joint_count);
+
+		float src_weight = src_weights[i];
+
+		if (src_weight == 0.0f)
+			continue;
+
+		impl_poseAccumulate(dst_pose_ptr->joint_count, src_pose_ptr->transforms, src_weight, dst_pose_ptr->transforms);
+	}
+
+	impl_poseNormalize(dst_pose_ptr->joint_count, dst_pose_ptr->transforms);
+
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_uncheckedComputeAdditivePose(Amber_Instance this, Amber_ResolvedPose src_pose, Amber_ResolvedPose src_reference_pose, Amber_ResolvedPose dst_pose)
+{
+	AMBER_UNUSED(this);
+
+	const Impl_Pose *src_pose_ptr = impl_resolvedPose(src_pose);
+	const Impl_Pose *src_reference_pose_ptr = impl_resolvedPose(src_reference_pose);
+	Impl_Pose *dst_pose_ptr = impl_resolvedPose(dst_pose);
+	assert(src_pose_ptr);
+	assert(src_reference_pose_ptr);
+	assert(dst_pose_ptr);
+
+	impl_poseComputeAdditive(dst_pose_ptr->joint_count, src_pose_ptr->transforms, src_reference_pose_ptr->transforms, dst_pose_ptr->transforms);
+
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_uncheckedApplyAdditivePoses(Amber_Instance this, Amber_ResolvedPose src_pose, uint32_t src_additive_pose_count, const Amber_ResolvedPose *src_additive_poses, const float *src_weights, Amber_ResolvedPose dst_pose)
+{
+	AMBER_UNUSED(this);
+
+	assert(src_additive_pose_count > 0);
+	assert(src_additive_poses);
+	assert(src_weights);
+
+	const Impl_Pose *src_pose_ptr = impl_resolvedPose(src_pose);
+	Impl_Pose *dst_pose_ptr = impl_resolvedPose(dst_pose);
+	assert(src_pose_ptr);
+	assert(dst_pose_ptr);
+
+	if (src_pose_ptr != dst_pose_ptr)
+		memcpy(dst_pose_ptr->transforms, src_pose_ptr->transforms, sizeof(Amber_Transform) * dst_pose_ptr->joint_count);
+
+	for (uint32_t i = 0; i < src_additive_pose_count; ++i)
+	{
+		const Impl_Pose *src_additive_pose_ptr = impl_resolvedPose(src_additive_poses[i]);
+		assert(src_additive_pose_ptr);
+
+		float src_weight = src_weights[i];
+
+		if (src_weight == 0.0f)
+			continue;
+
+		impl_poseApplyAdditive(dst_pose_ptr->joint_count, src_additive_pose_ptr->transforms, src_weight, dst_pose_ptr->transforms);
+	}
+
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_uncheckedConvertToWorldPose(Amber_Instance this, Amber_ResolvedPose src_pose, Amber_ResolvedPose dst_pose)
+{
+	AMBER_UNUSED(this);
+
+	const Impl_Pose *src_pose_ptr = impl_resolvedPose(src_pose);
+	Impl_Pose *dst_pose_ptr = impl_resolvedPose(dst_pose);
+	assert(src_pose_ptr);
+	assert(dst_pose_ptr);
+
+	const Impl_Armature *armature_ptr = dst_pose_ptr->armature_ptr;
+	assert(armature_ptr);
+
+	impl_poseConvertToWorld(armature_ptr->joint_count, armature_ptr->joint_parents, src_pose_ptr->transforms, dst_pose_ptr->transforms);
+
+	return AMBER_SUCCESS;
+}
+
+static Amber_Result impl_uncheckedConvertToLocalPose(Amber_Instance this, Amber_ResolvedPose src_pose, Amber_ResolvedPose dst_pose)
+{
+	AMBER_UNUSED(this);
+
+	const Impl_Pose *src_pose_ptr = impl_resolvedPose(src_pose);
+	Impl_Pose *dst_pose_ptr = impl_resolvedPose(dst_pose);
+	assert(src_pose_ptr);
+	assert(dst_pose_ptr);
+
+	const Impl_Armature *armature_ptr = dst_pose_ptr->armature_ptr;
+	assert(armature_ptr);
+
+	impl_poseConvertToLocal(armature_ptr->joint_count, armature_ptr->joint_parents, src_pose_ptr->transforms, dst_pose_ptr->transforms);
+
+	return AMBER_SUCCESS;
+}
+
+/*
+ */
+static Amber_UncheckedTable unchecked_vtbl =
+{
+	impl_uncheckedCopyPose,
+	impl_uncheckedMapPose,
+
+	impl_uncheckedSampleRootMotion,
+	impl_uncheckedSamplePose,
+
+	impl_uncheckedBlendPoses,
+	impl_uncheckedComputeAdditivePose,
+	impl_uncheckedApplyAdditivePoses,
+
+	impl_uncheckedConvertToWorldPose,
+	impl_uncheckedConvertToLocalPose,
+};
+
+/*
+ */
+Amber_Result impl_instanceResolvePose(Amber_Instance this, Amber_Pose pose, Amber_ResolvedPose *resolved_pose)
+{
+	assert(this);
+	assert(resolved_pose);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_Pose *pose_ptr = impl_getPose(instance_ptr, pose);
+
+	if (pose_ptr == NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	*resolved_pose = (Amber_ResolvedPose)(uintptr_t)pose_ptr;
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceResolveSequence(Amber_Instance this, Amber_Sequence sequence, Amber_ResolvedSequence *resolved_sequence)
+{
+	assert(this);
+	assert(resolved_sequence);
+
+	Impl_Instance *instance_ptr = (Impl_Instance *)this;
+	Impl_Sequence *sequence_ptr = (Impl_Sequence *)amber_poolGetElement(&instance_ptr->sequences, (Amber_PoolHandle)sequence);
+
+	if (sequence_ptr == NULL)
+		return AMBER_INTERNAL_ERROR;
+
+	*resolved_sequence = (Amber_ResolvedSequence)(uintptr_t)sequence_ptr;
+	return AMBER_SUCCESS;
+}
+
+Amber_Result impl_instanceGetUncheckedTable(Amber_Instance this, Amber_UncheckedTable *unchecked_table)
+{
+	assert(this);
+	assert(unchecked_table);
+
+	memcpy(unchecked_table, &unchecked_vtbl, sizeof(Amber_UncheckedTable));
+	return AMBER_SUCCESS;
+}
@@ -0,0 +1,923 @@
+#include "amber_internal.h"
+
+#include "common/allocator.h"
+#include "common/atomics.h"
+#include "common/timer.h"
+
+#include <assert.h>
+#include <string.h>
+
+// Note: the first member must be the table pointer, the layer object is used as an instance handle
+typedef struct Layer_Profiling_t
+{
+	Amber_InstanceTable *vtbl;
+	Amber_Allocator allocator;
+	Amber_Instance next;
+	Amber_InstanceTable next_table;
+	Amber_ProfilingCounters *counters;
+} Layer_Profiling;
+
+/*
+ */
+static AMBER_INLINE Layer_Profiling *layer_profilingGet(Amber_Instance this)
+{
+	Layer_Profiling *layer = (Layer_Profiling *)this;
+	assert(layer);
+	assert(layer->counters);
+
+	return layer;
+}
+
+static void layer_profilingRecord(Layer_Profiling *layer, Amber_Function function, uint64_t nanoseconds, uint64_t joint_count)
+{
+	assert(layer);
+	assert(function < AMBER_FUNCTION_ENUM_MAX);
+
+	Amber_ProfilingCounter *counter = &layer->counters->functions[function];
+
+	amber_atomicAdd64(&counter->call_count, 1);
+	amber_atomicAdd64(&counter->nanoseconds, nanoseconds);
+
+	if (joint_count > 0)
+		amber_atomicAdd64(&counter->joint_count, joint_count);
+}
+
+static uint64_t layer_profilingGetJointCount(Layer_Profiling *layer, Amber_Pose pose)
+{
+	assert(layer);
+
+	uint32_t joint_count = 0;
+	if (layer->next_table.getPoseJointCount(layer->next, pose, &joint_count) != AMBER_SUCCESS)
+		return 0;
+
+	return joint_count;
+}
+
+static uint64_t layer_profilingGetBatchJointCount(Layer_Profiling *layer, uint32_t count, const Amber_Pose *poses)
+{
+	assert(layer);
+	assert(count == 0 || poses);
+
+	uint64_t result = 0;
+
+	for (uint32_t i = 0; i < count; ++i)
+		result += layer_profilingGetJointCount(layer, poses[i]);
+
+	return result;
+}
+
+static uint64_t layer_profilingGetBlendJointCount(Layer_Profiling *layer, uint32_t count, const Amber_BlendDesc *descs)
+{
+	assert(layer);
+	assert(count == 0 || descs);
+
+	uint64_t result = 0;
+
+	for (uint32_t i = 0; i < count; ++i)
+		result += layer_profilingGetJointCount(layer, descs[i].dst_pose);
+
+	return result;
+}
+
+/*
+ */
+static Amber_Result layer_profilingReserveCapacity(Amber_Instance this, const Amber_CapacityDesc *desc)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.reserveCapacity(layer->next, desc);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_RESERVE_CAPACITY, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateArmature(Amber_Instance this, const Amber_ArmatureDesc *desc, Amber_Armature* armature)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createArmature(layer->next, desc, armature);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_ARMATURE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreatePose(Amber_Instance this, const Amber_PoseDesc *desc, Amber_Pose *pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createPose(layer->next, desc, pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_POSE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreatePoses(Amber_Instance this, uint32_t pose_count, const Amber_PoseDesc *descs, Amber_Pose *poses)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createPoses(layer->next, pose_count, descs, poses);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_POSES, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateTransientPose(Amber_Instance this, const Amber_PoseDesc *desc, Amber_Pose *pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createTransientPose(layer->next, desc, pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_TRANSIENT_POSE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateSequence(Amber_Instance this, const Amber_SequenceDesc *desc, Amber_Sequence *sequence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createSequence(layer->next, desc, sequence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_SEQUENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateSequences(Amber_Instance this, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Sequence *sequences)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createSequences(layer->next, sequence_count, descs, sequences);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_SEQUENCES, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateSequenceFromMemory(Amber_Instance this, const Amber_SequenceMemoryDesc *desc, Amber_Sequence *sequence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createSequenceFromMemory(layer->next, desc, sequence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_SEQUENCE_FROM_MEMORY, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateSequencesAsync(Amber_Instance this, uint32_t sequence_count, const Amber_SequenceDesc *descs, Amber_Pose fallback_pose, Amber_Sequence *sequences, uint64_t *fence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createSequencesAsync(layer->next, sequence_count, descs, fallback_pose, sequences, fence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_SEQUENCES_ASYNC, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateStreamingSequence(Amber_Instance this, const Amber_StreamingSequenceDesc *desc, Amber_Sequence *sequence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createStreamingSequence(layer->next, desc, sequence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_STREAMING_SEQUENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateCachedSequence(Amber_Instance this, const Amber_CachedSequenceDesc *desc, Amber_Sequence *sequence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createCachedSequence(layer->next, desc, sequence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_CACHED_SEQUENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingLoadSnapshot(Amber_Instance this, const Amber_SnapshotDesc *desc)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.loadSnapshot(layer->next, desc);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_LOAD_SNAPSHOT, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingAttachLibrary(Amber_Instance this, Amber_Library library)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.attachLibrary(layer->next, library);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_ATTACH_LIBRARY, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCreateGraph(Amber_Instance this, const Amber_GraphDesc *desc, Amber_Graph *graph)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.createGraph(layer->next, desc, graph);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_CREATE_GRAPH, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingDestroyArmature(Amber_Instance this, Amber_Armature armature)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.destroyArmature(layer->next, armature);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_DESTROY_ARMATURE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingDestroyPose(Amber_Instance this, Amber_Pose pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.destroyPose(layer->next, pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_DESTROY_POSE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingDestroyPoses(Amber_Instance this, uint32_t pose_count, const Amber_Pose *poses)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.destroyPoses(layer->next, pose_count, poses);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_DESTROY_POSES, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingResetTransientPoses(Amber_Instance this)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.resetTransientPoses(layer->next);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_RESET_TRANSIENT_POSES, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingDestroySequence(Amber_Instance this, Amber_Sequence sequence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.destroySequence(layer->next, sequence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_DESTROY_SEQUENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingDestroySequences(Amber_Instance this, uint32_t sequence_count, const Amber_Sequence *sequences)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.destroySequences(layer->next, sequence_count, sequences);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_DESTROY_SEQUENCES, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingDestroyGraph(Amber_Instance this, Amber_Graph graph)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.destroyGraph(layer->next, graph);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_DESTROY_GRAPH, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingDestroyInstance(Amber_Instance this)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.destroyInstance(layer->next);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_DESTROY_INSTANCE, end - start, 0);
+
+	// Note: copy the allocator out, the layer memory is released through it
+	Amber_Allocator allocator = layer->allocator;
+	amber_allocatorFree(&allocator, layer, sizeof(Layer_Profiling), AMBER_MEMORY_CATEGORY_INSTANCE);
+
+	return result;
+}
+
+static Amber_Result layer_profilingCopyPose(Amber_Instance this, Amber_Pose src_pose, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.copyPose(layer->next, src_pose, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_COPY_POSE, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingMultiplyPose(Amber_Instance this, Amber_Pose src_pose_a, Amber_Pose src_pose_b, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.multiplyPose(layer->next, src_pose_a, src_pose_b, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_MULTIPLY_POSE, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingInvertPose(Amber_Instance this, Amber_Pose src_pose, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.invertPose(layer->next, src_pose, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_INVERT_POSE, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingMapPose(Amber_Instance this, Amber_Pose pose, Amber_Transform **transforms)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.mapPose(layer->next, pose, transforms);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_MAP_POSE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingUnmapPose(Amber_Instance this, Amber_Pose pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.unmapPose(layer->next, pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_UNMAP_POSE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingEnumeratePoses(Amber_Instance this, Amber_Armature armature, uint32_t *pose_count, Amber_Pose *poses)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.enumeratePoses(layer->next, armature, pose_count, poses);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_ENUMERATE_POSES, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingGetPoseJointCount(Amber_Instance this, Amber_Pose pose, uint32_t *joint_count)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.getPoseJointCount(layer->next, pose, joint_count);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_GET_POSE_JOINT_COUNT, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingGetInstanceStats(Amber_Instance this, Amber_InstanceStats *stats)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.getInstanceStats(layer->next, stats);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_GET_INSTANCE_STATS, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingGetSequenceStats(Amber_Instance this, Amber_Sequence sequence, Amber_SequenceStats *stats)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.getSequenceStats(layer->next, sequence, stats);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_GET_SEQUENCE_STATS, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingSerializeSequence(Amber_Instance this, Amber_Sequence sequence, uint64_t *size, void *data)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.serializeSequence(layer->next, sequence, size, data);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_SERIALIZE_SEQUENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingSerializeStreamingSequence(Amber_Instance this, Amber_Sequence sequence, float chunk_duration, uint64_t *size, void *data)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.serializeStreamingSequence(layer->next, sequence, chunk_duration, size, data);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_SERIALIZE_STREAMING_SEQUENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingSerializeSnapshot(Amber_Instance this, uint64_t *size, void *data)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.serializeSnapshot(layer->next, size, data);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_SERIALIZE_SNAPSHOT, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingSampleRootMotion(Amber_Instance this, Amber_Sequence sequence, float prev_time, float time, Amber_Transform *dst_transform)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.sampleRootMotion(layer->next, sequence, prev_time, time, dst_transform);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_SAMPLE_ROOT_MOTION, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingSamplePose(Amber_Instance this, Amber_Sequence sequence, float time, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.samplePose(layer->next, sequence, time, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_SAMPLE_POSE, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingSamplePoseBatch(Amber_Instance this, uint32_t count, const Amber_Sequence *sequences, const float *times, const Amber_Pose *dst_poses)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.samplePoseBatch(layer->next, count, sequences, times, dst_poses);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetBatchJointCount(layer, count, dst_poses) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_SAMPLE_POSE_BATCH, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingBlendPoses(Amber_Instance this, uint32_t src_pose_count, const Amber_Pose *src_poses, const float *src_weights, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.blendPoses(layer->next, src_pose_count, src_poses, src_weights, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_BLEND_POSES, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingBlendPoseBatch(Amber_Instance this, uint32_t count, const Amber_BlendDesc *descs)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.blendPoseBatch(layer->next, count, descs);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetBlendJointCount(layer, count, descs) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_BLEND_POSE_BATCH, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingComputeAdditivePose(Amber_Instance this, Amber_Pose src_pose, Amber_Pose src_reference_pose, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.computeAdditivePose(layer->next, src_pose, src_reference_pose, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_COMPUTE_ADDITIVE_POSE, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingApplyAdditivePoses(Amber_Instance this, Amber_Pose src_pose, uint32_t src_additive_pose_count, const Amber_Pose *src_additive_poses, const float *src_weights, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.applyAdditivePoses(layer->next, src_pose, src_additive_pose_count, src_additive_poses, src_weights, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_APPLY_ADDITIVE_POSES, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingConvertToWorldPose(Amber_Instance this, Amber_Pose src_pose, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.convertToWorldPose(layer->next, src_pose, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_CONVERT_TO_WORLD_POSE, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingConvertToWorldPoseBatch(Amber_Instance this, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.convertToWorldPoseBatch(layer->next, count, src_poses, dst_poses);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetBatchJointCount(layer, count, dst_poses) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_CONVERT_TO_WORLD_POSE_BATCH, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingConvertToLocalPose(Amber_Instance this, Amber_Pose src_pose, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.convertToLocalPose(layer->next, src_pose, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_CONVERT_TO_LOCAL_POSE, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingConvertToLocalPoseBatch(Amber_Instance this, uint32_t count, const Amber_Pose *src_poses, const Amber_Pose *dst_poses)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.convertToLocalPoseBatch(layer->next, count, src_poses, dst_poses);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetBatchJointCount(layer, count, dst_poses) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_CONVERT_TO_LOCAL_POSE_BATCH, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingEvaluateGraph(Amber_Instance this, Amber_Graph graph, uint32_t parameter_count, const float *parameters, Amber_Pose dst_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.evaluateGraph(layer->next, graph, parameter_count, parameters, dst_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	uint64_t joint_count = (result == AMBER_SUCCESS) ? layer_profilingGetJointCount(layer, dst_pose) : 0;
+	layer_profilingRecord(layer, AMBER_FUNCTION_EVALUATE_GRAPH, end - start, joint_count);
+
+	return result;
+}
+
+static Amber_Result layer_profilingResolvePose(Amber_Instance this, Amber_Pose pose, Amber_ResolvedPose *resolved_pose)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.resolvePose(layer->next, pose, resolved_pose);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_RESOLVE_POSE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingResolveSequence(Amber_Instance this, Amber_Sequence sequence, Amber_ResolvedSequence *resolved_sequence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.resolveSequence(layer->next, sequence, resolved_sequence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_RESOLVE_SEQUENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingGetUncheckedTable(Amber_Instance this, Amber_UncheckedTable *unchecked_table)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.getUncheckedTable(layer->next, unchecked_table);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_GET_UNCHECKED_TABLE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingBeginCapture(Amber_Instance this, const Amber_CaptureDesc *desc)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.beginCapture(layer->next, desc);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_BEGIN_CAPTURE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingEndCapture(Amber_Instance this, const char *path)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.endCapture(layer->next, path);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_END_CAPTURE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingGetFenceStatus(Amber_Instance this, uint64_t fence, uint32_t *complete)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.getFenceStatus(layer->next, fence, complete);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_GET_FENCE_STATUS, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingWaitFence(Amber_Instance this, uint64_t fence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.waitFence(layer->next, fence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_WAIT_FENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingPrefetchStreamingSequence(Amber_Instance this, Amber_Sequence sequence, float time, uint64_t *fence)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.prefetchStreamingSequence(layer->next, sequence, time, fence);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_PREFETCH_STREAMING_SEQUENCE, end - start, 0);
+
+	return result;
+}
+
+static Amber_Result layer_profilingSetSequenceCacheBudget(Amber_Instance this, uint64_t budget)
+{
+	Layer_Profiling *layer = layer_profilingGet(this);
+	uint64_t start = amber_timerGetNanoseconds();
+
+	Amber_Result result = layer->next_table.setSequenceCacheBudget(layer->next, budget);
+
+	uint64_t end = amber_timerGetNanoseconds();
+	layer_profilingRecord(layer, AMBER_FUNCTION_SET_SEQUENCE_CACHE_BUDGET, end - start, 0);
+
+	return result;
+}
+
+/*
+ */
+static Amber_InstanceTable profiling_vtbl =
+{
+	layer_profilingCreateArmature,
+	layer_profilingCreatePose,
+	layer_profilingCreateSequence,
+
+	layer_profilingDestroyArmature,
+	layer_profilingDestroyPose,
+	layer_profilingDestroySequence,
+	layer_profilingDestroyInstance,
+
+	layer_profilingCopyPose,
+	layer_profilingMultiplyPose,
+	layer_profilingInvertPose,
+	layer_profilingMapPose,
+	layer_profilingUnmapPose,
+
+	layer_profilingSampleRootMotion,
+	layer_profilingSamplePose,
+
+	layer_profilingBlendPoses,
+	layer_profilingComputeAdditivePose,
+	layer_profilingApplyAdditivePoses,
+
+	layer_profilingConvertToWorldPose,
+	layer_profilingConvertToLocalPose,
+
+	layer_profilingCreateGraph,
+	layer_profilingDestroyGraph,
+	layer_profilingEvaluateGraph,
+
+	layer_profilingCreateTransientPose,
+	layer_profilingResetTransientPoses,
+
+	layer_profilingReserveCapacity,
+
+	layer_profilingEnumeratePoses,
+
+	layer_profilingCreatePoses,
+	layer_profilingCreateSequences,
+	layer_profilingDestroyPoses,
+	layer_profilingDestroySequences,
+
+	layer_profilingResolvePose,
+	layer_profilingResolveSequence,
+	layer_profilingGetUncheckedTable,
+
+	layer_profilingSamplePoseBatch,
+	layer_profilingBlendPoseBatch,
+	layer_profilingConvertToWorldPoseBatch,
+	layer_profilingConvertToLocalPoseBatch,
+
+	layer_profilingGetPoseJointCount,
+
+	layer_profilingBeginCapture,
+	layer_profilingEndCapture,
+
+	layer_profilingGetInstanceStats,
+	layer_profilingGetSequenceStats,
+
+	layer_profilingCreateSequenceFromMemory,
+	layer_profilingSerializeSequence,
+
+	layer_profilingCreateSequencesAsync,
+	layer_profilingGetFenceStatus,
+	layer_profilingWaitFence,
+
+	layer_profilingCreateStreamingSequence,
+	layer_profilingSerializeStreamingSequence,
+	layer_profilingPrefetchStreamingSequence,
+
+	layer_profilingCreateCachedSequence,
+	layer_profilingSetSequenceCacheBudget,
+
+	layer_profilingLoadSnapshot,
+	layer_profilingSerializeSnapshot,
+
+	layer_profilingAttachLibrary,
+};
+
+/*
+ */
+Amber_Result layer_createProfiling(void *user_data, const Amber_AllocationCallbacks *allocation_callbacks, Amber_Instance next_instance, const Amber_InstanceTable *next_table, Amber_Instance *instance)
+{
+	assert(user_data);
+	assert(next_instance);
+	assert(next_table);
+	assert(instance);
+
+	Amber_Allocator allocator;
+	amber_allocatorInitialize(&allocator, allocation_callbacks);
+
+	Layer_Profiling *layer = (Layer_Profiling *)amber_allocatorAllocate(&allocator, sizeof(Layer_Profiling), AMBER_DEFAULT_ALIGNMENT, AMBER_MEMORY_CATEGORY_INSTANCE);
+	assert(layer);
+
+	layer->vtbl = &profiling_vtbl;
+	layer->allocator = allocator;
+	layer->next = next_instance;
+	layer->counters = (Amber_ProfilingCounters *)user_data;
+
+	memcpy(&layer->next_table, next_table, sizeof(Amber_InstanceTable));
+
+	*instance = (Amber_Instance)layer;
+	return AMBER_SUCCESS;
+}
@@ -0,0 +1,751 @@
+#include <amber.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Note: source dumps are line based text, '#' starts a comment:
+//       joint <name> <parent name or -> [px py pz rx ry rz rw sx sy sz]
+//       sequence <name>
+//       track <joint name or root_motion> <channel> <time> <value> [<time> <value> ...]
+//       Channels are px py pz rx ry rz rw sx sy sz. Joints must come before sequences,
+//       tracks belong to the last declared sequence.
+static const uint32_t channel_count = 10;
+
+static const char *channel_names[channel_count] =
+{
+	"px", "py", "pz",
+	"rx", "ry", "rz", "rw",
+	"sx", "sy", "sz",
+};
+
+// Note: value of a channel without curve at runtime, tracks equal to it can be dropped entirely
+static const float channel_defaults[channel_count] =
+{
+	0.0f, 0.0f, 0.0f,
+	0.0f, 0.0f, 0.0f, 1.0f,
+	1.0f, 1.0f, 1.0f,
+};
+
+static const uint32_t validation_sample_count = 256;
+
+struct CookOptions
+{
+	const char *input = nullptr;
+	const char *output = nullptr;
+	float tolerance = 1e-4f;
+	float chunk_duration = 0.0f;
+};
+
+struct SourceJoint
+{
+	std::string name;
+	std::string parent;
+	float rest[channel_count];
+};
+
+struct SourceTrack
+{
+	std::vector<Amber_SequenceKey> keys;
+};
+
+struct SourceSequence
+{
+	std::string name;
+	std::vector<SourceTrack> joint_tracks; // joint_count * channel_count, indexed by source joint
+	std::vector<bool> joint_animated;
+	SourceTrack root_motion_tracks[channel_count];
+	bool has_root_motion = false;
+};
+
+struct Source
+{
+	std::vector<SourceJoint> joints;
+	std::vector<SourceSequence> sequences;
+};
+
+struct CookedArmature
+{
+	std::vector<uint32_t> order; // cooked index -> source index
+	std::vector<uint32_t> remap; // source index -> cooked index
+	std::vector<int32_t> parents;
+	Amber_Armature armature = AMBER_NULL_HANDLE;
+	Amber_Pose rest_pose = AMBER_NULL_HANDLE;
+	Amber_Pose bind_pose = AMBER_NULL_HANDLE;
+};
+
+struct CookStats
+{
+	uint64_t track_count = 0;
+	uint64_t key_count = 0;
+};
+
+/*
+ */
+static int findJoint(const Source &source, const std::string &name)
+{
+	for (size_t i = 0; i < source.joints.size(); ++i)
+		if (source.joints[i].name == name)
+			return (int)i;
+
+	return -1;
+}
+
+static int findChannel(const std::string &name)
+{
+	for (uint32_t i = 0; i < channel_count; ++i)
+		if (name == channel_names[i])
+			return (int)i;
+
+	return -1;
+}
+
+static bool parseSource(const char *path, Source &source)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		fprintf(stderr, "amber_cook: can't open \"%s\"\n", path);
+		return false;
+	}
+
+	std::string line;
+	uint32_t line_number = 0;
+
+	while (std::getline(file, line))
+	{
+		++line_number;
+
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+			line.resize(comment);
+
+		std::istringstream stream(line);
+		std::string keyword;
+
+		if (!(stream >> keyword))
+			continue;
+
+		if (keyword == "joint")
+		{
+			if (!source.sequences.empty())
+			{
+				fprintf(stderr, "%s:%u: joints must be declared before sequences\n", path, line_number);
+				return false;
+			}
+
+			SourceJoint joint;
+			if (!(stream >> joint.name >> joint.parent) || findJoint(source, joint.name) != -1)
+			{
+				fprintf(stderr, "%s:%u: invalid or duplicate joint\n", path, line_number);
+				return false;
+			}
+
+			std::copy(channel_defaults, channel_defaults + channel_count, joint.rest);
+
+			for (uint32_t i = 0; i < channel_count; ++i)
+				if (!(stream >> joint.rest[i]))
+					break;
+
+			source.joints.push_back(joint);
+		}
+		else if (keyword == "sequence")
+		{
+			SourceSequence sequence;
+			if (!(stream >> sequence.name))
+			{
+				fprintf(stderr, "%s:%u: missing sequence name\n", path, line_number);
+				return false;
+			}
+
+			sequence.joint_tracks.resize(source.joints.size() * channel_count);
+			sequence.joint_animated.resize(source.joints.size(), false);
+			source.sequences.push_back(sequence);
+		}
+		else if (keyword == "track")
+		{
+			std::string joint_name, channel_name;
+			stream >> joint_name >> channel_name;
+
+			int channel = findChannel(channel_name);
+			int joint = findJoint(source, joint_name);
+
+			if (source.sequences.empty() || channel == -1 || (joint == -1 && joint_name != "root_motion"))
+			{
+				fprintf(stderr, "%s:%u: invalid track\n", path, line_number);
+				return false;
+			}
+
+			SourceSequence &sequence = source.sequences.back();
+			SourceTrack *track = nullptr;
+
+			if (joint == -1)
+			{
+				track = &sequence.root_motion_tracks[channel];
+				sequence.has_root_motion = true;
+			}
+			else
+			{
+				track = &sequence.joint_tracks[joint * channel_count + channel];
+				sequence.joint_animated[joint] = true;
+			}
+
+			Amber_SequenceKey key = {};
+			while (stream >> key.time >> key.value)
+				track->keys.push_back(key);
+
+			if (track->keys.empty() || !std::is_sorted(track->keys.begin(), track->keys.end(), [](const Amber_SequenceKey &a, const Amber_SequenceKey &b) { return a.time < b.time; }))
+			{
+				fprintf(stderr, "%s:%u: track keys must be non-empty and sorted by time\n", path, line_number);
+				return false;
+			}
+		}
+		else
+		{
+			fprintf(stderr, "%s:%u: unknown keyword \"%s\"\n", path, line_number, keyword.c_str());
+			return false;
+		}
+	}
+
+	if (source.joints.empty())
+	{
+		fprintf(stderr, "%s: no joints\n", path);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ */
+// Note: depth-first order puts every parent before its children, as armatures require,
+//       and keeps chains contiguous so hierarchy passes walk memory forward
+static bool reorderJoints(const Source &source, CookedArmature &cooked)
+{
+	uint32_t joint_count = (uint32_t)source.joints.size();
+	std::vector<int> source_parents(joint_count);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		const std::string &parent = source.joints[i].parent;
+		source_parents[i] = (parent == "-") ? -1 : findJoint(source, parent);
+
+		if (parent != "-" && source_parents[i] == -1)
+		{
+			fprintf(stderr, "amber_cook: joint \"%s\" has unknown parent \"%s\"\n", source.joints[i].name.c_str(), parent.c_str());
+			return false;
+		}
+	}
+
+	cooked.order.clear();
+	cooked.remap.assign(joint_count, UINT32_MAX);
+
+	std::vector<uint32_t> stack;
+
+	for (uint32_t i = joint_count; i-- > 0;)
+		if (source_parents[i] == -1)
+			stack.push_back(i);
+
+	while (!stack.empty())
+	{
+		uint32_t index = stack.back();
+		stack.pop_back();
+
+		cooked.remap[index] = (uint32_t)cooked.order.size();
+		cooked.order.push_back(index);
+
+		for (uint32_t i = joint_count; i-- > 0;)
+			if (source_parents[i] == (int)index)
+				stack.push_back(i);
+	}
+
+	if (cooked.order.size() != joint_count)
+	{
+		fprintf(stderr, "amber_cook: joint hierarchy contains a cycle\n");
+		return false;
+	}
+
+	cooked.parents.resize(joint_count);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		int parent = source_parents[cooked.order[i]];
+		cooked.parents[i] = (parent == -1) ? -1 : (int32_t)cooked.remap[parent];
+	}
+
+	return true;
+}
+
+static void writeTransform(Amber_Transform *transform, const float *values)
+{
+	transform->position = {values[0], values[1], values[2]};
+	transform->rotation = {values[3], values[4], values[5], values[6]};
+	transform->scale = {values[7], values[8], values[9]};
+}
+
+static void readTransform(const Amber_Transform &transform, float *values)
+{
+	const float src[channel_count] =
+	{
+		transform.position.x, transform.position.y, transform.position.z,
+		transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w,
+		transform.scale.x, transform.scale.y, transform.scale.z,
+	};
+
+	std::copy(src, src + channel_count, values);
+}
+
+// Note: bind data is the world-space rest pose, computed once here instead of at every load
+static bool cookArmature(Amber_Instance instance, const Source &source, CookedArmature &cooked)
+{
+	if (!reorderJoints(source, cooked))
+		return false;
+
+	uint32_t joint_count = (uint32_t)source.joints.size();
+	std::vector<const char *> names(joint_count);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+		names[i] = source.joints[cooked.order[i]].name.c_str();
+
+	Amber_ArmatureDesc armature_desc = {joint_count, cooked.parents.data(), names.data(), 0};
+	if (amberCreateArmature(instance, &armature_desc, &cooked.armature) != AMBER_SUCCESS)
+		return false;
+
+	Amber_PoseDesc pose_desc = {cooked.armature, 0, nullptr};
+	if (amberCreatePose(instance, &pose_desc, &cooked.rest_pose) != AMBER_SUCCESS || amberCreatePose(instance, &pose_desc, &cooked.bind_pose) != AMBER_SUCCESS)
+		return false;
+
+	Amber_Transform *transforms = nullptr;
+	amberMapPose(instance, cooked.rest_pose, &transforms);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+		writeTransform(&transforms[i], source.joints[cooked.order[i]].rest);
+
+	amberUnmapPose(instance, cooked.rest_pose);
+
+	return amberConvertToWorldPose(instance, cooked.rest_pose, cooked.bind_pose) == AMBER_SUCCESS;
+}
+
+/*
+ */
+static float sampleKeys(const std::vector<Amber_SequenceKey> &keys, size_t first, size_t last, float time)
+{
+	const Amber_SequenceKey &key0 = keys[first];
+	const Amber_SequenceKey &key1 = keys[last];
+
+	float t = (key1.time > key0.time) ? (time - key0.time) / (key1.time - key0.time) : 0.0f;
+	return key0.value * (1.0f - t) + key1.value * t;
+}
+
+// Note: runtime interpolation is linear and ignores tangents, so a key can be dropped whenever
+//       the segment spanning it reproduces it, and every key dropped before it, within tolerance
+static std::vector<Amber_SequenceKey> compressTrack(const std::vector<Amber_SequenceKey> &keys, float default_value, float tolerance)
+{
+	std::vector<Amber_SequenceKey> result;
+	if (keys.empty())
+		return result;
+
+	float min_value = keys.front().value;
+	float max_value = keys.front().value;
+
+	for (const Amber_SequenceKey &key : keys)
+	{
+		min_value = std::min(min_value, key.value);
+		max_value = std::max(max_value, key.value);
+	}
+
+	if (max_value - min_value <= tolerance)
+	{
+		if (std::fabs(keys.front().value - default_value) <= tolerance)
+			return result;
+
+		Amber_SequenceKey key = keys.front();
+		key.tangent_left = key.tangent_right = {0.0f, 0.0f};
+
+		result.push_back(key);
+		return result;
+	}
+
+	size_t anchor = 0;
+	result.push_back(keys.front());
+
+	for (size_t i = 1; i + 1 < keys.size(); ++i)
+	{
+		bool removable = true;
+
+		for (size_t j = anchor + 1; j <= i && removable; ++j)
+			removable = std::fabs(sampleKeys(keys, anchor, i + 1, keys[j].time) - keys[j].value) <= tolerance;
+
+		if (removable)
+			continue;
+
+		anchor = i;
+		result.push_back(keys[i]);
+	}
+
+	result.push_back(keys.back());
+	return result;
+}
+
+static void getChannelCurves(Amber_SequenceJointCurve &curve, Amber_SequenceCurve **curves)
+{
+	Amber_SequenceCurve *src[channel_count] =
+	{
+		&curve.position_curves[0], &curve.position_curves[1], &curve.position_curves[2],
+		&curve.rotation_curves[0], &curve.rotation_curves[1], &curve.rotation_curves[2], &curve.rotation_curves[3],
+		&curve.scale_curves[0], &curve.scale_curves[1], &curve.scale_curves[2],
+	};
+
+	std::copy(src, src + channel_count, curves);
+}
+
+static void compressJoint(const SourceTrack *src_tracks, float tolerance, std::vector<std::vector<Amber_SequenceKey>> &storage, Amber_SequenceJointCurve &curve, CookStats &src_stats, CookStats &dst_stats)
+{
+	Amber_SequenceCurve *dst_curves[channel_count];
+	getChannelCurves(curve, dst_curves);
+
+	for (uint32_t c = 0; c < channel_count; ++c)
+	{
+		const std::vector<Amber_SequenceKey> &src_keys = src_tracks[c].keys;
+
+		if (!src_keys.empty())
+		{
+			src_stats.track_count++;
+			src_stats.key_count += src_keys.size();
+		}
+
+		storage.push_back(compressTrack(src_keys, channel_defaults[c], tolerance));
+		const std::vector<Amber_SequenceKey> &dst_keys = storage.back();
+
+		*dst_curves[c] = {(uint32_t)dst_keys.size(), dst_keys.data()};
+
+		if (!dst_keys.empty())
+		{
+			dst_stats.track_count++;
+			dst_stats.key_count += dst_keys.size();
+		}
+	}
+}
+
+static Amber_SequenceDesc buildSequenceDesc(const Source &source, const SourceSequence &sequence, const CookedArmature &cooked, float tolerance, std::vector<std::vector<Amber_SequenceKey>> &storage, std::vector<uint32_t> &indices, std::vector<Amber_SequenceJointCurve> &curves, CookStats &src_stats, CookStats &dst_stats)
+{
+	// Note: storage never reallocates, curves keep pointers into it
+	storage.clear();
+	storage.reserve((source.joints.size() + 1) * channel_count);
+
+	indices.clear();
+	curves.clear();
+
+	// Note: joints are emitted in runtime order, which makes sampling write the pose front to back
+	for (uint32_t i = 0; i < cooked.order.size(); ++i)
+	{
+		uint32_t joint = cooked.order[i];
+		if (!sequence.joint_animated[joint])
+			continue;
+
+		Amber_SequenceJointCurve curve = {};
+		compressJoint(&sequence.joint_tracks[joint * channel_count], tolerance, storage, curve, src_stats, dst_stats);
+
+		indices.push_back(i);
+		curves.push_back(curve);
+	}
+
+	if (sequence.has_root_motion)
+	{
+		Amber_SequenceJointCurve curve = {};
+		compressJoint(sequence.root_motion_tracks, tolerance, storage, curve, src_stats, dst_stats);
+
+		curves.push_back(curve);
+	}
+
+	Amber_SequenceDesc desc = {};
+	desc.armature = cooked.armature;
+	desc.joint_count = (uint32_t)indices.size();
+	desc.joint_indices = indices.data();
+	desc.joint_curves = curves.data();
+	desc.root_motion_curve = (sequence.has_root_motion) ? &curves.back() : nullptr;
+
+	return desc;
+}
+
+// Note: the blob is loaded back the way the runtime would and compared against the uncompressed sequence
+static float validateSequence(Amber_Instance instance, const CookedArmature &cooked, Amber_Sequence reference, const std::vector<uint8_t> &blob, float min_time, float max_time)
+{
+	Amber_SequenceMemoryDesc memory_desc = {cooked.armature, blob.size(), blob.data()};
+	Amber_Sequence sequence = AMBER_NULL_HANDLE;
+
+	if (amberCreateSequenceFromMemory(instance, &memory_desc, &sequence) != AMBER_SUCCESS)
+		return INFINITY;
+
+	Amber_PoseDesc pose_desc = {cooked.armature, 0, nullptr};
+	Amber_Pose poses[2] = {};
+	Amber_PoseDesc pose_descs[2] = {pose_desc, pose_desc};
+	amberCreatePoses(instance, 2, pose_descs, poses);
+
+	uint32_t joint_count = (uint32_t)cooked.order.size();
+	float max_error = 0.0f;
+
+	for (uint32_t s = 0; s < validation_sample_count; ++s)
+	{
+		float time = min_time + (max_time - min_time) * (float)s / (float)(validation_sample_count - 1);
+
+		amberCopyPose(instance, cooked.rest_pose, poses[0]);
+		amberCopyPose(instance, cooked.rest_pose, poses[1]);
+		amberSamplePose(instance, reference, time, poses[0]);
+		amberSamplePose(instance, sequence, time, poses[1]);
+
+		Amber_Transform *expected = nullptr;
+		Amber_Transform *actual = nullptr;
+		amberMapPose(instance, poses[0], &expected);
+		amberMapPose(instance, poses[1], &actual);
+
+		for (uint32_t i = 0; i < joint_count; ++i)
+		{
+			float expected_values[channel_count];
+			float actual_values[channel_count];
+			readTransform(expected[i], expected_values);
+			readTransform(actual[i], actual_values);
+
+			for (uint32_t c = 0; c < channel_count; ++c)
+				max_error = std::max(max_error, std::fabs(expected_values[c] - actual_values[c]));
+		}
+
+		amberUnmapPose(instance, poses[0]);
+		amberUnmapPose(instance, poses[1]);
+	}
+
+	amberDestroyPoses(instance, 2, poses);
+	amberDestroySequence(instance, sequence);
+
+	return max_error;
+}
+
+static bool writeFile(const std::string &path, const std::vector<uint8_t> &data)
+{
+	FILE *file = fopen(path.c_str(), "wb");
+	if (!file || fwrite(data.data(), 1, data.size(), file) != data.size() || fclose(file) != 0)
+	{
+		fprintf(stderr, "amber_cook: can't write \"%s\"\n", path.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+// Note: every joint gets one key per channel, sampling the sequence at any time writes 'pose' back
+static Amber_SequenceDesc buildPoseSequenceDesc(Amber_Instance instance, Amber_Pose pose, const CookedArmature &cooked, std::vector<Amber_SequenceKey> &keys, std::vector<uint32_t> &indices, std::vector<Amber_SequenceJointCurve> &curves)
+{
+	uint32_t joint_count = (uint32_t)cooked.order.size();
+
+	keys.assign(joint_count * channel_count, Amber_SequenceKey());
+	indices.resize(joint_count);
+	curves.resize(joint_count);
+
+	Amber_Transform *transforms = nullptr;
+	amberMapPose(instance, pose, &transforms);
+
+	for (uint32_t i = 0; i < joint_count; ++i)
+	{
+		float values[channel_count];
+		readTransform(transforms[i], values);
+
+		Amber_SequenceCurve *dst_curves[channel_count];
+		getChannelCurves(curves[i], dst_curves);
+
+		for (uint32_t c = 0; c < channel_count; ++c)
+		{
+			Amber_SequenceKey *key = &keys[i * channel_count + c];
+			key->value = values[c];
+
+			*dst_curves[c] = {1, key};
+		}
+
+		indices[i] = i;
+	}
+
+	amberUnmapPose(instance, pose);
+
+	Amber_SequenceDesc desc = {};
+	desc.armature = cooked.armature;
+	desc.joint_count = joint_count;
+	desc.joint_indices = indices.data();
+	desc.joint_curves = curves.data();
+
+	return desc;
+}
+
+// Note: the armature is written as a snapshot for amberLoadSnapshot, together with the rest and bind poses
+//       as constant sequences. Loading the snapshot keeps the handles printed here, sequence blobs are
+//       created against the armature handle.
+static bool writeArmature(Amber_Instance instance, const CookedArmature &cooked, const std::string &path)
+{
+	std::vector<Amber_SequenceKey> keys[2];
+	std::vector<uint32_t> indices[2];
+	std::vector<Amber_SequenceJointCurve> curves[2];
+
+	Amber_SequenceDesc descs[2] =
+	{
+		buildPoseSequenceDesc(instance, cooked.rest_pose, cooked, keys[0], indices[0], curves[0]),
+		buildPoseSequenceDesc(instance, cooked.bind_pose, cooked, keys[1], indices[1], curves[1]),
+	};
+
+	Amber_Sequence sequences[2] = {};
+	if (amberCreateSequences(instance, 2, descs, sequences) != AMBER_SUCCESS)
+		return false;
+
+	uint64_t size = 0;
+	amberSerializeSnapshot(instance, &size, nullptr);
+
+	std::vector<uint8_t> snapshot(size);
+	Amber_Result result = amberSerializeSnapshot(instance, &size, snapshot.data());
+
+	amberDestroySequences(instance, 2, sequences);
+
+	if (result != AMBER_SUCCESS || !writeFile(path, snapshot))
+		return false;
+
+	printf("%-24s joints %4u  handle 0x%llx  rest 0x%llx  bind 0x%llx  %8llu bytes\n",
+		"armature", (uint32_t)cooked.order.size(),
+		(unsigned long long)cooked.armature, (unsigned long long)sequences[0], (unsigned long long)sequences[1],
+		(unsigned long long)size
+	);
+
+	return true;
+}
+
+static bool cookSequence(Amber_Instance instance, const Source &source, const SourceSequence &sequence, const CookedArmature &cooked, const CookOptions &options, const std::string &path)
+{
+	std::vector<std::vector<Amber_SequenceKey>> storage;
+	std::vector<uint32_t> indices;
+	std::vector<Amber_SequenceJointCurve> curves;
+	CookStats src_stats, dst_stats, unused_stats;
+
+	Amber_SequenceDesc desc = buildSequenceDesc(source, sequence, cooked, options.tolerance, storage, indices, curves, src_stats, dst_stats);
+	if (desc.joint_count == 0)
+	{
+		fprintf(stderr, "amber_cook: sequence \"%s\" doesn't animate any joint\n", sequence.name.c_str());
+		return false;
+	}
+
+	// Note: the reference keeps every key, only the joint order is changed
+	std::vector<std::vector<Amber_SequenceKey>> reference_storage;
+	std::vector<uint32_t> reference_indices;
+	std::vector<Amber_SequenceJointCurve> reference_curves;
+
+	Amber_SequenceDesc reference_desc = buildSequenceDesc(source, sequence, cooked, -1.0f, reference_storage, reference_indices, reference_curves, unused_stats, unused_stats);
+
+	Amber_Sequence sequences[2] = {};
+	Amber_SequenceDesc descs[2] = {desc, reference_desc};
+
+	if (amberCreateSequences(instance, 2, descs, sequences) != AMBER_SUCCESS)
+		return false;
+
+	uint64_t size = 0;
+	amberSerializeSequence(instance, sequences[0], &size, nullptr);
+
+	std::vector<uint8_t> blob(size);
+	amberSerializeSequence(instance, sequences[0], &size, blob.data());
+
+	Amber_SequenceStats stats = {};
+	amberGetSequenceStats(instance, sequences[1], &stats);
+
+	float max_error = validateSequence(instance, cooked, sequences[1], blob, stats.min_time, stats.max_time);
+
+	std::vector<uint8_t> stream;
+
+	if (options.chunk_duration > 0.0f)
+	{
+		uint64_t stream_size = 0;
+		amberSerializeStreamingSequence(instance, sequences[0], options.chunk_duration, &stream_size, nullptr);
+
+		stream.resize(stream_size);
+		amberSerializeStreamingSequence(instance, sequences[0], options.chunk_duration, &stream_size, stream.data());
+	}
+
+	amberDestroySequences(instance, 2, sequences);
+
+	if (!writeFile(path + ".ambs", blob))
+		return false;
+
+	if (!stream.empty() && !writeFile(path + ".amts", stream))
+		return false;
+
+	printf("%-24s joints %4u  tracks %6llu -> %6llu  keys %8llu -> %8llu  %8llu bytes  max error %g\n",
+		sequence.name.c_str(), desc.joint_count,
+		(unsigned long long)src_stats.track_count, (unsigned long long)dst_stats.track_count,
+		(unsigned long long)src_stats.key_count, (unsigned long long)dst_stats.key_count,
+		(unsigned long long)size, max_error
+	);
+
+	return true;
+}
+
+/*
+ */
+static void printUsage()
+{
+	printf("usage: amber_cook <input> <output directory> [--tolerance <value>] [--stream <chunk seconds>]\n");
+	printf("writes <output directory>/armature.amss snapshot and one <sequence>.ambs blob per sequence,\n");
+	printf("plus one <sequence>.amts stream per sequence if --stream is given\n");
+}
+
+static bool parseOptions(int argc, char **argv, CookOptions &options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const char *arg = argv[i];
+
+		if (strcmp(arg, "--tolerance") == 0 && i + 1 < argc)
+			options.tolerance = (float)atof(argv[++i]);
+		else if (strcmp(arg, "--stream") == 0 && i + 1 < argc)
+			options.chunk_duration = (float)atof(argv[++i]);
+		else if (arg[0] == '-')
+			return false;
+		else if (!options.input)
+			options.input = arg;
+		else if (!options.output)
+			options.output = arg;
+		else
+			return false;
+	}
+
+	return options.input && options.output && options.tolerance >= 0.0f && options.chunk_duration >= 0.0f;
+}
+
+int main(int argc, char **argv)
+{
+	CookOptions options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage();
+		return 1;
+	}
+
+	Source source;
+	if (!parseSource(options.input, source))
+		return 1;
+
+	Amber_InstanceDesc instance_desc = {};
+	instance_desc.thread_count = 1;
+
+	Amber_Instance instance = AMBER_NULL_HANDLE;
+	Amber_Result result = amberCreateInstance(&instance_desc, &instance);
+	assert(result == AMBER_SUCCESS);
+
+	std::string output = options.output;
+	CookedArmature cooked;
+
+	bool success = cookArmature(instance, source, cooked) && writeArmature(instance, cooked, output + "/armature.amss");
+
+	for (size_t i = 0; i < source.sequences.size() && success; ++i)
+		success = cookSequence(instance, source, source.sequences[i], cooked, options, output + "/" + source.sequences[i].name);
+
+	amberDestroyInstance(instance);
+	return success ? 0 : 1;
+}